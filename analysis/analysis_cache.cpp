@@ -0,0 +1,184 @@
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+
+#include "analysis_cache.h"
+#include "rom_buffer.h"
+#include "settings_manager.h"
+#include "utility.h"
+#include "debug.h"
+
+//Cache files are named after a hash of the per bank hashes, so an unchanged ROM is found directly.
+//When the ROM was edited since the last save we fall back to the cache last written for the same
+//file and only keep the banks whose hashes still match.
+bool analysis_cache::load(const ROM_buffer *buffer, code_map &map)
+{
+	QVector<quint64> hashes = bank_hashes(buffer);
+	QFile file(cache_path(content_key(hashes)));
+	if(!file.exists()){
+		settings_manager settings;
+		QVariant previous = settings.get(path_key(buffer));
+		if(!previous.isValid()){
+			return false;
+		}
+		file.setFileName(cache_path(previous.toULongLong()));
+	}
+	if(!file.open(QIODevice::ReadOnly)){
+		return false;
+	}
+	
+	QDataStream stream(&file);
+	quint32 file_magic;
+	quint16 file_version;
+	qint32 size;
+	qint32 file_bank_size;
+	QVector<quint64> cached_hashes;
+	stream >> file_magic >> file_version >> size >> file_bank_size >> cached_hashes;
+	if(file_magic != magic || file_version != version || file_bank_size != bank_size || 
+	   cached_hashes.size() != hashes.size() || size != buffer->size()){
+		return false;
+	}
+	
+	QByteArray flags(size, 0);
+	bool reused = false;
+	for(int bank = 0; bank < hashes.size(); bank++){
+		QByteArray compressed;
+		stream >> compressed;
+		if(stream.status() != QDataStream::Ok){
+			return false;
+		}
+		if(compressed.isEmpty() || cached_hashes[bank] != hashes[bank]){
+			hashes[bank] = 0;
+			continue;
+		}
+		QByteArray bank_flags = qUncompress(compressed);
+		if(bank_flags.size() != qMin(bank_size, size - bank * bank_size)){
+			hashes[bank] = 0;
+			continue;
+		}
+		std::memcpy(flags.data() + bank * bank_size, bank_flags.constData(), bank_flags.size());
+		reused = true;
+	}
+	if(!reused){
+		return false;
+	}
+	
+	map = code_map(flags);
+	map.set_bank_hashes(hashes);
+	return true;
+}
+
+void analysis_cache::save(const ROM_buffer *buffer, const code_map &map)
+{
+	QVector<quint64> hashes = bank_hashes(buffer);
+	quint64 key = content_key(hashes);
+	QString path = cache_path(key);
+	QDir().mkpath(QFileInfo(path).absolutePath());
+	QFile file(path);
+	if(!map.is_valid() || map.size() != buffer->size() || !file.open(QIODevice::WriteOnly)){
+		return;
+	}
+	
+	QDataStream stream(&file);
+	stream << magic << version << (qint32)buffer->size() << (qint32)bank_size << hashes;
+	const QVector<quint64> &analyzed = map.get_bank_hashes();
+	for(int bank = 0; bank < hashes.size(); bank++){
+		//Banks edited since they were analyzed are left empty and get analyzed again
+		if(bank >= analyzed.size() || analyzed[bank] != hashes[bank]){
+			stream << QByteArray();
+			continue;
+		}
+		stream << qCompress(map.get_flags().mid(bank * bank_size, bank_size), 1);
+	}
+	
+	settings_manager settings;
+	settings.set(path_key(buffer), key);
+}
+
+QVector<quint64> analysis_cache::bank_hashes(const ROM_buffer *buffer)
+{
+	QVector<quint64> hashes;
+	for(int i = 0; i < buffer->size(); i += bank_size){
+		hashes.append(hash(buffer->data() + i, qMin(bank_size, buffer->size() - i), i));
+	}
+	return hashes;
+}
+
+static const quint64 prime1 = 11400714785074694791ULL;
+static const quint64 prime2 = 14029467366897019727ULL;
+static const quint64 prime3 = 1609587929392839161ULL;
+static const quint64 prime4 = 9650029242287828579ULL;
+static const quint64 prime5 = 2870177450012600261ULL;
+
+static inline quint64 rotate(quint64 value, int bits){ return (value << bits) | (value >> (64 - bits)); }
+static inline quint64 read64(const uchar *p){ return qFromLittleEndian<quint64>(p); }
+static inline quint64 read32(const uchar *p){ return qFromLittleEndian<quint32>(p); }
+static inline quint64 hash_round(quint64 acc, quint64 input){ return rotate(acc + input * prime2, 31) * prime1; }
+static inline quint64 hash_merge(quint64 acc, quint64 value){ return (acc ^ hash_round(0, value)) * prime1 + prime4; }
+
+//xxHash64
+quint64 analysis_cache::hash(const char *data, int length, quint64 seed)
+{
+	const uchar *p = (const uchar *)data;
+	const uchar *end = p + length;
+	quint64 h;
+	
+	if(length >= 32){
+		quint64 v1 = seed + prime1 + prime2;
+		quint64 v2 = seed + prime2;
+		quint64 v3 = seed;
+		quint64 v4 = seed - prime1;
+		do{
+			v1 = hash_round(v1, read64(p));
+			v2 = hash_round(v2, read64(p + 8));
+			v3 = hash_round(v3, read64(p + 16));
+			v4 = hash_round(v4, read64(p + 24));
+			p += 32;
+		}while(p <= end - 32);
+		h = rotate(v1, 1) + rotate(v2, 7) + rotate(v3, 12) + rotate(v4, 18);
+		h = hash_merge(hash_merge(hash_merge(hash_merge(h, v1), v2), v3), v4);
+	}else{
+		h = seed + prime5;
+	}
+	h += (quint64)length;
+	
+	for(; p + 8 <= end; p += 8){
+		h = rotate(h ^ hash_round(0, read64(p)), 27) * prime1 + prime4;
+	}
+	if(p + 4 <= end){
+		h = rotate(h ^ (read32(p) * prime1), 23) * prime2 + prime3;
+		p += 4;
+	}
+	for(; p < end; p++){
+		h = rotate(h ^ (*p * prime5), 11) * prime1;
+	}
+	
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	h *= prime3;
+	h ^= h >> 32;
+	return h;
+}
+
+QString analysis_cache::cache_path(quint64 key)
+{
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + 
+	       "/analysis/" + QString::number(key, 16) + ".sac";
+}
+
+QString analysis_cache::path_key(const ROM_buffer *buffer)
+{
+	QByteArray path = buffer->get_file_path().toUtf8();
+	return "analysis_cache/" + QString::number(hash(path.constData(), path.size()), 16);
+}
+
+quint64 analysis_cache::content_key(const QVector<quint64> &hashes)
+{
+	return hash((const char *)hashes.constData(), hashes.size() * sizeof(quint64));
+}
+
+const int analysis_cache::bank_size;
@@ -0,0 +1,30 @@
+#ifndef ANALYSIS_CACHE_H
+#define ANALYSIS_CACHE_H
+
+#include <QString>
+#include <QVector>
+
+#include "analysis/code_map.h"
+
+class ROM_buffer;
+
+class analysis_cache
+{
+	public:
+		static const int bank_size = 0x8000;
+		
+		static bool load(const ROM_buffer *buffer, code_map &map);
+		static void save(const ROM_buffer *buffer, const code_map &map);
+		static QVector<quint64> bank_hashes(const ROM_buffer *buffer);
+		static quint64 hash(const char *data, int length, quint64 seed = 0);
+		
+	private:
+		static const quint32 magic = 0x53484143; //SHAC
+		static const quint16 version = 1;
+		
+		static QString cache_path(quint64 key);
+		static QString path_key(const ROM_buffer *buffer);
+		static quint64 content_key(const QVector<quint64> &hashes);
+};
+
+#endif // ANALYSIS_CACHE_H
@@ -0,0 +1,252 @@
+#include <algorithm>
+
+#include "code_analyzer.h"
+#include "analysis_cache.h"
+#include "disassembly_cores/isa_65c816.h"
+#include "debug.h"
+
+code_analyzer::code_analyzer(const ROM_buffer *b) : buffer(b)
+{
+}
+
+void code_analyzer::add_entry(int address, bool A_state, bool I_state)
+{
+	int offset = buffer->snes_to_pc(address);
+	if(offset < 0 || offset >= buffer->size()){
+		return;
+	}
+	entries.append({offset, A_state, I_state});
+}
+
+void code_analyzer::add_vectors()
+{
+	for(int i = 0; i < ROM_metadata::VECTOR_COUNT; i++){
+		unsigned short vector = buffer->get_vector(ROM_metadata::vector_strings[i].first);
+		if(vector >= 0x8000){
+			add_entry(vector);
+		}
+	}
+}
+
+void code_analyzer::add_bookmarks(const bookmark_map &bookmarks)
+{
+	for(const auto &bookmark : bookmarks){
+		if(bookmark.data_type & bookmark_data::CODE){
+			add_entry(bookmark.address, bookmark.data_type & bookmark_data::A, 
+			          bookmark.data_type & bookmark_data::I);
+			continue;
+		}
+		
+		int width = (bookmark.data_type & bookmark_data::WORD) ? 2 :
+		            (bookmark.data_type & bookmark_data::LONG) ? 3 : 0;
+		int start = buffer->snes_to_pc(bookmark.address);
+		if(!bookmark.data_is_pointer || !width || start < 0){
+			continue;
+		}
+		for(int i = 0; i + width <= bookmark.size && start + i + width <= buffer->size(); i += width){
+			int pointer = read_operand(buffer, start + i, width);
+			if(width == 2){
+				pointer |= bookmark.address & 0xFF0000;
+			}
+			add_entry(pointer);
+		}
+	}
+}
+
+//Reuse the banks of an earlier analysis which have not changed since, only the rest is traced again
+void code_analyzer::resume(const code_map &map, const QVector<quint64> &hashes)
+{
+	const QVector<quint64> &analyzed = map.get_bank_hashes();
+	if(map.size() != buffer->size() || analyzed.size() != hashes.size()){
+		return;
+	}
+	previous = map;
+	clean_banks.fill(false, hashes.size());
+	for(int i = 0; i < hashes.size(); i++){
+		clean_banks[i] = analyzed[i] == hashes[i];
+	}
+}
+
+code_map code_analyzer::run(int thread_count)
+{
+	int size = buffer->size();
+	flags.reset(new std::atomic<unsigned char>[size]);
+	for(int i = 0; i < size; i++){
+		flags[i].store(0, std::memory_order_relaxed);
+	}
+	
+	thread_count = qMax(thread_count, 1);
+	labels = QVector<QVector<int>>(thread_count);
+	work_queue<entry> queue(thread_count);
+	restore_clean_banks(queue);
+	
+	//Deal the entry points out round robin, stealing evens out whatever imbalance is left
+	for(int i = 0; i < entries.size(); i++){
+		flags[entries[i].offset].fetch_or(code_map::ENTRY, std::memory_order_relaxed);
+		queue.push(i % thread_count, entries[i]);
+	}
+	queue.run([this, &queue](int worker, const entry &start){ trace(worker, start, queue); });
+	
+	QByteArray map(size, 0);
+	for(int i = 0; i < size; i++){
+		map[i] = flags[i].load(std::memory_order_relaxed);
+	}
+	for(const auto &worker_labels : labels){
+		for(int label : worker_labels){
+			map[label] = map.at(label) | code_map::LABEL;
+		}
+	}
+	flags.reset();
+	labels.clear();
+	previous = code_map();
+	return code_map(map);
+}
+
+void code_analyzer::trace(int worker, entry start, work_queue<entry> &queue)
+{
+	int offset = start.offset;
+	bool A_state = start.A_state;
+	bool I_state = start.I_state;
+	int size = buffer->size();
+	
+	while(offset >= 0 && offset < size){
+		int address = buffer->pc_to_snes(offset);
+		if(address < 0 || !claim(offset, code_map::OPCODE)){
+			return; //Unmapped, or somebody already decoded this instruction
+		}
+		unsigned char op = buffer->at(offset);
+		int length = isa_65c816::operand_size(op, A_state, I_state) + 1;
+		if(offset + length > size){
+			return;
+		}
+		flags[offset].fetch_or((A_state ? code_map::A_16 : 0) | (I_state ? code_map::I_16 : 0), 
+		                       std::memory_order_relaxed);
+		for(int i = 1; i < length; i++){
+			flags[offset + i].fetch_or(code_map::OPERAND, std::memory_order_relaxed);
+		}
+		
+		bool stop = false;
+		int target = follow(buffer, offset, op, length, stop);
+		if(op == 0xC2 || op == 0xE2){
+			unsigned char mask = buffer->at(offset + 1);
+			A_state = (mask & 0x20) ? op == 0xC2 : A_state;
+			I_state = (mask & 0x10) ? op == 0xC2 : I_state;
+		}
+		
+		if(target != -1){
+			int target_offset = buffer->snes_to_pc(target);
+			if(target_offset >= 0 && target_offset < size){
+				labels[worker].append(target_offset);
+				queue.push(worker, {target_offset, A_state, I_state});
+			}
+		}
+		
+		offset += length;
+		if(stop || (buffer->pc_to_snes(offset) & 0xFF0000) != (address & 0xFF0000)){
+			return; //The program counter wraps in bank, we don't follow it
+		}
+	}
+}
+
+void code_analyzer::restore_clean_banks(work_queue<entry> &queue)
+{
+	if(!previous.is_valid()){
+		return;
+	}
+	const QByteArray &map = previous.get_flags();
+	for(int bank = 0; bank < clean_banks.size(); bank++){
+		if(!clean_banks[bank]){
+			continue;
+		}
+		int end = qMin((bank + 1) * analysis_cache::bank_size, map.size());
+		for(int i = bank * analysis_cache::bank_size; i < end; i++){
+			flags[i].store(map.at(i) & ~code_map::LABEL, std::memory_order_relaxed);
+		}
+	}
+	
+	//Anything in a clean bank that leads into a dirty one seeds the trace again, by a jump or by falling through
+	auto seed = [&](int offset, bool A_state, bool I_state){
+		if(offset >= 0 && offset < map.size() && !clean_banks[offset / analysis_cache::bank_size]){
+			queue.push(0, {offset, A_state, I_state});
+		}
+	};
+	for(int bank = 0; bank < clean_banks.size(); bank++){
+		int end = qMin((bank + 1) * analysis_cache::bank_size, map.size());
+		for(int i = bank * analysis_cache::bank_size; clean_banks[bank] && i < end; i++){
+			unsigned char state = map.at(i);
+			if(!(state & code_map::OPCODE)){
+				continue;
+			}
+			if(state & code_map::LABEL){
+				labels[0].append(i);
+			}
+			unsigned char op = buffer->at(i);
+			bool A_state = state & code_map::A_16;
+			bool I_state = state & code_map::I_16;
+			int length = isa_65c816::operand_size(op, A_state, I_state) + 1;
+			bool stop = false;
+			int target = follow(buffer, i, op, length, stop);
+			if(op == 0xC2 || op == 0xE2){
+				unsigned char mask = buffer->at(i + 1);
+				A_state = (mask & 0x20) ? op == 0xC2 : A_state;
+				I_state = (mask & 0x10) ? op == 0xC2 : I_state;
+			}
+			if(target != -1){
+				seed(buffer->snes_to_pc(target), A_state, I_state);
+			}
+			int next = i + length;
+			if(!stop && (buffer->pc_to_snes(next) & 0xFF0000) == (buffer->pc_to_snes(i) & 0xFF0000)){
+				seed(next, A_state, I_state);
+			}
+		}
+	}
+}
+
+//Returns the SNES address control flow can continue at, besides falling through
+int code_analyzer::follow(const ROM_buffer *buffer, int offset, unsigned char op, int length, bool &stop)
+{
+	int operand = read_operand(buffer, offset + 1, length - 1);
+	int address = buffer->pc_to_snes(offset);
+	int bank = address & 0xFF0000;
+	int next = (address + length) & 0xFFFF;
+	switch(op){
+		case 0x10: case 0x30: case 0x50: case 0x70: 
+		case 0x90: case 0xB0: case 0xD0: case 0xF0:
+			return bank | ((next + (char)operand) & 0xFFFF);
+		case 0x80: //BRA
+			stop = true;
+			return bank | ((next + (char)operand) & 0xFFFF);
+		case 0x82: //BRL
+			stop = true;
+			return bank | ((next + (short)operand) & 0xFFFF);
+		case 0x20: //JSR
+			return bank | operand;
+		case 0x22: //JSL
+			return operand;
+		case 0x4C: //JMP
+			stop = true;
+			return bank | operand;
+		case 0x5C: //JML
+			stop = true;
+			return operand;
+		case 0x00: case 0x40: case 0x60: case 0x6B: //BRK, RTI, RTS, RTL
+		case 0x6C: case 0x7C: case 0xDC: case 0xDB: //indirect jumps, STP
+			stop = true;
+		break;
+	}
+	return -1;
+}
+
+bool code_analyzer::claim(int offset, unsigned char flag)
+{
+	return !(flags[offset].fetch_or(flag, std::memory_order_relaxed) & flag);
+}
+
+int code_analyzer::read_operand(const ROM_buffer *buffer, int offset, int size)
+{
+	int operand = 0;
+	for(int i = 0; i < size; i++){
+		operand |= (unsigned char)buffer->at(offset + i) << (i * 8);
+	}
+	return operand;
+}
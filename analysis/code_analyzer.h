@@ -0,0 +1,43 @@
+#ifndef CODE_ANALYZER_H
+#define CODE_ANALYZER_H
+
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+#include "rom_buffer.h"
+#include "analysis/code_map.h"
+#include "analysis/work_queue.h"
+
+class code_analyzer
+{
+	public:
+		explicit code_analyzer(const ROM_buffer *b);
+		void add_entry(int address, bool A_state = false, bool I_state = false);
+		void add_vectors();
+		void add_bookmarks(const bookmark_map &bookmarks);
+		void resume(const code_map &map, const QVector<quint64> &hashes);
+		code_map run(int thread_count = QThread::idealThreadCount());
+		static int follow(const ROM_buffer *buffer, int offset, unsigned char op, int length, bool &stop);
+		static int read_operand(const ROM_buffer *buffer, int offset, int size);
+		
+	private:
+		struct entry{
+			int offset;
+			bool A_state;
+			bool I_state;
+		};
+		
+		const ROM_buffer *buffer;
+		QVector<entry> entries;
+		std::unique_ptr<std::atomic<unsigned char>[]> flags;
+		QVector<QVector<int>> labels;
+		code_map previous;
+		QVector<bool> clean_banks;
+		
+		void trace(int worker, entry start, work_queue<entry> &queue);
+		void restore_clean_banks(work_queue<entry> &queue);
+		bool claim(int offset, unsigned char flag);
+};
+
+#endif // CODE_ANALYZER_H
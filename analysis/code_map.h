@@ -0,0 +1,84 @@
+#ifndef CODE_MAP_H
+#define CODE_MAP_H
+
+#include <QByteArray>
+#include <QVector>
+
+class code_map
+{
+	public:
+		enum flags{
+			OPCODE = 1,
+			OPERAND = 2,
+			A_16 = 4,
+			I_16 = 8,
+			LABEL = 16,
+			ENTRY = 32,
+			DATA = 64, //read as data by a traced run
+			INDIRECT = 128, //reached through an indirect jump in a traced run
+			ALT1 = A_16, //GSU maps keep the ALT state where the 65c816 keeps its register sizes
+			ALT2 = I_16
+		};
+		
+		static int alt_state(unsigned char flags){ return (flags & ALT1 ? 1 : 0) | (flags & ALT2 ? 2 : 0); }
+		static unsigned char alt_flags(int alt){ return (alt & 1 ? ALT1 : 0) | (alt & 2 ? ALT2 : 0); }
+		
+		code_map(){}
+		explicit code_map(QByteArray f) : map(f)
+		{
+			for(int i = 0; i < map.size(); i++){
+				if(map.at(i) & LABEL){
+					labels.append(i);
+				}
+			}
+		}
+		
+		bool is_valid() const { return !map.isEmpty(); }
+		int size() const { return map.size(); }
+		unsigned char at(int offset) const { return offset >= 0 && offset < map.size() ? map.at(offset) : 0; }
+		bool is_opcode(int offset) const { return at(offset) & OPCODE; }
+		bool is_code(int offset) const { return at(offset) & (OPCODE | OPERAND); }
+		const QVector<int> &get_labels() const { return labels; }
+		const QByteArray &get_flags() const { return map; }
+		
+		//Hashes of each bank when it was analyzed, a bank that no longer matches needs analyzing again
+		const QVector<quint64> &get_bank_hashes() const { return bank_hashes; }
+		void set_bank_hashes(QVector<quint64> hashes){ bank_hashes = hashes; }
+		
+		//Lays a traced map over this one, bytes seen running keep their traced state
+		code_map overlay(const code_map &traced) const
+		{
+			QByteArray flags = map;
+			if(flags.size() < traced.size()){
+				flags.append(QByteArray(traced.size() - flags.size(), 0));
+			}
+			const QByteArray &trace = traced.get_flags();
+			for(int i = 0; i < trace.size(); i++){
+				unsigned char state = trace.at(i);
+				if(state & (OPCODE | OPERAND)){
+					flags[i] = state | (flags.at(i) & (LABEL | ENTRY | DATA | INDIRECT));
+				}else if(state){
+					flags[i] = flags.at(i) | state;
+				}
+			}
+			code_map merged(flags);
+			merged.set_bank_hashes(bank_hashes);
+			return merged;
+		}
+		
+		int instruction_count() const
+		{
+			int count = 0;
+			for(char flag : map){
+				count += flag & OPCODE;
+			}
+			return count;
+		}
+		
+	private:
+		QByteArray map;
+		QVector<int> labels;
+		QVector<quint64> bank_hashes;
+};
+
+#endif // CODE_MAP_H
@@ -0,0 +1,987 @@
+#include <cstring>
+
+#include "cpu_tracer.h"
+#include "disassembly_cores/isa_65c816.h"
+
+cpu_tracer::cpu_tracer(const ROM_buffer *b) : buffer(b)
+{
+	rom_size = buffer->size();
+	trace.fill(0, rom_size);
+	trace_data = (unsigned char *)trace.data();
+	wram.fill(0, 0x20000);
+	sram.fill(0, 0x20000);
+	map_pages();
+	reset();
+}
+
+//Every 4KB page is either straight memory or hardware, so reads only need a table lookup
+void cpu_tracer::map_pages()
+{
+	const unsigned char *rom = (const unsigned char *)buffer->data();
+	unsigned char *work = (unsigned char *)wram.data();
+	unsigned char *save = (unsigned char *)sram.data();
+	for(int page = 0; page < page_count; page++){
+		int address = page << page_bits;
+		int bank = address >> 16;
+		bool system = !(bank & 0x40);
+		int low = address & 0xFFFF;
+		read_pages[page] = nullptr;
+		write_pages[page] = nullptr;
+		rom_pages[page] = -1;
+		
+		if(bank == 0x7E || bank == 0x7F){
+			write_pages[page] = work + (address & 0x1FFFF);
+		}else if(system && low < 0x2000){
+			write_pages[page] = work + low;
+		}else if(system && low < 0x6000){
+			continue;
+		}else{
+			int offset = buffer->snes_to_pc(address);
+			if(offset >= 0 && offset + page_mask < rom_size && buffer->snes_to_pc(address + page_mask) == offset + page_mask){
+				rom_pages[page] = offset;
+				read_pages[page] = rom + offset;
+				continue;
+			}else if((bank & 0x7F) >= 0x70 || (system && low < 0x8000)){
+				write_pages[page] = save + (address & 0x1F000);
+			}
+		}
+		read_pages[page] = write_pages[page];
+	}
+}
+
+void cpu_tracer::reset()
+{
+	A = X = Y = D = 0;
+	S = 0x01FF;
+	DB = PB = 0;
+	P = M_FLAG | X_FLAG | I_FLAG;
+	E = true;
+	stopped = false;
+	nmi_countdown = nmi_interval;
+	
+	apu_ports[0] = 0xAA; //the SPC700 IPL announces itself with $BBAA
+	apu_ports[1] = 0xBB;
+	apu_ports[2] = apu_ports[3] = 0;
+	memset(dma, 0, sizeof(dma));
+	nmi_enable = nmi_flag = blank_flags = 0;
+	multiplicand = 0xFF;
+	dividend = 0xFFFF;
+	memset(math, 0, sizeof(math));
+	wram_address = 0;
+	
+	PC = read_word(0xFFFC, 0xFFFF);
+	mark_label();
+	int offset = rom_pages[PC >> page_bits];
+	if(offset != -1){
+		trace_data[offset + (PC & page_mask)] |= code_map::ENTRY;
+	}
+}
+
+inline unsigned char cpu_tracer::read(int address)
+{
+	const unsigned char *page = read_pages[address >> page_bits];
+	if(page){
+		return page[address & page_mask];
+	}
+	int low = address & 0xFFFF;
+	if(!(address & 0x400000) && low >= 0x2000 && low < 0x6000){
+		return read_io(low);
+	}
+	return 0;
+}
+
+inline void cpu_tracer::write(int address, unsigned char value)
+{
+	unsigned char *page = write_pages[address >> page_bits];
+	if(page){
+		page[address & page_mask] = value;
+		return;
+	}
+	int low = address & 0xFFFF;
+	if(!(address & 0x400000) && low >= 0x2000 && low < 0x6000){
+		write_io(low, value);
+	}
+}
+
+//Status registers flip on every read so loops waiting for either edge of a flag get through
+unsigned char cpu_tracer::read_io(int address)
+{
+	switch(address){
+		case 0x2140 ... 0x217F:
+			return apu_ports[address & 3];
+		case 0x2180:{
+			unsigned char value = wram.at(wram_address);
+			wram_address = (wram_address + 1) & 0x1FFFF;
+			return value;
+		}
+		case 0x4210:
+			nmi_flag ^= 0x80;
+			return nmi_flag | 0x02;
+		case 0x4212:
+			blank_flags ^= 0xC0;
+			return blank_flags;
+		case 0x4214 ... 0x4217:
+			return math[address - 0x4214];
+		case 0x4300 ... 0x437F:
+			return dma[address & 0x7F];
+		default:
+			return 0;
+	}
+}
+
+//The APU ports echo what was written, which satisfies the handshake of most upload routines
+void cpu_tracer::write_io(int address, unsigned char value)
+{
+	switch(address){
+		case 0x2140 ... 0x217F:
+			apu_ports[address & 3] = value;
+		break;
+		case 0x2180:
+			wram[wram_address] = value;
+			wram_address = (wram_address + 1) & 0x1FFFF;
+		break;
+		case 0x2181:
+			wram_address = (wram_address & 0x1FF00) | value;
+		break;
+		case 0x2182:
+			wram_address = (wram_address & 0x100FF) | value << 8;
+		break;
+		case 0x2183:
+			wram_address = (wram_address & 0xFFFF) | (value & 1) << 16;
+		break;
+		case 0x4200:
+			nmi_enable = value & 0x80;
+		break;
+		case 0x4202:
+			multiplicand = value;
+		break;
+		case 0x4203:{
+			int product = multiplicand * value;
+			math[0] = value;
+			math[1] = 0;
+			math[2] = product;
+			math[3] = product >> 8;
+		}
+		break;
+		case 0x4204:
+			dividend = (dividend & 0xFF00) | value;
+		break;
+		case 0x4205:
+			dividend = (dividend & 0x00FF) | value << 8;
+		break;
+		case 0x4206:{
+			int quotient = value ? dividend / value : 0xFFFF;
+			int remainder = value ? dividend % value : dividend;
+			math[0] = quotient;
+			math[1] = quotient >> 8;
+			math[2] = remainder;
+			math[3] = remainder >> 8;
+		}
+		break;
+		case 0x420B:
+			run_dma(value);
+		break;
+		case 0x4300 ... 0x437F:
+			dma[address & 0x7F] = value;
+		break;
+	}
+}
+
+//Only transfers into the work RAM port change anything the CPU can read back
+void cpu_tracer::run_dma(unsigned char channels)
+{
+	for(int channel = 0; channel < 8; channel++){
+		unsigned char *registers = dma + channel * 0x10;
+		if(!(channels & 1 << channel) || registers[1] != 0x80 || registers[0] & 0x80){
+			continue;
+		}
+		int source = registers[4] << 16 | registers[3] << 8 | registers[2];
+		int count = registers[6] << 8 | registers[5];
+		int step = registers[0] & 0x08 ? 0 : registers[0] & 0x10 ? -1 : 1;
+		do{
+			wram[wram_address] = read(source);
+			wram_address = (wram_address + 1) & 0x1FFFF;
+			source = (source & 0xFF0000) | ((source + step) & 0xFFFF);
+		}while(--count & 0xFFFF);
+		registers[5] = registers[6] = 0;
+	}
+}
+
+inline void cpu_tracer::record(int address, unsigned char op)
+{
+	int offset = rom_pages[address >> page_bits];
+	if(offset == -1){
+		return;
+	}
+	offset += address & page_mask;
+	trace_data[offset] = (trace_data[offset] & (code_map::LABEL | code_map::ENTRY)) | code_map::OPCODE |
+	                     (memory_8() ? 0 : code_map::A_16) | (index_8() ? 0 : code_map::I_16);
+	int end = offset + isa_65c816::operand_size(op, !memory_8(), !index_8());
+	for(offset++; offset <= end && offset < rom_size; offset++){
+		trace_data[offset] |= code_map::OPERAND;
+	}
+}
+
+inline void cpu_tracer::mark_label()
+{
+	int address = PB << 16 | PC;
+	int offset = rom_pages[address >> page_bits];
+	if(offset != -1){
+		trace_data[offset + (address & page_mask)] |= code_map::LABEL;
+	}
+}
+
+inline void cpu_tracer::set_nz(int value, bool eight)
+{
+	P = (P & ~(N_FLAG | Z_FLAG)) | (value ? 0 : Z_FLAG) | ((value >> (eight ? 7 : 15)) & 1 ? N_FLAG : 0);
+}
+
+inline void cpu_tracer::set_status(unsigned char status)
+{
+	P = E ? status | M_FLAG | X_FLAG : status;
+	if(P & X_FLAG){
+		X &= 0xFF;
+		Y &= 0xFF;
+	}
+}
+
+void cpu_tracer::exchange_carry()
+{
+	bool carry = P & C_FLAG;
+	set_flag(C_FLAG, E);
+	E = carry;
+	if(E){
+		S = 0x0100 | (S & 0xFF);
+	}
+	set_status(P);
+}
+
+inline unsigned char cpu_tracer::fetch()
+{
+	return read(PB << 16 | PC++);
+}
+
+inline unsigned short cpu_tracer::fetch_word()
+{
+	unsigned short low = fetch();
+	return low | fetch() << 8;
+}
+
+inline int cpu_tracer::fetch_long()
+{
+	int low = fetch_word();
+	return low | fetch() << 16;
+}
+
+//Wrap is the mask the pointer stays inside, bank 0 pointers wrap at the end of the bank
+inline unsigned short cpu_tracer::read_word(int address, int wrap)
+{
+	unsigned short low = read(address);
+	return low | read((address & ~wrap) | ((address + 1) & wrap)) << 8;
+}
+
+inline int cpu_tracer::read_long(int address, int wrap)
+{
+	int low = read_word(address, wrap);
+	return low | read((address & ~wrap) | ((address + 2) & wrap)) << 16;
+}
+
+inline int cpu_tracer::immediate_8()
+{
+	return PB << 16 | PC++;
+}
+
+inline int cpu_tracer::immediate_m()
+{
+	int address = PB << 16 | PC;
+	PC += memory_8() ? 1 : 2;
+	return address;
+}
+
+inline int cpu_tracer::immediate_x()
+{
+	int address = PB << 16 | PC;
+	PC += index_8() ? 1 : 2;
+	return address;
+}
+
+inline int cpu_tracer::direct()
+{
+	return (D + fetch()) & 0xFFFF;
+}
+
+inline int cpu_tracer::direct_x()
+{
+	return (D + fetch() + X) & 0xFFFF;
+}
+
+inline int cpu_tracer::direct_y()
+{
+	return (D + fetch() + Y) & 0xFFFF;
+}
+
+inline int cpu_tracer::direct_indirect()
+{
+	return DB << 16 | read_word(direct(), 0xFFFF);
+}
+
+inline int cpu_tracer::direct_x_indirect()
+{
+	return DB << 16 | read_word(direct_x(), 0xFFFF);
+}
+
+inline int cpu_tracer::direct_indirect_y()
+{
+	return (direct_indirect() + Y) & 0xFFFFFF;
+}
+
+inline int cpu_tracer::direct_indirect_long()
+{
+	return read_long(direct(), 0xFFFF);
+}
+
+inline int cpu_tracer::direct_indirect_long_y()
+{
+	return (direct_indirect_long() + Y) & 0xFFFFFF;
+}
+
+inline int cpu_tracer::stack()
+{
+	return (S + fetch()) & 0xFFFF;
+}
+
+inline int cpu_tracer::stack_indirect_y()
+{
+	return ((DB << 16 | read_word(stack(), 0xFFFF)) + Y) & 0xFFFFFF;
+}
+
+inline int cpu_tracer::absolute()
+{
+	return DB << 16 | fetch_word();
+}
+
+inline int cpu_tracer::absolute_x()
+{
+	return (absolute() + X) & 0xFFFFFF;
+}
+
+inline int cpu_tracer::absolute_y()
+{
+	return (absolute() + Y) & 0xFFFFFF;
+}
+
+inline int cpu_tracer::long_address()
+{
+	return fetch_long();
+}
+
+inline int cpu_tracer::long_x()
+{
+	return (fetch_long() + X) & 0xFFFFFF;
+}
+
+inline unsigned short cpu_tracer::load_m(int address)
+{
+	return memory_8() ? read(address) : read_word(address, 0xFFFFFF);
+}
+
+inline unsigned short cpu_tracer::load_x(int address)
+{
+	return index_8() ? read(address) : read_word(address, 0xFFFFFF);
+}
+
+inline void cpu_tracer::store_m(int address, unsigned short value)
+{
+	write(address, value);
+	if(!memory_8()){
+		write((address + 1) & 0xFFFFFF, value >> 8);
+	}
+}
+
+inline void cpu_tracer::store_x(int address, unsigned short value)
+{
+	write(address, value);
+	if(!index_8()){
+		write((address + 1) & 0xFFFFFF, value >> 8);
+	}
+}
+
+inline void cpu_tracer::load_a(unsigned short value)
+{
+	if(memory_8()){
+		A = (A & 0xFF00) | (value & 0xFF);
+		set_nz(value & 0xFF, true);
+	}else{
+		A = value;
+		set_nz(value, false);
+	}
+}
+
+inline unsigned short cpu_tracer::load_index(int value)
+{
+	value &= index_8() ? 0xFF : 0xFFFF;
+	set_nz(value, index_8());
+	return value;
+}
+
+inline void cpu_tracer::push(unsigned char value)
+{
+	write(S, value);
+	S = E ? 0x0100 | ((S - 1) & 0xFF) : S - 1;
+}
+
+inline unsigned char cpu_tracer::pull()
+{
+	S = E ? 0x0100 | ((S + 1) & 0xFF) : S + 1;
+	return read(S);
+}
+
+inline void cpu_tracer::push_word(unsigned short value)
+{
+	push(value >> 8);
+	push(value);
+}
+
+inline unsigned short cpu_tracer::pull_word()
+{
+	unsigned short low = pull();
+	return low | pull() << 8;
+}
+
+inline void cpu_tracer::push_m(unsigned short value)
+{
+	memory_8() ? push(value) : push_word(value);
+}
+
+inline unsigned short cpu_tracer::pull_m()
+{
+	return memory_8() ? pull() : pull_word();
+}
+
+inline void cpu_tracer::push_x(unsigned short value)
+{
+	index_8() ? push(value) : push_word(value);
+}
+
+inline unsigned short cpu_tracer::pull_x()
+{
+	return index_8() ? pull() : pull_word();
+}
+
+inline void cpu_tracer::push_relative()
+{
+	short offset = fetch_word();
+	push_word(PC + offset);
+}
+
+//Works a digit at a time, subtraction gets the inverted operand like the binary path
+int cpu_tracer::decimal_add(int a, int value, int digits, bool subtract) const
+{
+	int result = 0;
+	int carry = P & C_FLAG;
+	for(int shift = 0; shift < digits * 4; shift += 4){
+		int digit = (a >> shift & 0xF) + (value >> shift & 0xF) + carry;
+		if(subtract ? digit <= 0xF : digit > 9){
+			digit += subtract ? -6 : 6;
+		}
+		carry = digit > 0xF;
+		result |= (digit & 0xF) << shift;
+	}
+	return result | carry << (digits * 4);
+}
+
+void cpu_tracer::add(int value)
+{
+	bool eight = memory_8();
+	int mask = eight ? 0xFF : 0xFFFF;
+	int a = A & mask;
+	value &= mask;
+	int result = P & D_FLAG ? decimal_add(a, value, eight ? 2 : 4, false) : a + value + (P & C_FLAG);
+	set_flag(V_FLAG, ~(a ^ value) & (a ^ result) & (eight ? 0x80 : 0x8000));
+	set_flag(C_FLAG, result > mask);
+	load_a(result);
+}
+
+void cpu_tracer::subtract(int value)
+{
+	bool eight = memory_8();
+	int mask = eight ? 0xFF : 0xFFFF;
+	int a = A & mask;
+	value = ~value & mask;
+	int result = P & D_FLAG ? decimal_add(a, value, eight ? 2 : 4, true) : a + value + (P & C_FLAG);
+	set_flag(V_FLAG, ~(a ^ value) & (a ^ result) & (eight ? 0x80 : 0x8000));
+	set_flag(C_FLAG, result > mask);
+	load_a(result);
+}
+
+inline void cpu_tracer::compare(int reg, int value, bool eight)
+{
+	int mask = eight ? 0xFF : 0xFFFF;
+	int result = (reg & mask) - (value & mask);
+	set_flag(C_FLAG, result >= 0);
+	set_nz(result & mask, eight);
+}
+
+inline void cpu_tracer::test_bits(unsigned short value)
+{
+	int shift = memory_8() ? 0 : 8;
+	set_flag(Z_FLAG, !(A & value & (memory_8() ? 0xFF : 0xFFFF)));
+	set_flag(N_FLAG, value >> shift & 0x80);
+	set_flag(V_FLAG, value >> shift & 0x40);
+}
+
+inline void cpu_tracer::immediate_bits(unsigned short value)
+{
+	set_flag(Z_FLAG, !(A & value & (memory_8() ? 0xFF : 0xFFFF)));
+}
+
+void cpu_tracer::test_set(int address)
+{
+	unsigned short value = load_m(address);
+	immediate_bits(value);
+	store_m(address, value | A);
+}
+
+void cpu_tracer::test_reset(int address)
+{
+	unsigned short value = load_m(address);
+	immediate_bits(value);
+	store_m(address, value & ~A);
+}
+
+unsigned short cpu_tracer::shift_left(unsigned short value)
+{
+	bool eight = memory_8();
+	set_flag(C_FLAG, value & (eight ? 0x80 : 0x8000));
+	value = (value << 1) & (eight ? 0xFF : 0xFFFF);
+	set_nz(value, eight);
+	return value;
+}
+
+unsigned short cpu_tracer::shift_right(unsigned short value)
+{
+	bool eight = memory_8();
+	set_flag(C_FLAG, value & 1);
+	value = (value & (eight ? 0xFF : 0xFFFF)) >> 1;
+	set_nz(value, eight);
+	return value;
+}
+
+unsigned short cpu_tracer::rotate_left(unsigned short value)
+{
+	bool eight = memory_8();
+	int carry = P & C_FLAG;
+	set_flag(C_FLAG, value & (eight ? 0x80 : 0x8000));
+	value = ((value << 1) | carry) & (eight ? 0xFF : 0xFFFF);
+	set_nz(value, eight);
+	return value;
+}
+
+unsigned short cpu_tracer::rotate_right(unsigned short value)
+{
+	bool eight = memory_8();
+	int carry = P & C_FLAG;
+	set_flag(C_FLAG, value & 1);
+	value = ((value & (eight ? 0xFF : 0xFFFF)) >> 1) | (carry ? (eight ? 0x80 : 0x8000) : 0);
+	set_nz(value, eight);
+	return value;
+}
+
+unsigned short cpu_tracer::increment(unsigned short value)
+{
+	value = (value + 1) & (memory_8() ? 0xFF : 0xFFFF);
+	set_nz(value, memory_8());
+	return value;
+}
+
+unsigned short cpu_tracer::decrement(unsigned short value)
+{
+	value = (value - 1) & (memory_8() ? 0xFF : 0xFFFF);
+	set_nz(value, memory_8());
+	return value;
+}
+
+inline void cpu_tracer::modify(int address, unsigned short (cpu_tracer::*operation)(unsigned short))
+{
+	store_m(address, (this->*operation)(load_m(address)));
+}
+
+inline void cpu_tracer::branch(bool taken)
+{
+	signed char offset = fetch();
+	if(taken){
+		PC += offset;
+		mark_label();
+	}
+}
+
+inline void cpu_tracer::branch_long()
+{
+	short offset = fetch_word();
+	PC += offset;
+	mark_label();
+}
+
+inline void cpu_tracer::jump_long(int address)
+{
+	PB = address >> 16;
+	PC = address;
+	mark_label();
+}
+
+inline void cpu_tracer::call(unsigned short target)
+{
+	push_word(PC - 1);
+	PC = target;
+	mark_label();
+}
+
+inline void cpu_tracer::call_long()
+{
+	int target = fetch_long();
+	push(PB);
+	push_word(PC - 1);
+	jump_long(target);
+}
+
+void cpu_tracer::interrupt(unsigned short vector)
+{
+	if(!E){
+		push(PB);
+	}
+	push_word(PC);
+	push(P);
+	P = (P | I_FLAG) & ~D_FLAG;
+	PB = 0;
+	PC = read_word(vector, 0xFFFF);
+	mark_label();
+}
+
+void cpu_tracer::return_interrupt()
+{
+	set_status(pull());
+	PC = pull_word();
+	if(!E){
+		PB = pull();
+	}
+}
+
+//MVN and MVP run to completion as a single step
+void cpu_tracer::block_move(int step)
+{
+	int destination = fetch();
+	int source = fetch();
+	DB = destination;
+	int mask = index_8() ? 0xFF : 0xFFFF;
+	do{
+		write(destination << 16 | Y, read(source << 16 | X));
+		X = (X + step) & mask;
+		Y = (Y + step) & mask;
+	}while(A-- != 0);
+}
+
+//Dispatches through a table of label addresses, one indirect jump per instruction keeps this at tens
+//of millions of instructions a second. An NMI is raised once a frame whenever the game enabled it.
+int cpu_tracer::run(int steps)
+{
+	static void *const dispatch[256] = {
+		&&op_00, &&op_01, &&op_02, &&op_03, &&op_04, &&op_05, &&op_06, &&op_07, &&op_08, &&op_09, &&op_0A, &&op_0B, &&op_0C, &&op_0D, &&op_0E, &&op_0F,
+		&&op_10, &&op_11, &&op_12, &&op_13, &&op_14, &&op_15, &&op_16, &&op_17, &&op_18, &&op_19, &&op_1A, &&op_1B, &&op_1C, &&op_1D, &&op_1E, &&op_1F,
+		&&op_20, &&op_21, &&op_22, &&op_23, &&op_24, &&op_25, &&op_26, &&op_27, &&op_28, &&op_29, &&op_2A, &&op_2B, &&op_2C, &&op_2D, &&op_2E, &&op_2F,
+		&&op_30, &&op_31, &&op_32, &&op_33, &&op_34, &&op_35, &&op_36, &&op_37, &&op_38, &&op_39, &&op_3A, &&op_3B, &&op_3C, &&op_3D, &&op_3E, &&op_3F,
+		&&op_40, &&op_41, &&op_42, &&op_43, &&op_44, &&op_45, &&op_46, &&op_47, &&op_48, &&op_49, &&op_4A, &&op_4B, &&op_4C, &&op_4D, &&op_4E, &&op_4F,
+		&&op_50, &&op_51, &&op_52, &&op_53, &&op_54, &&op_55, &&op_56, &&op_57, &&op_58, &&op_59, &&op_5A, &&op_5B, &&op_5C, &&op_5D, &&op_5E, &&op_5F,
+		&&op_60, &&op_61, &&op_62, &&op_63, &&op_64, &&op_65, &&op_66, &&op_67, &&op_68, &&op_69, &&op_6A, &&op_6B, &&op_6C, &&op_6D, &&op_6E, &&op_6F,
+		&&op_70, &&op_71, &&op_72, &&op_73, &&op_74, &&op_75, &&op_76, &&op_77, &&op_78, &&op_79, &&op_7A, &&op_7B, &&op_7C, &&op_7D, &&op_7E, &&op_7F,
+		&&op_80, &&op_81, &&op_82, &&op_83, &&op_84, &&op_85, &&op_86, &&op_87, &&op_88, &&op_89, &&op_8A, &&op_8B, &&op_8C, &&op_8D, &&op_8E, &&op_8F,
+		&&op_90, &&op_91, &&op_92, &&op_93, &&op_94, &&op_95, &&op_96, &&op_97, &&op_98, &&op_99, &&op_9A, &&op_9B, &&op_9C, &&op_9D, &&op_9E, &&op_9F,
+		&&op_A0, &&op_A1, &&op_A2, &&op_A3, &&op_A4, &&op_A5, &&op_A6, &&op_A7, &&op_A8, &&op_A9, &&op_AA, &&op_AB, &&op_AC, &&op_AD, &&op_AE, &&op_AF,
+		&&op_B0, &&op_B1, &&op_B2, &&op_B3, &&op_B4, &&op_B5, &&op_B6, &&op_B7, &&op_B8, &&op_B9, &&op_BA, &&op_BB, &&op_BC, &&op_BD, &&op_BE, &&op_BF,
+		&&op_C0, &&op_C1, &&op_C2, &&op_C3, &&op_C4, &&op_C5, &&op_C6, &&op_C7, &&op_C8, &&op_C9, &&op_CA, &&op_CB, &&op_CC, &&op_CD, &&op_CE, &&op_CF,
+		&&op_D0, &&op_D1, &&op_D2, &&op_D3, &&op_D4, &&op_D5, &&op_D6, &&op_D7, &&op_D8, &&op_D9, &&op_DA, &&op_DB, &&op_DC, &&op_DD, &&op_DE, &&op_DF,
+		&&op_E0, &&op_E1, &&op_E2, &&op_E3, &&op_E4, &&op_E5, &&op_E6, &&op_E7, &&op_E8, &&op_E9, &&op_EA, &&op_EB, &&op_EC, &&op_ED, &&op_EE, &&op_EF,
+		&&op_F0, &&op_F1, &&op_F2, &&op_F3, &&op_F4, &&op_F5, &&op_F6, &&op_F7, &&op_F8, &&op_F9, &&op_FA, &&op_FB, &&op_FC, &&op_FD, &&op_FE, &&op_FF
+	};
+	
+	int executed = 0;
+	int address;
+	unsigned char op;
+	
+	#define NEXT goto next
+	
+	next:
+	if(stopped || executed == steps){
+		return executed;
+	}
+	executed++;
+	if(--nmi_countdown <= 0){
+		nmi_countdown = nmi_interval;
+		if(nmi_enable){
+			nmi_flag = 0x80;
+			interrupt(E ? 0xFFFA : 0xFFEA);
+		}
+	}
+	address = PB << 16 | PC;
+	op = fetch();
+	record(address, op);
+	goto *dispatch[op];
+	
+	op_00: fetch(); interrupt(E ? 0xFFFE : 0xFFE6); NEXT;
+	op_01: load_a(A | load_m(direct_x_indirect())); NEXT;
+	op_02: fetch(); interrupt(E ? 0xFFF4 : 0xFFE4); NEXT;
+	op_03: load_a(A | load_m(stack())); NEXT;
+	op_04: test_set(direct()); NEXT;
+	op_05: load_a(A | load_m(direct())); NEXT;
+	op_06: modify(direct(), &cpu_tracer::shift_left); NEXT;
+	op_07: load_a(A | load_m(direct_indirect_long())); NEXT;
+	op_08: push(P); NEXT;
+	op_09: load_a(A | load_m(immediate_m())); NEXT;
+	op_0A: load_a(shift_left(A)); NEXT;
+	op_0B: push_word(D); NEXT;
+	op_0C: test_set(absolute()); NEXT;
+	op_0D: load_a(A | load_m(absolute())); NEXT;
+	op_0E: modify(absolute(), &cpu_tracer::shift_left); NEXT;
+	op_0F: load_a(A | load_m(long_address())); NEXT;
+	op_10: branch(!(P & N_FLAG)); NEXT;
+	op_11: load_a(A | load_m(direct_indirect_y())); NEXT;
+	op_12: load_a(A | load_m(direct_indirect())); NEXT;
+	op_13: load_a(A | load_m(stack_indirect_y())); NEXT;
+	op_14: test_reset(direct()); NEXT;
+	op_15: load_a(A | load_m(direct_x())); NEXT;
+	op_16: modify(direct_x(), &cpu_tracer::shift_left); NEXT;
+	op_17: load_a(A | load_m(direct_indirect_long_y())); NEXT;
+	op_18: P &= ~C_FLAG; NEXT;
+	op_19: load_a(A | load_m(absolute_y())); NEXT;
+	op_1A: load_a(increment(A)); NEXT;
+	op_1B: S = E ? 0x0100 | (A & 0xFF) : A; NEXT;
+	op_1C: test_reset(absolute()); NEXT;
+	op_1D: load_a(A | load_m(absolute_x())); NEXT;
+	op_1E: modify(absolute_x(), &cpu_tracer::shift_left); NEXT;
+	op_1F: load_a(A | load_m(long_x())); NEXT;
+	op_20: call(fetch_word()); NEXT;
+	op_21: load_a(A & load_m(direct_x_indirect())); NEXT;
+	op_22: call_long(); NEXT;
+	op_23: load_a(A & load_m(stack())); NEXT;
+	op_24: test_bits(load_m(direct())); NEXT;
+	op_25: load_a(A & load_m(direct())); NEXT;
+	op_26: modify(direct(), &cpu_tracer::rotate_left); NEXT;
+	op_27: load_a(A & load_m(direct_indirect_long())); NEXT;
+	op_28: set_status(pull()); NEXT;
+	op_29: load_a(A & load_m(immediate_m())); NEXT;
+	op_2A: load_a(rotate_left(A)); NEXT;
+	op_2B: D = pull_word(); set_nz(D, false); NEXT;
+	op_2C: test_bits(load_m(absolute())); NEXT;
+	op_2D: load_a(A & load_m(absolute())); NEXT;
+	op_2E: modify(absolute(), &cpu_tracer::rotate_left); NEXT;
+	op_2F: load_a(A & load_m(long_address())); NEXT;
+	op_30: branch(P & N_FLAG); NEXT;
+	op_31: load_a(A & load_m(direct_indirect_y())); NEXT;
+	op_32: load_a(A & load_m(direct_indirect())); NEXT;
+	op_33: load_a(A & load_m(stack_indirect_y())); NEXT;
+	op_34: test_bits(load_m(direct_x())); NEXT;
+	op_35: load_a(A & load_m(direct_x())); NEXT;
+	op_36: modify(direct_x(), &cpu_tracer::rotate_left); NEXT;
+	op_37: load_a(A & load_m(direct_indirect_long_y())); NEXT;
+	op_38: P |= C_FLAG; NEXT;
+	op_39: load_a(A & load_m(absolute_y())); NEXT;
+	op_3A: load_a(decrement(A)); NEXT;
+	op_3B: A = S; set_nz(A, false); NEXT;
+	op_3C: test_bits(load_m(absolute_x())); NEXT;
+	op_3D: load_a(A & load_m(absolute_x())); NEXT;
+	op_3E: modify(absolute_x(), &cpu_tracer::rotate_left); NEXT;
+	op_3F: load_a(A & load_m(long_x())); NEXT;
+	op_40: return_interrupt(); NEXT;
+	op_41: load_a(A ^ load_m(direct_x_indirect())); NEXT;
+	op_42: fetch(); NEXT;
+	op_43: load_a(A ^ load_m(stack())); NEXT;
+	op_44: block_move(-1); NEXT;
+	op_45: load_a(A ^ load_m(direct())); NEXT;
+	op_46: modify(direct(), &cpu_tracer::shift_right); NEXT;
+	op_47: load_a(A ^ load_m(direct_indirect_long())); NEXT;
+	op_48: push_m(A); NEXT;
+	op_49: load_a(A ^ load_m(immediate_m())); NEXT;
+	op_4A: load_a(shift_right(A)); NEXT;
+	op_4B: push(PB); NEXT;
+	op_4C: PC = fetch_word(); mark_label(); NEXT;
+	op_4D: load_a(A ^ load_m(absolute())); NEXT;
+	op_4E: modify(absolute(), &cpu_tracer::shift_right); NEXT;
+	op_4F: load_a(A ^ load_m(long_address())); NEXT;
+	op_50: branch(!(P & V_FLAG)); NEXT;
+	op_51: load_a(A ^ load_m(direct_indirect_y())); NEXT;
+	op_52: load_a(A ^ load_m(direct_indirect())); NEXT;
+	op_53: load_a(A ^ load_m(stack_indirect_y())); NEXT;
+	op_54: block_move(1); NEXT;
+	op_55: load_a(A ^ load_m(direct_x())); NEXT;
+	op_56: modify(direct_x(), &cpu_tracer::shift_right); NEXT;
+	op_57: load_a(A ^ load_m(direct_indirect_long_y())); NEXT;
+	op_58: P &= ~I_FLAG; NEXT;
+	op_59: load_a(A ^ load_m(absolute_y())); NEXT;
+	op_5A: push_x(Y); NEXT;
+	op_5B: D = A; set_nz(D, false); NEXT;
+	op_5C: jump_long(fetch_long()); NEXT;
+	op_5D: load_a(A ^ load_m(absolute_x())); NEXT;
+	op_5E: modify(absolute_x(), &cpu_tracer::shift_right); NEXT;
+	op_5F: load_a(A ^ load_m(long_x())); NEXT;
+	op_60: PC = pull_word() + 1; NEXT;
+	op_61: add(load_m(direct_x_indirect())); NEXT;
+	op_62: push_relative(); NEXT;
+	op_63: add(load_m(stack())); NEXT;
+	op_64: store_m(direct(), 0); NEXT;
+	op_65: add(load_m(direct())); NEXT;
+	op_66: modify(direct(), &cpu_tracer::rotate_right); NEXT;
+	op_67: add(load_m(direct_indirect_long())); NEXT;
+	op_68: load_a(pull_m()); NEXT;
+	op_69: add(load_m(immediate_m())); NEXT;
+	op_6A: load_a(rotate_right(A)); NEXT;
+	op_6B: PC = pull_word() + 1; PB = pull(); NEXT;
+	op_6C: PC = read_word(fetch_word(), 0xFFFF); mark_label(); NEXT;
+	op_6D: add(load_m(absolute())); NEXT;
+	op_6E: modify(absolute(), &cpu_tracer::rotate_right); NEXT;
+	op_6F: add(load_m(long_address())); NEXT;
+	op_70: branch(P & V_FLAG); NEXT;
+	op_71: add(load_m(direct_indirect_y())); NEXT;
+	op_72: add(load_m(direct_indirect())); NEXT;
+	op_73: add(load_m(stack_indirect_y())); NEXT;
+	op_74: store_m(direct_x(), 0); NEXT;
+	op_75: add(load_m(direct_x())); NEXT;
+	op_76: modify(direct_x(), &cpu_tracer::rotate_right); NEXT;
+	op_77: add(load_m(direct_indirect_long_y())); NEXT;
+	op_78: P |= I_FLAG; NEXT;
+	op_79: add(load_m(absolute_y())); NEXT;
+	op_7A: Y = load_index(pull_x()); NEXT;
+	op_7B: A = D; set_nz(A, false); NEXT;
+	op_7C: PC = read_word(PB << 16 | ((fetch_word() + X) & 0xFFFF), 0xFFFF); mark_label(); NEXT;
+	op_7D: add(load_m(absolute_x())); NEXT;
+	op_7E: modify(absolute_x(), &cpu_tracer::rotate_right); NEXT;
+	op_7F: add(load_m(long_x())); NEXT;
+	op_80: branch(true); NEXT;
+	op_81: store_m(direct_x_indirect(), A); NEXT;
+	op_82: branch_long(); NEXT;
+	op_83: store_m(stack(), A); NEXT;
+	op_84: store_x(direct(), Y); NEXT;
+	op_85: store_m(direct(), A); NEXT;
+	op_86: store_x(direct(), X); NEXT;
+	op_87: store_m(direct_indirect_long(), A); NEXT;
+	op_88: Y = load_index(Y - 1); NEXT;
+	op_89: immediate_bits(load_m(immediate_m())); NEXT;
+	op_8A: load_a(X); NEXT;
+	op_8B: push(DB); NEXT;
+	op_8C: store_x(absolute(), Y); NEXT;
+	op_8D: store_m(absolute(), A); NEXT;
+	op_8E: store_x(absolute(), X); NEXT;
+	op_8F: store_m(long_address(), A); NEXT;
+	op_90: branch(!(P & C_FLAG)); NEXT;
+	op_91: store_m(direct_indirect_y(), A); NEXT;
+	op_92: store_m(direct_indirect(), A); NEXT;
+	op_93: store_m(stack_indirect_y(), A); NEXT;
+	op_94: store_x(direct_x(), Y); NEXT;
+	op_95: store_m(direct_x(), A); NEXT;
+	op_96: store_x(direct_y(), X); NEXT;
+	op_97: store_m(direct_indirect_long_y(), A); NEXT;
+	op_98: load_a(Y); NEXT;
+	op_99: store_m(absolute_y(), A); NEXT;
+	op_9A: S = E ? 0x0100 | (X & 0xFF) : X; NEXT;
+	op_9B: Y = load_index(X); NEXT;
+	op_9C: store_m(absolute(), 0); NEXT;
+	op_9D: store_m(absolute_x(), A); NEXT;
+	op_9E: store_m(absolute_x(), 0); NEXT;
+	op_9F: store_m(long_x(), A); NEXT;
+	op_A0: Y = load_index(load_x(immediate_x())); NEXT;
+	op_A1: load_a(load_m(direct_x_indirect())); NEXT;
+	op_A2: X = load_index(load_x(immediate_x())); NEXT;
+	op_A3: load_a(load_m(stack())); NEXT;
+	op_A4: Y = load_index(load_x(direct())); NEXT;
+	op_A5: load_a(load_m(direct())); NEXT;
+	op_A6: X = load_index(load_x(direct())); NEXT;
+	op_A7: load_a(load_m(direct_indirect_long())); NEXT;
+	op_A8: Y = load_index(A); NEXT;
+	op_A9: load_a(load_m(immediate_m())); NEXT;
+	op_AA: X = load_index(A); NEXT;
+	op_AB: DB = pull(); set_nz(DB, true); NEXT;
+	op_AC: Y = load_index(load_x(absolute())); NEXT;
+	op_AD: load_a(load_m(absolute())); NEXT;
+	op_AE: X = load_index(load_x(absolute())); NEXT;
+	op_AF: load_a(load_m(long_address())); NEXT;
+	op_B0: branch(P & C_FLAG); NEXT;
+	op_B1: load_a(load_m(direct_indirect_y())); NEXT;
+	op_B2: load_a(load_m(direct_indirect())); NEXT;
+	op_B3: load_a(load_m(stack_indirect_y())); NEXT;
+	op_B4: Y = load_index(load_x(direct_x())); NEXT;
+	op_B5: load_a(load_m(direct_x())); NEXT;
+	op_B6: X = load_index(load_x(direct_y())); NEXT;
+	op_B7: load_a(load_m(direct_indirect_long_y())); NEXT;
+	op_B8: P &= ~V_FLAG; NEXT;
+	op_B9: load_a(load_m(absolute_y())); NEXT;
+	op_BA: X = load_index(S); NEXT;
+	op_BB: X = load_index(Y); NEXT;
+	op_BC: Y = load_index(load_x(absolute_x())); NEXT;
+	op_BD: load_a(load_m(absolute_x())); NEXT;
+	op_BE: X = load_index(load_x(absolute_y())); NEXT;
+	op_BF: load_a(load_m(long_x())); NEXT;
+	op_C0: compare(Y, load_x(immediate_x()), index_8()); NEXT;
+	op_C1: compare(A, load_m(direct_x_indirect()), memory_8()); NEXT;
+	op_C2: set_status(P & ~fetch()); NEXT;
+	op_C3: compare(A, load_m(stack()), memory_8()); NEXT;
+	op_C4: compare(Y, load_x(direct()), index_8()); NEXT;
+	op_C5: compare(A, load_m(direct()), memory_8()); NEXT;
+	op_C6: modify(direct(), &cpu_tracer::decrement); NEXT;
+	op_C7: compare(A, load_m(direct_indirect_long()), memory_8()); NEXT;
+	op_C8: Y = load_index(Y + 1); NEXT;
+	op_C9: compare(A, load_m(immediate_m()), memory_8()); NEXT;
+	op_CA: X = load_index(X - 1); NEXT;
+	op_CB: nmi_countdown = 1; NEXT;
+	op_CC: compare(Y, load_x(absolute()), index_8()); NEXT;
+	op_CD: compare(A, load_m(absolute()), memory_8()); NEXT;
+	op_CE: modify(absolute(), &cpu_tracer::decrement); NEXT;
+	op_CF: compare(A, load_m(long_address()), memory_8()); NEXT;
+	op_D0: branch(!(P & Z_FLAG)); NEXT;
+	op_D1: compare(A, load_m(direct_indirect_y()), memory_8()); NEXT;
+	op_D2: compare(A, load_m(direct_indirect()), memory_8()); NEXT;
+	op_D3: compare(A, load_m(stack_indirect_y()), memory_8()); NEXT;
+	op_D4: push_word(read_word(direct(), 0xFFFF)); NEXT;
+	op_D5: compare(A, load_m(direct_x()), memory_8()); NEXT;
+	op_D6: modify(direct_x(), &cpu_tracer::decrement); NEXT;
+	op_D7: compare(A, load_m(direct_indirect_long_y()), memory_8()); NEXT;
+	op_D8: P &= ~D_FLAG; NEXT;
+	op_D9: compare(A, load_m(absolute_y()), memory_8()); NEXT;
+	op_DA: push_x(X); NEXT;
+	op_DB: stopped = true; NEXT;
+	op_DC: jump_long(read_long(fetch_word(), 0xFFFF)); NEXT;
+	op_DD: compare(A, load_m(absolute_x()), memory_8()); NEXT;
+	op_DE: modify(absolute_x(), &cpu_tracer::decrement); NEXT;
+	op_DF: compare(A, load_m(long_x()), memory_8()); NEXT;
+	op_E0: compare(X, load_x(immediate_x()), index_8()); NEXT;
+	op_E1: subtract(load_m(direct_x_indirect())); NEXT;
+	op_E2: set_status(P | fetch()); NEXT;
+	op_E3: subtract(load_m(stack())); NEXT;
+	op_E4: compare(X, load_x(direct()), index_8()); NEXT;
+	op_E5: subtract(load_m(direct())); NEXT;
+	op_E6: modify(direct(), &cpu_tracer::increment); NEXT;
+	op_E7: subtract(load_m(direct_indirect_long())); NEXT;
+	op_E8: X = load_index(X + 1); NEXT;
+	op_E9: subtract(load_m(immediate_m())); NEXT;
+	op_EA: NEXT;
+	op_EB: A = A >> 8 | A << 8; set_nz(A & 0xFF, true); NEXT;
+	op_EC: compare(X, load_x(absolute()), index_8()); NEXT;
+	op_ED: subtract(load_m(absolute())); NEXT;
+	op_EE: modify(absolute(), &cpu_tracer::increment); NEXT;
+	op_EF: subtract(load_m(long_address())); NEXT;
+	op_F0: branch(P & Z_FLAG); NEXT;
+	op_F1: subtract(load_m(direct_indirect_y())); NEXT;
+	op_F2: subtract(load_m(direct_indirect())); NEXT;
+	op_F3: subtract(load_m(stack_indirect_y())); NEXT;
+	op_F4: push_word(fetch_word()); NEXT;
+	op_F5: subtract(load_m(direct_x())); NEXT;
+	op_F6: modify(direct_x(), &cpu_tracer::increment); NEXT;
+	op_F7: subtract(load_m(direct_indirect_long_y())); NEXT;
+	op_F8: P |= D_FLAG; NEXT;
+	op_F9: subtract(load_m(absolute_y())); NEXT;
+	op_FA: X = load_index(pull_x()); NEXT;
+	op_FB: exchange_carry(); NEXT;
+	op_FC: call(read_word(PB << 16 | ((fetch_word() + X) & 0xFFFF), 0xFFFF)); NEXT;
+	op_FD: subtract(load_m(absolute_x())); NEXT;
+	op_FE: modify(absolute_x(), &cpu_tracer::increment); NEXT;
+	op_FF: subtract(load_m(long_x())); NEXT;
+	
+	#undef NEXT
+}
@@ -0,0 +1,150 @@
+#ifndef CPU_TRACER_H
+#define CPU_TRACER_H
+
+#include <QByteArray>
+
+#include "rom_buffer.h"
+#include "analysis/code_map.h"
+
+//A bare 65c816 that runs the ROM from its reset vector to see the register sizes code really runs with.
+//Only ROM, work RAM and SRAM exist, hardware registers answer just enough to get past the usual wait loops.
+class cpu_tracer
+{
+	public:
+		static const int default_steps = 4000000;
+		
+		explicit cpu_tracer(const ROM_buffer *b);
+		void reset();
+		int run(int steps);
+		bool is_stopped() const { return stopped; }
+		code_map get_map() const { return code_map(trace); }
+		
+	private:
+		enum status_flags{
+			C_FLAG = 0x01,
+			Z_FLAG = 0x02,
+			I_FLAG = 0x04,
+			D_FLAG = 0x08,
+			X_FLAG = 0x10,
+			M_FLAG = 0x20,
+			V_FLAG = 0x40,
+			N_FLAG = 0x80
+		};
+		
+		static const int page_bits = 12;
+		static const int page_mask = (1 << page_bits) - 1;
+		static const int page_count = 1 << (24 - page_bits);
+		static const int nmi_interval = 60000; //roughly the instructions in one frame
+		
+		const ROM_buffer *buffer;
+		int rom_size;
+		QByteArray trace;
+		QByteArray wram;
+		QByteArray sram;
+		unsigned char *trace_data;
+		const unsigned char *read_pages[page_count];
+		unsigned char *write_pages[page_count];
+		int rom_pages[page_count];
+		
+		unsigned short A, X, Y, S, D, PC;
+		unsigned char DB, PB, P;
+		bool E;
+		bool stopped;
+		int nmi_countdown;
+		
+		unsigned char apu_ports[4];
+		unsigned char dma[0x80];
+		unsigned char nmi_enable;
+		unsigned char nmi_flag;
+		unsigned char blank_flags;
+		unsigned char multiplicand;
+		unsigned short dividend;
+		unsigned char math[4];
+		int wram_address;
+		
+		void map_pages();
+		unsigned char read(int address);
+		void write(int address, unsigned char value);
+		unsigned char read_io(int address);
+		void write_io(int address, unsigned char value);
+		void run_dma(unsigned char channels);
+		
+		void record(int address, unsigned char op);
+		void mark_label();
+		
+		bool memory_8() const { return P & M_FLAG; }
+		bool index_8() const { return P & X_FLAG; }
+		void set_flag(unsigned char flag, bool state){ P = state ? P | flag : P & ~flag; }
+		void set_nz(int value, bool eight);
+		void set_status(unsigned char status);
+		void exchange_carry();
+		
+		unsigned char fetch();
+		unsigned short fetch_word();
+		int fetch_long();
+		unsigned short read_word(int address, int wrap);
+		int read_long(int address, int wrap);
+		
+		int immediate_8();
+		int immediate_m();
+		int immediate_x();
+		int direct();
+		int direct_x();
+		int direct_y();
+		int direct_indirect();
+		int direct_x_indirect();
+		int direct_indirect_y();
+		int direct_indirect_long();
+		int direct_indirect_long_y();
+		int stack();
+		int stack_indirect_y();
+		int absolute();
+		int absolute_x();
+		int absolute_y();
+		int long_address();
+		int long_x();
+		
+		unsigned short load_m(int address);
+		unsigned short load_x(int address);
+		void store_m(int address, unsigned short value);
+		void store_x(int address, unsigned short value);
+		void load_a(unsigned short value);
+		unsigned short load_index(int value);
+		
+		void push(unsigned char value);
+		unsigned char pull();
+		void push_word(unsigned short value);
+		unsigned short pull_word();
+		void push_m(unsigned short value);
+		unsigned short pull_m();
+		void push_x(unsigned short value);
+		unsigned short pull_x();
+		void push_relative();
+		
+		int decimal_add(int a, int value, int digits, bool subtract) const;
+		void add(int value);
+		void subtract(int value);
+		void compare(int reg, int value, bool eight);
+		void test_bits(unsigned short value);
+		void immediate_bits(unsigned short value);
+		void test_set(int address);
+		void test_reset(int address);
+		unsigned short shift_left(unsigned short value);
+		unsigned short shift_right(unsigned short value);
+		unsigned short rotate_left(unsigned short value);
+		unsigned short rotate_right(unsigned short value);
+		unsigned short increment(unsigned short value);
+		unsigned short decrement(unsigned short value);
+		void modify(int address, unsigned short (cpu_tracer::*operation)(unsigned short));
+		
+		void branch(bool taken);
+		void branch_long();
+		void jump_long(int address);
+		void call(unsigned short target);
+		void call_long();
+		void interrupt(unsigned short vector);
+		void return_interrupt();
+		void block_move(int step);
+};
+
+#endif // CPU_TRACER_H
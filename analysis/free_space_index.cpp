@@ -0,0 +1,177 @@
+#include <QtEndian>
+#include <algorithm>
+
+#include "free_space_index.h"
+#include "analysis_cache.h"
+#include "rom_buffer.h"
+#include "utility.h"
+#include "debug.h"
+
+void free_space_index::build(const ROM_buffer *buffer)
+{
+	rom_size = buffer->size();
+	claims.clear();
+	fills.clear();
+	for(int page = 0; page < rom_size; page += analysis_cache::bank_size){
+		scan(buffer, page, qMin(page + analysis_cache::bank_size, rom_size), fills);
+	}
+	collect(buffer);
+}
+
+//Only the pages holding start to end are scanned again, RATS tags are subtracted anew every time
+void free_space_index::update(const ROM_buffer *buffer, int start, int end)
+{
+	if(!rom_size){
+		return;
+	}
+	if(buffer->size() != rom_size){
+		build(buffer);
+		return;
+	}
+	const int page_size = analysis_cache::bank_size;
+	int first = qMax(start, 0) / page_size * page_size;
+	int last = qMin((qMax(end, start + 1) - 1) / page_size * page_size + page_size, rom_size);
+	QVector<run> kept;
+	kept.reserve(fills.size());
+	int fill = 0;
+	for(; fill < fills.size() && fills[fill].start < first; fill++){
+		kept.append(fills[fill]);
+	}
+	for(int page = first; page < last; page += page_size){
+		scan(buffer, page, qMin(page + page_size, last), kept);
+	}
+	for(; fill < fills.size(); fill++){
+		if(fills[fill].start >= last){
+			kept.append(fills[fill]);
+		}
+	}
+	fills = kept;
+	collect(buffer);
+}
+
+//First fit by offset among the runs whose bank, as pc_to_snes reports it, is in range
+int free_space_index::find(const ROM_buffer *buffer, int length, int first_bank, int last_bank) const
+{
+	for(const run &free : runs){
+		int bank = buffer->pc_to_snes(free.start) >> 16;
+		if(free.size() >= length && bank >= first_bank && bank <= last_bank){
+			return free.start;
+		}
+	}
+	return -1;
+}
+
+//Claimed space stays out of the free list until the ROM is resized
+void free_space_index::claim(int start, int end)
+{
+	run claimed = {start, end};
+	auto position = std::lower_bound(claims.begin(), claims.end(), claimed, [](const run &a, const run &b){
+		return a.start < b.start;
+	});
+	claims.insert(position, claimed);
+	subtract(runs, {claimed});
+}
+
+int free_space_index::total() const
+{
+	int total = 0;
+	for(const run &free : runs){
+		total += free.size();
+	}
+	return total;
+}
+
+static inline bool has_zero_byte(quint64 word)
+{
+	return (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+
+//Words holding neither fill byte are skipped eight bytes at a time, runs are then extended a word at a time.
+//Short runs are kept when they touch the page edges, they may continue in the next page.
+void free_space_index::scan(const ROM_buffer *buffer, int start, int end, QVector<run> &found) const
+{
+	const uchar *data = (const uchar *)buffer->data();
+	int i = start;
+	while(i < end){
+		while(i + 8 <= end){
+			quint64 word = qFromLittleEndian<quint64>(data + i);
+			if(has_zero_byte(word) || has_zero_byte(~word)){
+				break;
+			}
+			i += 8;
+		}
+		if(i >= end){
+			break;
+		}
+		uchar fill = data[i];
+		if(fill != 0x00 && fill != 0xFF){
+			i++;
+			continue;
+		}
+		int run_start = i++;
+		quint64 repeated = fill ? ~0ULL : 0;
+		while(i + 8 <= end && qFromLittleEndian<quint64>(data + i) == repeated){
+			i += 8;
+		}
+		while(i < end && data[i] == fill){
+			i++;
+		}
+		if(i - run_start >= minimum_free || run_start == start || i == end){
+			found.append({run_start, i});
+		}
+	}
+}
+
+//Joins runs of the same fill byte that meet inside one SNES bank, then drops what is too short or protected
+void free_space_index::collect(const ROM_buffer *buffer)
+{
+	const char *data = buffer->data();
+	runs.clear();
+	for(const run &fill : fills){
+		int address = buffer->pc_to_snes(fill.start);
+		if(!runs.isEmpty() && runs.last().end == fill.start && data[fill.start] == data[fill.start - 1] &&
+		   address & 0xFFFF && address == buffer->pc_to_snes(fill.start - 1) + 1){
+			runs.last().end = fill.end;
+			continue;
+		}
+		if(!runs.isEmpty() && runs.last().size() < minimum_free){
+			runs.removeLast();
+		}
+		runs.append(fill);
+	}
+	if(!runs.isEmpty() && runs.last().size() < minimum_free){
+		runs.removeLast();
+	}
+	
+	QVector<run> protect = claims;
+	QByteArray bytes = QByteArray::fromRawData(data, rom_size);
+	for(int tag : buffer->get_rats_tags()){
+		int length = read_word(bytes, tag + 4) + 1;
+		protect.append({tag, qMin(tag + 8 + length, rom_size)});
+	}
+	std::sort(protect.begin(), protect.end(), [](const run &a, const run &b){ return a.start < b.start; });
+	subtract(runs, protect);
+}
+
+//Both lists are sorted, what remains of a run is only kept while it is still long enough
+void free_space_index::subtract(QVector<run> &from, QVector<run> taken)
+{
+	QVector<run> result;
+	result.reserve(from.size());
+	int next = 0;
+	for(run free : from){
+		while(next < taken.size() && taken[next].end <= free.start){
+			next++;
+		}
+		for(int i = next; i < taken.size() && taken[i].start < free.end; i++){
+			if(taken[i].start - free.start >= minimum_free){
+				result.append({free.start, taken[i].start});
+			}
+			free.start = qMax(free.start, taken[i].end);
+		}
+		if(free.size() >= minimum_free){
+			result.append(free);
+		}
+	}
+	from = result;
+}
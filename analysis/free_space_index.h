@@ -0,0 +1,40 @@
+#ifndef FREE_SPACE_INDEX_H
+#define FREE_SPACE_INDEX_H
+
+#include <QVector>
+
+class ROM_buffer;
+
+//Runs of 0x00 or 0xFF nothing has claimed, split where the SNES bank changes and sorted by ROM offset.
+//The fill runs are kept per 32KB page so an edit only rescans the pages it touched, nothing is kept before the first build.
+class free_space_index
+{
+	public:
+		struct run{
+			int start;
+			int end;
+			int size() const { return end - start; }
+		};
+		
+		void build(const ROM_buffer *buffer);
+		void update(const ROM_buffer *buffer, int start, int end);
+		bool is_built() const { return rom_size; }
+		int find(const ROM_buffer *buffer, int length, int first_bank = 0x00, int last_bank = 0xFF) const;
+		void claim(int start, int end);
+		const QVector<run> &get_runs() const { return runs; }
+		int total() const;
+		
+	private:
+		static const int minimum_free = 32;
+		
+		QVector<run> fills;
+		QVector<run> claims;
+		QVector<run> runs;
+		int rom_size = 0;
+		
+		void scan(const ROM_buffer *buffer, int start, int end, QVector<run> &found) const;
+		void collect(const ROM_buffer *buffer);
+		static void subtract(QVector<run> &from, QVector<run> taken);
+};
+
+#endif // FREE_SPACE_INDEX_H
@@ -0,0 +1,156 @@
+#include "gsu_analyzer.h"
+#include "disassembly_cores/isa_gsu.h"
+#include "disassembly_cores/isa_65c816.h"
+#include "debug.h"
+
+gsu_analyzer::gsu_analyzer(const ROM_buffer *b) : buffer(b)
+{
+}
+
+void gsu_analyzer::add_entry(int address, int alt)
+{
+	int offset = buffer->snes_to_pc(address);
+	if(offset < 0 || offset >= buffer->size()){
+		return;
+	}
+	entries.append({offset, alt});
+}
+
+//Follows immediate loads into the stores that set PBR and R15, every write to the high byte of R15
+//starts the GSU at whatever the pair holds at that point
+void gsu_analyzer::add_starts(const code_map &cpu_map)
+{
+	int values[3] = {0, 0, 0}; //A, X, Y
+	int program_bank = 0;
+	int program_counter = 0;
+	for(int offset = 0; offset < cpu_map.size(); offset++){
+		unsigned char state = cpu_map.at(offset);
+		if(!(state & code_map::OPCODE)){
+			continue;
+		}
+		unsigned char op = buffer->at(offset);
+		int size = isa_65c816::operand_size(op, state & code_map::A_16, state & code_map::I_16);
+		int value = operand(offset + 1, size);
+		bool wide = false;
+		int source = -1;
+		switch(op){
+			case 0xA9: values[0] = value; continue; //LDA #
+			case 0xA2: values[1] = value; continue; //LDX #
+			case 0xA0: values[2] = value; continue; //LDY #
+			case 0x8D: case 0x8F: source = 0; wide = state & code_map::A_16; break; //STA
+			case 0x8E: source = 1; wide = state & code_map::I_16; break; //STX
+			case 0x8C: source = 2; wide = state & code_map::I_16; break; //STY
+			case 0x9C: wide = state & code_map::A_16; break; //STZ
+			default: continue;
+		}
+		
+		//Registers are mirrored in every bank the SNES maps them in
+		int address = value & 0xFFFF;
+		if(size == 3 && (value & 0x400000)){
+			continue;
+		}
+		value = source == -1 ? 0 : values[source];
+		for(int i = 0; i < (wide ? 2 : 1); i++, address++, value >>= 8){
+			switch(address){
+				case PBR:
+					program_bank = value & 0xFF;
+				break;
+				case R15_LOW:
+					program_counter = (program_counter & 0xFF00) | (value & 0xFF);
+				break;
+				case R15_HIGH:
+					program_counter = (program_counter & 0x00FF) | (value & 0xFF) << 8;
+					add_entry(program_bank << 16 | program_counter);
+				break;
+			}
+		}
+	}
+}
+
+code_map gsu_analyzer::run()
+{
+	map.fill(0, buffer->size());
+	QVector<entry> pending = entries;
+	for(const auto &e : entries){
+		map[e.offset] = map.at(e.offset) | code_map::ENTRY;
+	}
+	while(!pending.isEmpty()){
+		trace(pending.takeLast(), pending);
+	}
+	return code_map(map);
+}
+
+//Branches and jumps take effect after the instruction behind them, that delay slot runs on both
+//paths and any ALT prefix in it carries over to the branch target
+void gsu_analyzer::trace(entry start, QVector<entry> &pending)
+{
+	int offset = start.offset;
+	int alt = start.alt;
+	int size = buffer->size();
+	int target = -1;
+	bool stop_after_slot = false;
+	bool in_slot = false;
+	bool linked = false;
+	
+	while(offset >= 0 && offset < size){
+		int address = buffer->pc_to_snes(offset);
+		if(address < 0 || map.at(offset) & code_map::OPCODE){
+			return;
+		}
+		unsigned char op = buffer->at(offset);
+		const disassembler_core::opcode &instruction = isa_gsu::opcode_list[alt][op];
+		int length = isa_gsu::operand_size(op, alt) + 1;
+		if(offset + length > size){
+			return;
+		}
+		map[offset] = map.at(offset) | code_map::OPCODE | code_map::alt_flags(alt);
+		for(int i = 1; i < length; i++){
+			map[offset + i] = map.at(offset + i) | code_map::OPERAND;
+		}
+		
+		int next_alt = instruction.mode == isa_gsu::ALTERNATE ? op - 0x3C :
+		               instruction.mode == isa_gsu::PREFIX ? alt : 0;
+		if(in_slot){
+			if(target != -1){
+				int target_offset = buffer->snes_to_pc(target);
+				if(target_offset >= 0 && target_offset < size){
+					map[target_offset] = map.at(target_offset) | code_map::LABEL;
+					pending.append({target_offset, next_alt});
+				}
+			}
+			if(stop_after_slot){
+				return;
+			}
+			in_slot = false;
+			target = -1;
+		}else if(instruction.mode == isa_gsu::RELATIVE){
+			target = (address & 0xFF0000) | ((address + 2 + (char)operand(offset + 1, 1)) & 0xFFFF);
+			stop_after_slot = instruction.mnemonic == isa_gsu::BRA;
+			in_slot = true;
+		}else if(instruction.mnemonic == isa_gsu::IWT && (op & 0x0F) == 15){
+			//IWT R15 is a jump, or a call when LINK set up the return address just before
+			target = (address & 0xFF0000) | operand(offset + 1, 2);
+			stop_after_slot = !linked;
+			in_slot = true;
+		}else if(instruction.mnemonic == isa_gsu::JMP || instruction.mnemonic == isa_gsu::LJMP || 
+		         instruction.mnemonic == isa_gsu::STOP){
+			stop_after_slot = true;
+			in_slot = true;
+		}
+		linked = instruction.mnemonic == isa_gsu::LINK;
+		alt = next_alt;
+		offset += length;
+		if((buffer->pc_to_snes(offset) & 0xFF0000) != (address & 0xFF0000)){
+			return;
+		}
+	}
+}
+
+int gsu_analyzer::operand(int offset, int size) const
+{
+	int value = 0;
+	for(int i = 0; i < size && offset + i < buffer->size(); i++){
+		value |= (unsigned char)buffer->at(offset + i) << (i * 8);
+	}
+	return value;
+}
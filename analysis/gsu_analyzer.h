@@ -0,0 +1,39 @@
+#ifndef GSU_ANALYZER_H
+#define GSU_ANALYZER_H
+
+#include <QVector>
+
+#include "rom_buffer.h"
+#include "analysis/code_map.h"
+
+//Traces SuperFX code from the places the 65c816 code starts the GSU
+class gsu_analyzer
+{
+	public:
+		explicit gsu_analyzer(const ROM_buffer *b);
+		void add_entry(int address, int alt = 0);
+		void add_starts(const code_map &cpu_map);
+		code_map run();
+		
+	private:
+		struct entry{
+			int offset;
+			int alt;
+		};
+		
+		//SNES side registers, R15 is the GSU program counter and starts it when its high byte is written
+		enum registers{
+			R15_LOW = 0x301E,
+			R15_HIGH = 0x301F,
+			PBR = 0x3034
+		};
+		
+		const ROM_buffer *buffer;
+		QVector<entry> entries;
+		QByteArray map;
+		
+		void trace(entry start, QVector<entry> &pending);
+		int operand(int offset, int size) const;
+};
+
+#endif // GSU_ANALYZER_H
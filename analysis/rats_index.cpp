@@ -0,0 +1,68 @@
+#include <QtEndian>
+#include <QtAlgorithms>
+
+#include "rats_index.h"
+#include "rom_buffer.h"
+#include "debug.h"
+
+void rats_index::build(const ROM_buffer *buffer)
+{
+	size = buffer->size();
+	tags.clear();
+	scan(buffer, 0, size, tags);
+}
+
+//A tag may start up to seven bytes before the edit and still cover it
+void rats_index::update(const ROM_buffer *buffer, int start, int end)
+{
+	if(buffer->size() != size){
+		build(buffer);
+		return;
+	}
+	start = qMax(0, start - (tag_size - 1));
+	auto first = std::lower_bound(tags.begin(), tags.end(), start);
+	auto last = std::lower_bound(first, tags.end(), end);
+	int position = first - tags.begin();
+	tags.remove(position, last - first);
+	
+	QVector<int> found;
+	scan(buffer, start, end, found);
+	for(int i = 0; i < found.size(); i++){
+		tags.insert(position + i, found.at(i));
+	}
+}
+
+static inline quint64 zero_bytes(quint64 word)
+{
+	return (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+
+//Eight bytes are compared against 'S' at once, only the lanes that match get the full four byte compare.
+//A tag is only kept if its size is followed by its complement.
+void rats_index::scan(const ROM_buffer *buffer, int start, int end, QVector<int> &found)
+{
+	const uchar *data = (const uchar *)buffer->data();
+	int last = qMin(end, buffer->size() - tag_size + 1);
+	const quint32 star = qFromLittleEndian<quint32>((const uchar *)"STAR");
+	auto check = [&](int offset){
+		if(qFromLittleEndian<quint32>(data + offset) != star){
+			return;
+		}
+		quint32 length = qFromLittleEndian<quint32>(data + offset + 4);
+		if(((length ^ (length >> 16)) & 0xFFFF) == 0xFFFF){
+			found.append(offset);
+		}
+	};
+	
+	int offset = start;
+	for(; offset + 8 <= last; offset += 8){
+		quint64 matches = zero_bytes(qFromLittleEndian<quint64>(data + offset) ^ 0x5353535353535353ULL);
+		while(matches){
+			check(offset + (qCountTrailingZeroBits(matches) >> 3));
+			matches &= matches - 1;
+		}
+	}
+	for(; offset < last; offset++){
+		check(offset);
+	}
+}
@@ -0,0 +1,28 @@
+#ifndef RATS_INDEX_H
+#define RATS_INDEX_H
+
+#include <QVector>
+#include <algorithm>
+
+class ROM_buffer;
+
+//Offsets of every RATS tag, sorted so a lookup is a binary search. Edits only rescan the bytes around them.
+class rats_index
+{
+	public:
+		static const int tag_size = 8;
+		
+		void build(const ROM_buffer *buffer);
+		void update(const ROM_buffer *buffer, int start, int end);
+		bool contains(int offset) const { return std::binary_search(tags.begin(), tags.end(), offset); }
+		const QVector<int> &get_tags() const { return tags; }
+		int rom_size() const { return size; }
+		
+	private:
+		QVector<int> tags;
+		int size = 0;
+		
+		static void scan(const ROM_buffer *buffer, int start, int end, QVector<int> &found);
+};
+
+#endif // RATS_INDEX_H
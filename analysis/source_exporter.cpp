@@ -0,0 +1,318 @@
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include "source_exporter.h"
+#include "analysis_cache.h"
+#include "code_analyzer.h"
+#include "work_queue.h"
+#include "disassembly_cores/isa_65c816.h"
+#include "debug.h"
+
+source_exporter::source_exporter(const ROM_buffer *b) : buffer(b)
+{
+}
+
+//Banks are written in parallel, each one only depends on the ROM so the output is always the same
+bool source_exporter::write(const QString &directory, int thread_count)
+{
+	if(!QDir().mkpath(directory)){
+		error = "Could not create " + directory;
+		return false;
+	}
+	find_banks();
+	find_tables();
+	find_labels();
+	
+	thread_count = qMax(thread_count, 1);
+	work_queue<int> queue(thread_count);
+	for(int i = 0; i < banks.size(); i++){
+		queue.push(i % thread_count, i);
+	}
+	std::atomic<bool> failed(false);
+	queue.run([this, &directory, &failed](int worker, const int &index){
+		Q_UNUSED(worker);
+		if(!write_bank(directory + '/' + bank_file(banks[index], buffer), banks[index])){
+			failed = true;
+		}
+	});
+	
+	if(failed || !write_main(directory + "/main.asm")){
+		error = "Could not write the source files to " + directory;
+		return false;
+	}
+	return true;
+}
+
+//Neighbouring chunks that continue the same SNES bank are written to the same file
+void source_exporter::find_banks()
+{
+	banks.clear();
+	for(int offset = 0; offset < buffer->size(); offset += analysis_cache::bank_size){
+		int address = buffer->pc_to_snes(offset);
+		int end = qMin(offset + analysis_cache::bank_size, buffer->size());
+		if(address < 0){
+			continue;
+		}
+		if(!banks.isEmpty()){
+			bank &last = banks.last();
+			int last_address = buffer->pc_to_snes(last.start);
+			if(last.end == offset && last_address + offset - last.start == address &&
+			   (last_address & 0xFF0000) == (address & 0xFF0000)){
+				last.end = end;
+				continue;
+			}
+		}
+		banks.append({offset, end});
+	}
+}
+
+void source_exporter::find_tables()
+{
+	tables.clear();
+	if(!buffer->get_bookmark_map()){
+		return;
+	}
+	for(const auto &bookmark : *buffer->get_bookmark_map()){
+		int width = (bookmark.data_type & bookmark_data::WORD) ? 2 :
+		            (bookmark.data_type & bookmark_data::LONG) ? 3 : 0;
+		int start = buffer->snes_to_pc(bookmark.address);
+		if(bookmark.data_type & bookmark_data::CODE || !bookmark.data_is_pointer || !width || start < 0){
+			continue;
+		}
+		tables.insert(start, {qMin(start + bookmark.size, buffer->size()), width, bookmark.address});
+	}
+}
+
+//Labels can only be placed where a line starts, anything else is written as a plain address
+void source_exporter::find_labels()
+{
+	labels = buffer->get_code_map().get_labels();
+	int first = labels.size();
+	for(auto t = tables.constBegin(); t != tables.constEnd(); t++){
+		for(int i = t.key(); i + t->width <= t->end; i += t->width){
+			int pointer = code_analyzer::read_operand(buffer, i, t->width);
+			labels.append(t->width == 2 ? (t->address & 0xFF0000) | pointer : pointer);
+		}
+	}
+	labels += buffer->get_symbols().range(0, symbol_table::SPC700);
+	buffer->translate_to_pc(labels.data() + first, labels.size() - first);
+	
+	labels.erase(std::remove_if(labels.begin(), labels.end(), 
+	                            [this](int offset){ return !can_label(offset); }), labels.end());
+	std::sort(labels.begin(), labels.end());
+	labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+}
+
+bool source_exporter::can_label(int offset) const
+{
+	const code_map &analysis = buffer->get_code_map();
+	if(offset < 0 || offset >= buffer->size() || buffer->pc_to_snes(offset) < 0){
+		return false;
+	}
+	auto t = tables.upperBound(offset);
+	if(t != tables.constBegin() && offset < (--t)->end){
+		return (offset - t.key()) % t->width == 0;
+	}
+	return analysis.is_opcode(offset) || !analysis.is_code(offset);
+}
+
+bool source_exporter::is_label(int offset) const
+{
+	return std::binary_search(labels.begin(), labels.end(), offset);
+}
+
+bool source_exporter::write_bank(const QString &path, const bank &b) const
+{
+	QFile file(path);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+		return false;
+	}
+	QByteArray output;
+	output.reserve(flush_size * 2);
+	output += "org $";
+	append_hex(buffer->pc_to_snes(b.start), 6, output);
+	output += "\n\n";
+	
+	const code_map &analysis = buffer->get_code_map();
+	auto t = tables.upperBound(b.start);
+	if(t != tables.constBegin() && std::prev(t)->end > b.start){
+		t--;
+	}
+	for(int offset = b.start; offset < b.end;){
+		if(is_label(offset)){
+			append_name(offset, output);
+			output += ":\n";
+		}
+		
+		while(t != tables.constEnd() && t->end <= offset){
+			t++;
+		}
+		if(t != tables.constEnd() && t.key() <= offset){
+			offset = write_table(offset, qMin(t->end, b.end), *t, output);
+		}else if(analysis.is_opcode(offset)){
+			offset = write_instruction(offset, b.end, output);
+		}else{
+			offset = write_data(offset, b.end, output);
+		}
+		
+		//Stream to disk as we go rather than holding the whole bank
+		if(output.size() >= flush_size){
+			if(file.write(output) != output.size()){
+				return false;
+			}
+			output.clear();
+		}
+	}
+	return file.write(output) == output.size();
+}
+
+bool source_exporter::write_main(const QString &path) const
+{
+	static const char *mapper_names[] = {
+		"lorom", "hirom", "exlorom", "exhirom", "sfxrom", "sa1rom", "hirom", "lorom"
+	};
+	QFile file(path);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+		return false;
+	}
+	QByteArray output = QByteArray(mapper_names[buffer->get_mapper()]) + "\n\n";
+	for(const auto &b : banks){
+		output += "incsrc \"" + bank_file(b, buffer).toLatin1() + "\"\n";
+	}
+	return file.write(output) == output.size();
+}
+
+int source_exporter::write_table(int offset, int end, const table &t, QByteArray &output) const
+{
+	if(offset + t.width > end){
+		return write_data(offset, end, output);
+	}
+	int pointer = code_analyzer::read_operand(buffer, offset, t.width);
+	output += t.width == 2 ? "\tdw " : "\tdl ";
+	append_label(t.width == 2 ? (t.address & 0xFF0000) | pointer : pointer, t.width * 2, output);
+	output += '\n';
+	return offset + t.width;
+}
+
+//Sizes are spelled out so asar assembles exactly the bytes that were read
+int source_exporter::write_instruction(int offset, int end, QByteArray &output) const
+{
+	const code_map &analysis = buffer->get_code_map();
+	unsigned char op = buffer->at(offset);
+	unsigned char state = analysis.at(offset);
+	int size = isa_65c816::operand_size(op, state & code_map::A_16, state & code_map::I_16);
+	if(offset + size >= end){
+		return write_data(offset, end, output);
+	}
+	for(int i = 1; i <= size; i++){
+		if(is_label(offset + i) || analysis.is_opcode(offset + i)){
+			return write_data(offset, offset + i, output);
+		}
+	}
+	
+	const disassembler_core::opcode &entry = isa_65c816::opcode_list[op];
+	const isa_65c816::mode_format &format = isa_65c816::mode_formats[entry.mode];
+	unsigned int operand = code_analyzer::read_operand(buffer, offset + 1, size);
+	int address = buffer->pc_to_snes(offset);
+	int bank = address & 0xFF0000;
+	
+	output += '\t';
+	output += isa_65c816::mnemonic_name(entry.mnemonic);
+	if(size && entry.mode != isa_65c816::IMMEDIATE_8 && entry.mode != isa_65c816::RELATIVE && 
+	   entry.mode != isa_65c816::RELATIVE_LONG && entry.mode != isa_65c816::BLOCK_MOVE){
+		output += size == 1 ? ".b" : size == 2 ? ".w" : ".l";
+	}
+	output += format.prefix;
+	switch(entry.mode){
+		case isa_65c816::RELATIVE:
+			append_label(bank | ((address + 2 + (char)operand) & 0xFFFF), 4, output);
+		break;
+		case isa_65c816::RELATIVE_LONG:
+			append_label(bank | ((address + 3 + (short)operand) & 0xFFFF), 4, output);
+		break;
+		case isa_65c816::ABSOLUTE_JUMP:
+		case isa_65c816::ABSOLUTE_INDIRECT:
+		case isa_65c816::ABSOLUTE_X_INDIRECT:
+		case isa_65c816::ABSOLUTE_INDIRECT_LONG:
+			append_label(bank | operand, 4, output);
+		break;
+		case isa_65c816::LONG_JUMP:
+			append_label(operand, 6, output);
+		break;
+		case isa_65c816::BLOCK_MOVE:
+			append_hex(operand >> 8, 2, output);
+			output += ",$";
+			append_hex(operand & 0xFF, 2, output);
+		break;
+		default:
+			if(size){
+				append_hex(operand, size * 2, output);
+			}
+		break;
+	}
+	output += format.suffix;
+	output += '\n';
+	return offset + size + 1;
+}
+
+//Always writes at least one byte, then stops at whatever else has to start its own line
+int source_exporter::write_data(int offset, int end, QByteArray &output) const
+{
+	const code_map &analysis = buffer->get_code_map();
+	output += "\tdb $";
+	append_hex((unsigned char)buffer->at(offset), 2, output);
+	int i = offset + 1;
+	for(; i < end && i - offset < bytes_per_line; i++){
+		if(is_label(i) || analysis.is_opcode(i) || tables.contains(i)){
+			break;
+		}
+		output += ",$";
+		append_hex((unsigned char)buffer->at(i), 2, output);
+	}
+	output += '\n';
+	return i;
+}
+
+void source_exporter::append_label(int address, int digits, QByteArray &output) const
+{
+	int offset = buffer->snes_to_pc(address);
+	if(is_label(offset)){
+		append_name(offset, output);
+		return;
+	}
+	output += '$';
+	append_hex(address, digits, output);
+}
+
+void source_exporter::append_name(int offset, QByteArray &output) const
+{
+	int address = buffer->pc_to_snes(offset);
+	const char *symbol = buffer->get_symbols().find(address);
+	if(symbol){
+		output += symbol;
+		return;
+	}
+	output += "label_";
+	append_hex(address, 6, output);
+}
+
+void source_exporter::append_hex(unsigned int value, int digits, QByteArray &output)
+{
+	static const char hex_digits[] = "0123456789ABCDEF";
+	for(int i = digits - 1; i >= 0; i--){
+		output += hex_digits[(value >> (i * 4)) & 0x0F];
+	}
+}
+
+QString source_exporter::bank_file(const bank &b, const ROM_buffer *buffer)
+{
+	int address = buffer->pc_to_snes(b.start);
+	QString name = "bank_" + QString::number(address >> 16, 16).rightJustified(2, '0').toUpper();
+	if(address & 0xFFFF){
+		name += '_' + QString::number(address & 0xFFFF, 16).rightJustified(4, '0').toUpper();
+	}
+	return name + ".asm";
+}
@@ -0,0 +1,56 @@
+#ifndef SOURCE_EXPORTER_H
+#define SOURCE_EXPORTER_H
+
+#include <QThread>
+#include <QString>
+#include <QVector>
+#include <QMap>
+
+#include "rom_buffer.h"
+
+//Writes the whole ROM as asar source, one file per bank plus a main file including them in order
+class source_exporter
+{
+	public:
+		explicit source_exporter(const ROM_buffer *b);
+		bool write(const QString &directory, int thread_count = QThread::idealThreadCount());
+		QString get_error() const { return error; }
+		
+	private:
+		struct bank{
+			int start;
+			int end;
+		};
+		
+		struct table{
+			int end;
+			int width;
+			int address;
+		};
+		
+		static const int bytes_per_line = 16;
+		static const int flush_size = 0x10000;
+		
+		const ROM_buffer *buffer;
+		QVector<bank> banks;
+		QVector<int> labels;
+		QMap<int, table> tables;
+		QString error;
+		
+		void find_banks();
+		void find_tables();
+		void find_labels();
+		bool can_label(int offset) const;
+		bool is_label(int offset) const;
+		bool write_bank(const QString &path, const bank &b) const;
+		bool write_main(const QString &path) const;
+		int write_table(int offset, int end, const table &t, QByteArray &output) const;
+		int write_instruction(int offset, int end, QByteArray &output) const;
+		int write_data(int offset, int end, QByteArray &output) const;
+		void append_label(int address, int digits, QByteArray &output) const;
+		void append_name(int offset, QByteArray &output) const;
+		static void append_hex(unsigned int value, int digits, QByteArray &output);
+		static QString bank_file(const bank &b, const ROM_buffer *buffer);
+};
+
+#endif // SOURCE_EXPORTER_H
@@ -0,0 +1,55 @@
+#include "spc_upload_scanner.h"
+#include "rom_buffer.h"
+#include "debug.h"
+
+//A found chain is skipped as a whole, so the ROM is walked once
+QVector<spc_upload_scanner::upload> spc_upload_scanner::scan(const ROM_buffer *buffer)
+{
+	QVector<upload> uploads;
+	const unsigned char *data = (const unsigned char *)buffer->data();
+	int size = buffer->size();
+	for(int offset = 0; offset + 4 <= size;){
+		upload result;
+		if(read_chain(data, size, offset, result)){
+			uploads.append(result);
+			offset = result.end;
+		}else{
+			offset++;
+		}
+	}
+	return uploads;
+}
+
+//The entry point has to land inside something that was uploaded, and outside the direct page and
+//stack, which keeps runs of padding from passing as uploads
+bool spc_upload_scanner::read_chain(const unsigned char *data, int size, int offset, upload &result)
+{
+	result = {offset, 0, 0, {}};
+	int total = 0;
+	for(int position = offset; position + 4 <= size;){
+		int length = data[position] | data[position + 1] << 8;
+		int destination = data[position + 2] | data[position + 3] << 8;
+		position += 4;
+		
+		if(!length){
+			if(total < minimum_size || destination < minimum_entry){
+				return false;
+			}
+			for(const auto &b : result.blocks){
+				if(destination >= b.destination && destination < b.destination + b.length){
+					result.entry = destination;
+					result.end = position;
+					return true;
+				}
+			}
+			return false;
+		}
+		if(destination < 2 || destination + length > 0x10000 || position + length > size){
+			return false;
+		}
+		result.blocks.append({position, length, destination});
+		total += length;
+		position += length;
+	}
+	return false;
+}
@@ -0,0 +1,35 @@
+#ifndef SPC_UPLOAD_SCANNER_H
+#define SPC_UPLOAD_SCANNER_H
+
+#include <QVector>
+
+class ROM_buffer;
+
+//Finds data sent through the IPL boot ROM, a chain of length/destination headers ending in a 
+//zero length block whose destination is where the uploaded code starts running
+class spc_upload_scanner
+{
+	public:
+		struct block{
+			int offset;
+			int length;
+			int destination;
+		};
+		
+		struct upload{
+			int offset;
+			int end;
+			int entry;
+			QVector<block> blocks;
+		};
+		
+		static QVector<upload> scan(const ROM_buffer *buffer);
+		
+	private:
+		static const int minimum_size = 64;
+		static const int minimum_entry = 0x0200;
+		
+		static bool read_chain(const unsigned char *data, int size, int offset, upload &result);
+};
+
+#endif // SPC_UPLOAD_SCANNER_H
@@ -0,0 +1,181 @@
+#include <cstring>
+#include <QFile>
+
+#include "trace_importer.h"
+#include "disassembly_cores/isa_65c816.h"
+
+static inline int hex_digit(char c)
+{
+	return c >= '0' && c <= '9' ? c - '0' :
+	       c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+	       c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+}
+
+trace_importer::trace_importer(const ROM_buffer *b) : buffer(b)
+{
+	flags.fill(0, buffer->size());
+	map = (unsigned char *)flags.data();
+}
+
+bool trace_importer::import_file(const QString &path)
+{
+	QFile file(path);
+	if(!file.open(QIODevice::ReadOnly)){
+		return false;
+	}
+	bool cdl = path.endsWith(".cdl", Qt::CaseInsensitive);
+	const char *position = (const char *)file.map(0, file.size());
+	if(position){
+		if(cdl){
+			return import_cdl(position, file.size());
+		}
+		import_log(position, position + file.size());
+		return true;
+	}
+	if(cdl){
+		QByteArray contents = file.readAll();
+		return import_cdl(contents.constData(), contents.size());
+	}
+	import_chunks(file);
+	return true;
+}
+
+//Without a mapping the log is read a chunk at a time, a line cut off at the end of a chunk starts the next one
+void trace_importer::import_chunks(QFile &file)
+{
+	QByteArray chunk;
+	while(true){
+		int carried = chunk.size();
+		chunk.resize(carried + chunk_size);
+		qint64 read = file.read(chunk.data() + carried, chunk_size);
+		chunk.resize(carried + qMax(read, (qint64)0));
+		if(read <= 0){
+			break;
+		}
+		int line_end = chunk.lastIndexOf('\n') + 1;
+		import_log(chunk.constData(), chunk.constData() + line_end);
+		chunk.remove(0, line_end);
+	}
+	import_log(chunk.constData(), chunk.constData() + chunk.size());
+}
+
+//One instruction per line, starting with its address as bbaaaa or bb:aaaa. The flags come from either
+//a P:hh field or a nvmxdizc string where upper case letters are set. Lines are expected whole, the
+//instruction before carries over from the previous call.
+void trace_importer::import_log(const char *position, const char *end)
+{
+	int size = flags.size();
+	while(position < end){
+		const char *line_end = (const char *)memchr(position, '\n', end - position);
+		line_end = line_end ? line_end : end;
+		const char *cursor = position;
+		position = line_end + 1;
+		
+		int address = parse_address(cursor, line_end);
+		if(address == -1){
+			continue;
+		}
+		lines++;
+		int offset = buffer->snes_to_pc(address);
+		if(offset < 0 || offset >= size){
+			expected = -1;
+			indirect = false;
+			continue;
+		}
+		
+		int state = parse_state(cursor, line_end);
+		if(expected != -1 && offset != expected){
+			map[offset] |= code_map::LABEL | (indirect ? code_map::INDIRECT : 0);
+		}
+		unsigned char op = buffer->at(offset);
+		indirect = op == 0x6C || op == 0x7C || op == 0xDC || op == 0xFC;
+		expected = mark_instruction(offset, state);
+		
+		//Mesen adds the effective address in brackets, anything in ROM it points at was read as data
+		const char *bracket = (const char *)memchr(cursor, '[', line_end - cursor);
+		if(bracket){
+			bracket++;
+			int data = parse_address(bracket, line_end);
+			data = data == -1 ? -1 : buffer->snes_to_pc(data);
+			if(data >= 0 && data < size){
+				map[data] |= code_map::DATA;
+			}
+		}
+	}
+}
+
+//Mesen logs code on every byte of an instruction, so instructions are rebuilt from the first byte of each run
+bool trace_importer::import_cdl(const char *position, qint64 size)
+{
+	int rom_size = flags.size();
+	if(size < rom_size){
+		return false;
+	}
+	position += size - rom_size; //skip the header newer versions write
+	int next = 0;
+	for(int offset = 0; offset < rom_size; offset++){
+		unsigned char state = position[offset];
+		if(state & CDL_DATA){
+			map[offset] |= code_map::DATA;
+		}
+		if(state & (CDL_JUMP_TARGET | CDL_SUBROUTINE)){
+			map[offset] |= code_map::LABEL;
+		}
+		if(state & CDL_CODE && offset >= next){
+			next = mark_instruction(offset, (state & CDL_MEMORY_8 ? 0 : code_map::A_16) | 
+			                                (state & CDL_INDEX_8 ? 0 : code_map::I_16));
+		}
+	}
+	return true;
+}
+
+//Returns the offset the instruction falls through to
+int trace_importer::mark_instruction(int offset, unsigned char state)
+{
+	unsigned char op = buffer->at(offset);
+	int end = offset + isa_65c816::operand_size(op, state & code_map::A_16, state & code_map::I_16);
+	map[offset] = (map[offset] & (code_map::LABEL | code_map::ENTRY | code_map::DATA | code_map::INDIRECT)) | 
+	              code_map::OPCODE | state;
+	for(int i = offset + 1; i <= end && i < flags.size(); i++){
+		map[i] |= code_map::OPERAND;
+	}
+	return end + 1;
+}
+
+int trace_importer::parse_address(const char *&position, const char *end)
+{
+	while(position < end && (*position == ' ' || *position == '\t' || *position == '$')){
+		position++;
+	}
+	int address = 0;
+	int digits = 0;
+	for(; position < end; position++){
+		int digit = hex_digit(*position);
+		if(digit != -1){
+			address = address << 4 | digit;
+			digits++;
+		}else if(*position != ':' || digits != 2){
+			break;
+		}
+	}
+	return digits == 6 ? address : -1;
+}
+
+//Emulation mode shows 1 and B where M and X would be, both mean 8 bit registers
+int trace_importer::parse_state(const char *position, const char *end)
+{
+	for(; position + 3 < end; position++){
+		if(position[0] == 'P' && position[1] == ':' && hex_digit(position[2]) != -1 && hex_digit(position[3]) != -1){
+			int status = hex_digit(position[2]) << 4 | hex_digit(position[3]);
+			return (status & 0x20 ? 0 : code_map::A_16) | (status & 0x10 ? 0 : code_map::I_16);
+		}
+		if(position + 8 <= end && (position[0] | 0x20) == 'n' && (position[1] | 0x20) == 'v' && 
+		   (position[4] | 0x20) == 'd' && (position[5] | 0x20) == 'i' && 
+		   (position[6] | 0x20) == 'z' && (position[7] | 0x20) == 'c'){
+			bool memory_8 = position[2] == 'M' || position[2] == '1';
+			bool index_8 = position[3] == 'X' || position[3] == 'B';
+			return (memory_8 ? 0 : code_map::A_16) | (index_8 ? 0 : code_map::I_16);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef TRACE_IMPORTER_H
+#define TRACE_IMPORTER_H
+
+#include <QByteArray>
+#include <QString>
+
+#include "rom_buffer.h"
+#include "analysis/code_map.h"
+
+class QFile;
+
+//Reads what an emulator saw running, from a bsnes or Mesen trace log or a Mesen code data log
+class trace_importer
+{
+	public:
+		explicit trace_importer(const ROM_buffer *b);
+		bool import_file(const QString &path);
+		qint64 get_lines() const { return lines; }
+		code_map get_map() const { return code_map(flags); }
+		
+	private:
+		enum cdl_flags{
+			CDL_CODE = 0x01,
+			CDL_DATA = 0x02,
+			CDL_JUMP_TARGET = 0x04,
+			CDL_SUBROUTINE = 0x08,
+			CDL_INDEX_8 = 0x10,
+			CDL_MEMORY_8 = 0x20
+		};
+		
+		static const int chunk_size = 0x1000000;
+		
+		const ROM_buffer *buffer;
+		QByteArray flags;
+		unsigned char *map;
+		qint64 lines = 0;
+		int expected = -1;
+		bool indirect = false;
+		
+		void import_chunks(QFile &file);
+		void import_log(const char *position, const char *end);
+		bool import_cdl(const char *position, qint64 size);
+		int mark_instruction(int offset, unsigned char state);
+		static int parse_address(const char *&position, const char *end);
+		static int parse_state(const char *position, const char *end);
+};
+
+#endif // TRACE_IMPORTER_H
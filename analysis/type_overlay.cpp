@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+
+#include "type_overlay.h"
+#include "rom_buffer.h"
+#include "character_mapper.h"
+
+//Analysis decides code and data, bookmarks override it and whatever is left is guessed from its contents
+void type_overlay::build(const ROM_buffer *buffer)
+{
+	size = buffer->size();
+	QByteArray bytes = known_kinds(buffer, 0, size);
+	classify_unknown(buffer, bytes, 0);
+	starts.clear();
+	types.clear();
+	replace(0, bytes);
+}
+
+//Code, data and bookmarks outside start to end stay as they were, so only the guessed span around it is
+//worked out again. The span reaches out to code or data on both sides, where the guessing starts and stops
+//in a full build too.
+void type_overlay::update(const ROM_buffer *buffer, int start, int end)
+{
+	if(is_empty()){
+		return; //Never built, buffers without analysis show no overlay
+	}
+	if(buffer->size() != size){
+		build(buffer);
+		return;
+	}
+	start = qMax(start, 0);
+	end = qMin(end, size);
+	while(start > 0 && is_guessed(at(start - 1))){
+		start = run_start(find(start - 1));
+	}
+	while(end < size && is_guessed(at(end))){
+		end = run_end(find(end));
+	}
+	if(start >= end){
+		return;
+	}
+	QByteArray bytes = known_kinds(buffer, start, end);
+	classify_unknown(buffer, bytes, start);
+	replace(start, bytes);
+}
+
+//Bookmarks are written over the analysis in order of their start, so the one starting last wins
+QByteArray type_overlay::known_kinds(const ROM_buffer *buffer, int start, int end)
+{
+	QByteArray bytes(end - start, NONE);
+	const code_map &analysis = buffer->get_code_map();
+	for(int i = start; i < end && i < analysis.size(); i++){
+		unsigned char state = analysis.at(i);
+		bytes[i - start] = state & (code_map::OPCODE | code_map::OPERAND) ? CODE : state & code_map::DATA ? DATA : NONE;
+	}
+	buffer->get_bookmarks().overlapping(start, end, [&](const bookmark_index::interval &entry){
+		int from = qMax(entry.start, start);
+		int to = qMin(entry.end, end);
+		memset(bytes.data() + from - start, bookmark_kind(entry.bookmark), to - from);
+	});
+	return bytes;
+}
+
+//Long runs of a fill byte are free space, long runs of printable characters are text
+void type_overlay::classify_unknown(const ROM_buffer *buffer, QByteArray &bytes, int offset)
+{
+	const unsigned char *data = (const unsigned char *)buffer->data() + offset;
+	int length = bytes.size();
+	for(int i = 0; i < length;){
+		if(bytes.at(i) != NONE){
+			i++;
+			continue;
+		}
+		int end = i + 1;
+		if(data[i] == 0x00 || data[i] == 0xFF){
+			while(end < length && data[end] == data[i] && bytes.at(end) == NONE){
+				end++;
+			}
+			if(end - i >= minimum_free){
+				memset(bytes.data() + i, FREE, end - i);
+			}
+		}else if(isprint(character_mapper::encode(data[i]))){
+			while(end < length && isprint(character_mapper::encode(data[end])) && bytes.at(end) == NONE){
+				end++;
+			}
+			if(end - i >= minimum_text){
+				memset(bytes.data() + i, TEXT, end - i);
+			}
+		}
+		i = end;
+	}
+}
+
+int type_overlay::find(int offset) const
+{
+	if(offset < 0 || offset >= size){
+		return -1;
+	}
+	return std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin() - 1;
+}
+
+//Swaps the runs covering start up to the end of bytes for the runs in bytes, the run after them keeps its kind.
+//The runs are copied once, however many there are in bytes.
+void type_overlay::replace(int start, const QByteArray &bytes)
+{
+	int end = start + bytes.size();
+	kinds after = end < size ? at(end) : NONE;
+	int first = std::lower_bound(starts.begin(), starts.end(), start) - starts.begin();
+	int last = std::upper_bound(starts.begin(), starts.end(), end) - starts.begin();
+	QVector<int> new_starts = starts.mid(0, first);
+	QVector<unsigned char> new_types = types.mid(0, first);
+	new_starts.reserve(starts.size() + 16);
+	new_types.reserve(starts.size() + 16);
+	auto append = [&](int offset, unsigned char kind){
+		if(new_types.isEmpty() || new_types.last() != kind){
+			new_starts.append(offset);
+			new_types.append(kind);
+		}
+	};
+	for(int i = 0; i < bytes.size(); i++){
+		append(start + i, bytes.at(i));
+	}
+	if(end < size){
+		append(end, after);
+	}
+	for(int i = last; i < starts.size(); i++){
+		append(starts.at(i), types.at(i));
+	}
+	starts = new_starts;
+	types = new_types;
+}
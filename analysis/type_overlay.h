@@ -0,0 +1,55 @@
+#ifndef TYPE_OVERLAY_H
+#define TYPE_OVERLAY_H
+
+#include <QVector>
+
+#include "panels/bookmark_panel.h"
+
+class ROM_buffer;
+
+//What each byte of the ROM holds, kept as runs so a lookup is a binary search no matter how big the ROM is
+class type_overlay
+{
+	public:
+		enum kinds{
+			NONE,
+			CODE,
+			DATA,
+			POINTER,
+			TEXT,
+			FREE,
+			KIND_COUNT
+		};
+		
+		void build(const ROM_buffer *buffer);
+		void update(const ROM_buffer *buffer, int start, int end);
+		void clear(){ starts.clear(); types.clear(); size = 0; }
+		
+		bool is_empty() const { return starts.isEmpty(); }
+		int run_count() const { return starts.size(); }
+		int find(int offset) const;
+		int run_start(int run) const { return starts.at(run); }
+		int run_end(int run) const { return run + 1 < starts.size() ? starts.at(run + 1) : size; }
+		kinds run_kind(int run) const { return (kinds)types.at(run); }
+		kinds at(int offset) const { int run = find(offset); return run == -1 ? NONE : run_kind(run); }
+		
+		static kinds bookmark_kind(const bookmark_data &bookmark)
+		{
+			return bookmark.data_is_pointer ? POINTER : bookmark.data_type & bookmark_data::CODE ? CODE : DATA;
+		}
+		
+	private:
+		static const int minimum_free = 32;
+		static const int minimum_text = 16;
+		
+		QVector<int> starts;
+		QVector<unsigned char> types;
+		int size = 0;
+		
+		static bool is_guessed(kinds kind){ return kind == NONE || kind == FREE || kind == TEXT; }
+		static QByteArray known_kinds(const ROM_buffer *buffer, int start, int end);
+		void classify_unknown(const ROM_buffer *buffer, QByteArray &bytes, int offset);
+		void replace(int start, const QByteArray &bytes);
+};
+
+#endif // TYPE_OVERLAY_H
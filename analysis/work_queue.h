@@ -0,0 +1,99 @@
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#include <QMutex>
+#include <QList>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <atomic>
+#include <memory>
+#include <functional>
+
+//Each worker owns a deque.  Owners push and pop from the back while idle workers steal from the 
+//front of somebody else's deque, so the oldest (and usually largest) pieces of work migrate.
+template <typename T>
+class work_queue
+{
+	public:
+		explicit work_queue(int workers) : worker_count(workers), queues(new queue[workers]){}
+		
+		int size() const { return worker_count; }
+		
+		void push(int worker, const T &item)
+		{
+			pending++;
+			queue &q = queues[worker];
+			QMutexLocker lock(&q.mutex);
+			q.items.append(item);
+		}
+		
+		bool pop(int worker, T &item)
+		{
+			if(take(queues[worker], item, false)){
+				return true;
+			}
+			for(int i = 1; i < worker_count; i++){
+				if(take(queues[(worker + i) % worker_count], item, true)){
+					return true;
+				}
+			}
+			return false;
+		}
+		
+		//Blocks until every item, including those pushed while working, has been processed
+		void run(std::function<void(int, const T &)> work)
+		{
+			QThreadPool pool;
+			pool.setMaxThreadCount(worker_count);
+			for(int i = 0; i < worker_count; i++){
+				pool.start(new worker(this, i, work));
+			}
+			pool.waitForDone();
+		}
+		
+	private:
+		struct queue{
+			QMutex mutex;
+			QList<T> items;
+		};
+		
+		class worker : public QRunnable
+		{
+			public:
+				worker(work_queue *q, int i, std::function<void(int, const T &)> w) : 
+				        parent(q), id(i), work(w){}
+				void run()
+				{
+					T item;
+					while(parent->pending){
+						if(!parent->pop(id, item)){
+							QThread::yieldCurrentThread();
+							continue;
+						}
+						work(id, item);
+						parent->pending--;
+					}
+				}
+			private:
+				work_queue *parent;
+				int id;
+				std::function<void(int, const T &)> work;
+		};
+		
+		int worker_count;
+		std::unique_ptr<queue[]> queues;
+		std::atomic<int> pending{0};
+		
+		bool take(queue &q, T &item, bool steal)
+		{
+			QMutexLocker lock(&q.mutex);
+			if(q.items.isEmpty()){
+				return false;
+			}
+			item = steal ? q.items.takeFirst() : q.items.takeLast();
+			return true;
+		}
+};
+
+#endif // WORK_QUEUE_H
@@ -0,0 +1,197 @@
+#include <algorithm>
+
+#include "xref_index.h"
+#include "analysis_cache.h"
+#include "code_analyzer.h"
+#include "rom_buffer.h"
+#include "disassembly_cores/isa_65c816.h"
+#include "debug.h"
+
+void xref_index::build(const ROM_buffer *buffer)
+{
+	rom_size = buffer->size();
+	bank_hashes = analysis_cache::bank_hashes(buffer);
+	QVector<edge> edges;
+	collect(buffer, 0, rom_size, edges);
+	std::sort(edges.begin(), edges.end());
+	compress(edges);
+}
+
+//Only the banks whose hash changed since the last update have their references collected again.
+//References are kept by the bank they start in, and one starting in the bank before can end in a changed one.
+bool xref_index::update(const ROM_buffer *buffer)
+{
+	if(buffer->size() != rom_size){
+		build(buffer);
+		return true;
+	}
+	QVector<quint64> hashes = analysis_cache::bank_hashes(buffer);
+	QVector<bool> dirty(hashes.size(), false);
+	for(int bank = 0; bank < hashes.size(); bank++){
+		if(bank < bank_hashes.size() && hashes[bank] == bank_hashes[bank]){
+			continue;
+		}
+		dirty[bank] = true;
+		if(bank){
+			dirty[bank - 1] = true;
+		}
+	}
+	bank_hashes = hashes;
+	if(!dirty.contains(true)){
+		return false;
+	}
+	QVector<edge> fresh;
+	for(int bank = 0; bank < dirty.size(); bank++){
+		if(dirty[bank]){
+			collect(buffer, bank * analysis_cache::bank_size, 
+			        qMin((bank + 1) * analysis_cache::bank_size, rom_size), fresh);
+		}
+	}
+	
+	//What is left over is still sorted, so the two lists only need merging
+	QVector<edge> kept;
+	kept.reserve(sources.size());
+	for(int i = 0; i < targets.size(); i++){
+		for(int j = starts[i]; j < starts[i + 1]; j++){
+			if(!dirty[sources[j].source / analysis_cache::bank_size]){
+				kept.append({targets[i], sources[j].source, sources[j].kind});
+			}
+		}
+	}
+	std::sort(fresh.begin(), fresh.end());
+	QVector<edge> edges(kept.size() + fresh.size());
+	std::merge(kept.begin(), kept.end(), fresh.begin(), fresh.end(), edges.begin());
+	compress(edges);
+	return true;
+}
+
+//Bookmarks changing leaves the bytes alone, so only the pointer references are collected again
+void xref_index::update_pointers(const ROM_buffer *buffer)
+{
+	if(!rom_size || buffer->size() != rom_size){
+		return;
+	}
+	QVector<edge> kept;
+	kept.reserve(sources.size());
+	for(int i = 0; i < targets.size(); i++){
+		for(int j = starts[i]; j < starts[i + 1]; j++){
+			if(sources[j].kind != POINTER){
+				kept.append({targets[i], sources[j].source, sources[j].kind});
+			}
+		}
+	}
+	QVector<edge> fresh;
+	collect_pointers(buffer, 0, rom_size, fresh);
+	std::sort(fresh.begin(), fresh.end());
+	QVector<edge> edges(kept.size() + fresh.size());
+	std::merge(kept.begin(), kept.end(), fresh.begin(), fresh.end(), edges.begin());
+	compress(edges);
+}
+
+QVector<xref_index::reference> xref_index::references_to(int target) const
+{
+	int index = find(target);
+	if(index == -1){
+		return {};
+	}
+	return sources.mid(starts[index], starts[index + 1] - starts[index]);
+}
+
+int xref_index::reference_count(int target) const
+{
+	int index = find(target);
+	return index == -1 ? 0 : starts[index + 1] - starts[index];
+}
+
+QVector<int> xref_index::targets_of(kinds kind) const
+{
+	QVector<int> found;
+	for(int i = 0; i < targets.size(); i++){
+		for(int j = starts[i]; j < starts[i + 1]; j++){
+			if(sources[j].kind == kind){
+				found.append(targets[i]);
+				break;
+			}
+		}
+	}
+	return found;
+}
+
+//Edits don't move the analysis, so instructions are decoded again wherever an opcode was found
+void xref_index::collect(const ROM_buffer *buffer, int start, int end, QVector<edge> &edges) const
+{
+	const code_map &analysis = buffer->get_code_map();
+	for(int offset = start; offset < end && analysis.is_valid(); offset++){
+		unsigned char state = analysis.at(offset);
+		if(!(state & code_map::OPCODE)){
+			continue;
+		}
+		unsigned char op = buffer->at(offset);
+		int length = isa_65c816::operand_size(op, state & code_map::A_16, state & code_map::I_16) + 1;
+		if(offset + length > rom_size){
+			continue;
+		}
+		bool stop = false;
+		int address = code_analyzer::follow(buffer, offset, op, length, stop);
+		int target = address == -1 ? -1 : buffer->snes_to_pc(address);
+		if(target < 0 || target >= rom_size){
+			continue;
+		}
+		kinds kind = (op == 0x20 || op == 0x22) ? CALL : (op == 0x4C || op == 0x5C) ? JUMP : BRANCH;
+		edges.append({target, offset, kind});
+	}
+	collect_pointers(buffer, start, end, edges);
+}
+
+//Pointer tables come from the bookmarks. Entries belong to the range they start in, their last bytes may
+//lie past its end.
+void xref_index::collect_pointers(const ROM_buffer *buffer, int start, int end, QVector<edge> &edges) const
+{
+	if(!buffer->get_bookmark_map()){
+		return;
+	}
+	QVector<int> pointers;
+	for(const auto &bookmark : *buffer->get_bookmark_map()){
+		int width = (bookmark.data_type & bookmark_data::WORD) ? 2 :
+		            (bookmark.data_type & bookmark_data::LONG) ? 3 : 0;
+		int table = buffer->snes_to_pc(bookmark.address);
+		if(bookmark.data_type & bookmark_data::CODE || !bookmark.data_is_pointer || !width || table < 0){
+			continue;
+		}
+		int first = start > table ? (start - table + width - 1) / width * width : 0;
+		pointers.resize(0);
+		for(int i = first; i + width <= bookmark.size && table + i < end && table + i + width <= rom_size; i += width){
+			int pointer = code_analyzer::read_operand(buffer, table + i, width);
+			pointers.append(width == 2 ? pointer | (bookmark.address & 0xFF0000) : pointer);
+		}
+		buffer->translate_to_pc(pointers.data(), pointers.size());
+		for(int i = 0; i < pointers.size(); i++){
+			if(pointers.at(i) >= 0 && pointers.at(i) < rom_size){
+				edges.append({pointers.at(i), table + first + i * width, POINTER});
+			}
+		}
+	}
+}
+
+void xref_index::compress(const QVector<edge> &edges)
+{
+	revision++;
+	targets.clear();
+	starts.clear();
+	sources.clear();
+	sources.reserve(edges.size());
+	for(const auto &e : edges){
+		if(targets.isEmpty() || targets.last() != e.target){
+			targets.append(e.target);
+			starts.append(sources.size());
+		}
+		sources.append({e.source, e.kind});
+	}
+	starts.append(sources.size());
+}
+
+int xref_index::find(int target) const
+{
+	auto result = std::lower_bound(targets.begin(), targets.end(), target);
+	return result == targets.end() || *result != target ? -1 : result - targets.begin();
+}
@@ -0,0 +1,59 @@
+#ifndef XREF_INDEX_H
+#define XREF_INDEX_H
+
+#include <QVector>
+
+class ROM_buffer;
+
+//Every jump, branch, call and pointer in the analyzed code, grouped by the offset they lead to
+class xref_index
+{
+	public:
+		enum kinds{
+			BRANCH,
+			JUMP,
+			CALL,
+			POINTER
+		};
+		
+		struct reference{
+			int source;
+			kinds kind;
+		};
+		
+		void build(const ROM_buffer *buffer);
+		bool update(const ROM_buffer *buffer);
+		void update_pointers(const ROM_buffer *buffer);
+		QVector<reference> references_to(int target) const;
+		int reference_count(int target) const;
+		QVector<int> targets_of(kinds kind) const;
+		int target_count() const { return targets.size(); }
+		int size() const { return sources.size(); }
+		int get_revision() const { return revision; }
+		
+	private:
+		struct edge{
+			int target;
+			int source;
+			kinds kind;
+			bool operator<(const edge &other) const
+			{
+				return target < other.target || (target == other.target && source < other.source);
+			}
+		};
+		
+		//Compressed rows, the sources of targets[i] are sources[starts[i]] up to sources[starts[i + 1]]
+		QVector<int> targets;
+		QVector<int> starts;
+		QVector<reference> sources;
+		QVector<quint64> bank_hashes;
+		int rom_size = 0;
+		int revision = 0;
+		
+		void collect(const ROM_buffer *buffer, int start, int end, QVector<edge> &edges) const;
+		void collect_pointers(const ROM_buffer *buffer, int start, int end, QVector<edge> &edges) const;
+		void compress(const QVector<edge> &edges);
+		int find(int target) const;
+};
+
+#endif // XREF_INDEX_H
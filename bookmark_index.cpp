@@ -0,0 +1,43 @@
+#include <algorithm>
+
+#include "bookmark_index.h"
+#include "rom_buffer.h"
+
+void bookmark_index::build(const bookmark_map *bookmarks, const ROM_buffer *buffer)
+{
+	clear();
+	if(!bookmarks){
+		return;
+	}
+	intervals.reserve(bookmarks->size());
+	for(const auto &bookmark : *bookmarks){
+		int start = buffer->snes_to_pc(bookmark.address);
+		if(start >= 0){
+			intervals.append({start, start + qMax(bookmark.size, 0), bookmark});
+		}
+	}
+	std::stable_sort(intervals.begin(), intervals.end(), [](const interval &a, const interval &b){
+		return a.start < b.start;
+	});
+	max_end.resize(intervals.size());
+	build_max(0, intervals.size());
+}
+
+int bookmark_index::build_max(int low, int high)
+{
+	if(low >= high){
+		return -1;
+	}
+	int middle = (low + high) / 2;
+	max_end[middle] = qMax(intervals.at(middle).end, qMax(build_max(low, middle), build_max(middle + 1, high)));
+	return max_end.at(middle);
+}
+
+//Returns the first bookmark starting at offset
+const bookmark_data *bookmark_index::at(int offset) const
+{
+	auto found = std::lower_bound(intervals.begin(), intervals.end(), offset, [](const interval &a, int b){
+		return a.start < b;
+	});
+	return found != intervals.end() && found->start == offset ? &found->bookmark : nullptr;
+}
@@ -0,0 +1,64 @@
+#ifndef BOOKMARK_INDEX_H
+#define BOOKMARK_INDEX_H
+
+#include <QVector>
+
+#include "panels/bookmark_panel.h"
+
+class ROM_buffer;
+
+//Bookmarks keyed by ROM offset. The array sorted by start doubles as a balanced tree, each middle element
+//keeps the largest end below it so a range query only visits subtrees that can overlap.
+class bookmark_index
+{
+	public:
+		struct interval{
+			int start;
+			int end;
+			bookmark_data bookmark;
+		};
+		
+		void build(const bookmark_map *bookmarks, const ROM_buffer *buffer);
+		void clear(){ intervals.clear(); max_end.clear(); }
+		bool is_empty() const { return intervals.isEmpty(); }
+		int size() const { return intervals.size(); }
+		const QVector<interval> &get_intervals() const { return intervals; }
+		
+		const bookmark_data *at(int offset) const;
+		
+		//Calls back with every bookmark overlapping start to end, in order of their start
+		template <typename F>
+		void overlapping(int start, int end, F callback) const
+		{
+			query(0, intervals.size(), start, end, callback);
+		}
+		
+	private:
+		QVector<interval> intervals;
+		QVector<int> max_end;
+		
+		int build_max(int low, int high);
+		
+		template <typename F>
+		void query(int low, int high, int start, int end, F &callback) const
+		{
+			if(low >= high){
+				return;
+			}
+			int middle = (low + high) / 2;
+			if(max_end.at(middle) <= start){
+				return;
+			}
+			query(low, middle, start, end, callback);
+			const interval &current = intervals.at(middle);
+			if(current.start >= end){
+				return;
+			}
+			if(current.end > start){
+				callback(current);
+			}
+			query(middle + 1, high, start, end, callback);
+		}
+};
+
+#endif // BOOKMARK_INDEX_H
@@ -0,0 +1,85 @@
+#include <QtConcurrent>
+#include <QSet>
+#include <algorithm>
+
+#include "block_scanner.h"
+#include "codec.h"
+#include "rom_buffer.h"
+
+//Pointer targets come from the analysis, an unanalyzed ROM is only tried at bank starts
+QVector<int> block_scanner::candidates(const ROM_buffer *buffer)
+{
+	QVector<int> offsets = buffer->get_xrefs().targets_of(xref_index::POINTER);
+	for(int bank = 0; bank < buffer->size(); bank += bank_size){
+		offsets.append(bank);
+	}
+	std::sort(offsets.begin(), offsets.end());
+	offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+	return offsets;
+}
+
+//Works on a copy of the ROM so it can run while the buffer is edited.
+//Each round decodes its candidates in parallel and the ends of what it found become the next round.
+QVector<block_scanner::result> block_scanner::scan(const QByteArray &rom, QVector<int> offsets)
+{
+	QVector<result> found;
+	QSet<int> tried;
+	for(int offset : offsets){
+		tried.insert(offset);
+	}
+	while(!offsets.isEmpty()){
+		QVector<candidate> round;
+		round.reserve(offsets.size());
+		for(int offset : offsets){
+			round.append({offset, {}});
+		}
+		QtConcurrent::blockingMap(round, [&rom](candidate &entry){
+			entry.blocks = try_offset(rom, entry.offset);
+		});
+		
+		offsets.clear();
+		for(const candidate &entry : round){
+			for(const result &block : entry.blocks){
+				found.append(block);
+				int end = block.offset + block.size;
+				if(end < rom.size() && !tried.contains(end)){
+					tried.insert(end);
+					offsets.append(end);
+				}
+			}
+		}
+	}
+	std::sort(found.begin(), found.end(), [](const result &a, const result &b){
+		return a.offset < b.offset;
+	});
+	return found;
+}
+
+//The header check throws out most offsets before anything is decoded, the canonical check most of what is left
+QVector<block_scanner::result> block_scanner::try_offset(const QByteArray &rom, int offset)
+{
+	QVector<result> blocks;
+	const uchar *data = (const uchar *)rom.constData() + offset;
+	int remaining = rom.size() - offset;
+	QByteArray output;
+	for(const codec *format : codec::codecs()){
+		if(!format->valid_header(data, remaining)){
+			continue;
+		}
+		int size = format->decompress(data, remaining, output);
+		if(size > 0 && plausible(output, size) && format->canonical(data, size)){
+			blocks.append({format->name(), offset, size, output.size()});
+		}
+	}
+	return blocks;
+}
+
+//A real block decodes to more than it takes up, and to more than a single repeated byte
+bool block_scanner::plausible(const QByteArray &output, int size)
+{
+	if(output.size() < minimum_output || output.size() <= size){
+		return false;
+	}
+	const char *data = output.constData();
+	return std::any_of(data + 1, data + output.size(), [data](char byte){ return byte != data[0]; });
+}
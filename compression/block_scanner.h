@@ -0,0 +1,38 @@
+#ifndef BLOCK_SCANNER_H
+#define BLOCK_SCANNER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class ROM_buffer;
+
+//Runs every codec at the offsets compressed data usually starts at, pointer targets and bank starts.
+//Blocks tend to be stored back to back, so the end of each block found is tried as well.
+class block_scanner
+{
+	public:
+		struct result{
+			QString codec;
+			int offset;
+			int size;
+			int output_size;
+		};
+		
+		static QVector<int> candidates(const ROM_buffer *buffer);
+		static QVector<result> scan(const QByteArray &rom, QVector<int> offsets);
+		
+	private:
+		struct candidate{
+			int offset;
+			QVector<result> blocks;
+		};
+		
+		static const int bank_size = 0x8000;
+		static const int minimum_output = 64;
+		
+		static QVector<result> try_offset(const QByteArray &rom, int offset);
+		static bool plausible(const QByteArray &output, int size);
+};
+
+#endif // BLOCK_SCANNER_H
@@ -0,0 +1,44 @@
+#include "codec.h"
+#include "lz_codec.h"
+#include "rle_codec.h"
+
+bool codec::read_block(const char *rom, int rom_size, int offset, compressed_block &block, int limit) const
+{
+	if(offset < 0 || offset >= rom_size){
+		return false;
+	}
+	block.data.clear();
+	block.size = decompress((const uchar *)rom + offset, rom_size - offset, block.data, limit);
+	block.codec = name();
+	block.offset = offset;
+	return block.size > 0 && !block.data.isEmpty();
+}
+
+const codec *codec::find(QString name)
+{
+	for(const codec *entry : codecs()){
+		if(entry->name() == name){
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+QStringList codec::names()
+{
+	QStringList list;
+	for(const codec *entry : codecs()){
+		list.append(entry->name());
+	}
+	return list;
+}
+
+const QVector<const codec *> &codec::codecs()
+{
+	static const lz_codec lz1(lz_codec::LZ1);
+	static const lz_codec lz2(lz_codec::LZ2);
+	static const lz_codec lz3(lz_codec::LZ3);
+	static const rle_codec rle;
+	static const QVector<const codec *> list = {&lz1, &lz2, &lz3, &rle};
+	return list;
+}
@@ -0,0 +1,38 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+
+//A compressed block found in the ROM, size is how many bytes it takes up there
+struct compressed_block{
+	QString codec;
+	int offset;
+	int size;
+	QByteArray data;
+};
+
+//Decoders never write past their limit and fail on anything malformed, so they are safe to run on arbitrary bytes
+class codec
+{
+	public:
+		static const int max_output = 0x10000;
+		
+		virtual ~codec(){}
+		virtual QString name() const = 0;
+		virtual int decompress(const uchar *data, int size, QByteArray &output, int limit = max_output) const = 0;
+		virtual QByteArray compress(const QByteArray &input) const = 0;
+		//A cheap check on the first command, for ruling out offsets before decoding
+		virtual bool valid_header(const uchar *data, int size) const { Q_UNUSED(data); return size > 0; }
+		//Whether a stream that decoded is one an encoder would write, random bytes rarely are
+		virtual bool canonical(const uchar *data, int size) const { Q_UNUSED(data); return size > 0; }
+		
+		bool read_block(const char *rom, int rom_size, int offset, compressed_block &block, int limit = max_output) const;
+		
+		static const codec *find(QString name);
+		static QStringList names();
+		static const QVector<const codec *> &codecs();
+};
+
+#endif // CODEC_H
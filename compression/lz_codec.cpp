@@ -0,0 +1,406 @@
+#include <cstring>
+#include <climits>
+
+#include "lz_codec.h"
+
+const int lz_codec::max_length;
+const int lz_codec::short_length;
+
+static inline uchar reverse_bits(uchar byte)
+{
+	return ((byte * 0x0202020202ULL) & 0x010884422010ULL) % 1023;
+}
+
+QString lz_codec::name() const
+{
+	static const char *names[] = {"LZ1", "LZ2", "LZ3"};
+	return names[variant];
+}
+
+int lz_codec::decompress(const uchar *data, int size, QByteArray &output, int limit) const
+{
+	int position = 0;
+	output.resize(limit);
+	int used = decode(data, size, (uchar *)output.data(), limit, position);
+	output.resize(used == -1 ? 0 : position);
+	return used;
+}
+
+//A stream can't open with a copy since there is nothing decoded to copy from yet
+bool lz_codec::valid_header(const uchar *data, int size) const
+{
+	if(size < 2 || data[0] == 0xFF){
+		return false;
+	}
+	int command = data[0] >> 5;
+	if(command == LONG_COMMAND){
+		command = (data[0] >> 2) & 0x07;
+	}
+	return command < REPEAT;
+}
+
+//Literal runs are only split once they reach the longest length a command can hold.
+//Only called on streams that decoded, so every argument is there.
+bool lz_codec::canonical(const uchar *data, int size) const
+{
+	int previous = -1;
+	for(int in = 0; in < size && data[in] != 0xFF;){
+		uchar header = data[in++];
+		int command = header >> 5;
+		int length = (header & 0x1F) + 1;
+		if(command == LONG_COMMAND){
+			command = (header >> 2) & 0x07;
+			length = ((header & 0x03) << 8 | data[in++]) + 1;
+		}
+		if(command == DIRECT_COPY && previous != -1 && previous < max_length){
+			return false;
+		}
+		previous = command == DIRECT_COPY ? length : -1;
+		
+		switch(command){
+			case DIRECT_COPY:
+				in += length;
+			break;
+			case BYTE_FILL:
+				in++;
+			break;
+			case WORD_FILL:
+				in += 2;
+			break;
+			case SEQUENCE_FILL:
+				in += variant != LZ3;
+			break;
+			default:
+				in += variant == LZ3 && data[in] & 0x80 ? 1 : 2;
+		}
+	}
+	return true;
+}
+
+//Copies may only read what was already written, anything else is treated as malformed
+int lz_codec::decode(const uchar *data, int size, uchar *output, int limit, int &position) const
+{
+	int in = 0;
+	while(in < size){
+		uchar header = data[in++];
+		if(header == 0xFF){
+			return in;
+		}
+		int command = header >> 5;
+		int length = (header & 0x1F) + 1;
+		if(command == LONG_COMMAND){
+			if(in >= size){
+				return -1;
+			}
+			command = (header >> 2) & 0x07;
+			length = ((header & 0x03) << 8 | data[in++]) + 1;
+			if(command == LONG_COMMAND){
+				return -1;
+			}
+		}
+		if(position + length > limit){
+			return -1;
+		}
+		
+		uchar *out = output + position;
+		switch(command){
+			case DIRECT_COPY:
+				if(in + length > size){
+					return -1;
+				}
+				memcpy(out, data + in, length);
+				in += length;
+			break;
+			case BYTE_FILL:
+				if(in >= size){
+					return -1;
+				}
+				memset(out, data[in++], length);
+			break;
+			case WORD_FILL:
+				if(in + 2 > size){
+					return -1;
+				}
+				for(int i = 0; i < length; i++){
+					out[i] = data[in + (i & 1)];
+				}
+				in += 2;
+			break;
+			case SEQUENCE_FILL:
+				if(variant == LZ3){
+					memset(out, 0, length);
+					break;
+				}
+				if(in >= size){
+					return -1;
+				}
+				for(int i = 0; i < length; i++){
+					out[i] = data[in] + i;
+				}
+				in++;
+			break;
+			default:{
+				if(variant != LZ3 && command != REPEAT){
+					return -1;
+				}
+				int source;
+				if(in >= size){
+					return -1;
+				}
+				if(variant == LZ3 && data[in] & 0x80){
+					source = position - (data[in++] & 0x7F) - 1;
+				}else if(in + 2 > size){
+					return -1;
+				}else{
+					source = variant == LZ1 ? data[in] | data[in + 1] << 8 : data[in] << 8 | data[in + 1];
+					in += 2;
+				}
+				if(source < 0 || source >= position || (command == BACKWARD_REPEAT && source - length + 1 < 0)){
+					return -1;
+				}
+				const uchar *from = output + source;
+				if(command == REPEAT){
+					for(int i = 0; i < length; i++){
+						out[i] = from[i];
+					}
+				}else if(command == REVERSED_REPEAT){
+					for(int i = 0; i < length; i++){
+						out[i] = reverse_bits(from[i]);
+					}
+				}else{
+					for(int i = 0; i < length; i++){
+						out[i] = from[-i];
+					}
+				}
+			}
+		}
+		position += length;
+	}
+	return -1;
+}
+
+QByteArray lz_codec::compress(const QByteArray &input) const
+{
+	const uchar *data = (const uchar *)input.constData();
+	QVector<step> steps = parse(data, input.size());
+	QByteArray output;
+	output.reserve(input.size() + input.size() / short_length + 16);
+	int position = 0;
+	for(const step &command : steps){
+		write_step(output, data, position, command);
+		position += command.length;
+	}
+	output.append((char)0xFF);
+	return output;
+}
+
+namespace {
+	//Positions sharing a three byte hash, newest first
+	struct hash_chain{
+		static const int bits = 15;
+		QVector<int> head;
+		QVector<int> previous;
+		
+		hash_chain(int size) : head(1 << bits, -1), previous(size, -1){}
+		static int key(uchar a, uchar b, uchar c){ return ((a << 16 | b << 8 | c) * 2654435761u) >> (32 - bits); }
+		void insert(int hash, int position){ previous[position] = head[hash]; head[hash] = position; }
+	};
+}
+
+//Optimal parse over every position. Matches come from hash chains and only the longest one for each kind
+//of copy is kept, lengths past the one byte header limit are only tried in full.
+//Once a match is long enough nothing inside it is searched again, which keeps repetitive data fast.
+//Literal runs are costed a byte at a time, with the header paid when a run starts or outgrows a short header.
+QVector<lz_codec::step> lz_codec::parse(const uchar *data, int size) const
+{
+	const int unreached = INT_MAX / 2;
+	const int max_absolute = variant == LZ3 ? 0x7FFF : 0xFFFF;
+	bool extended = variant == LZ3;
+	
+	QVector<unsigned short> same(size + 1, 0), alternating(size + 1, 0), increasing(size + 1, 0);
+	for(int i = size - 1; i >= 0; i--){
+		same[i] = qMin(max_length, i + 1 < size && data[i + 1] == data[i] ? same[i + 1] + 1 : 1);
+		alternating[i] = qMin(max_length, i + 2 < size && data[i + 2] == data[i] ? alternating[i + 1] + 1 : qMin(2, size - i));
+		increasing[i] = qMin(max_length, i + 1 < size && data[i + 1] == (uchar)(data[i] + 1) ? increasing[i + 1] + 1 : 1);
+	}
+	
+	QVector<int> closed(size + 1, unreached);
+	QVector<int> literal(size + 1, unreached);
+	QVector<int> run(size + 1, 0);
+	QVector<bool> continued(size + 1, false);
+	QVector<step> chosen(size + 1);
+	closed[0] = 0;
+	
+	hash_chain forward(size);
+	hash_chain reversed(extended ? size : 0);
+	hash_chain backward(extended ? size : 0);
+	int skip_until = 0;
+	
+	for(int i = 0; i < size; i++){
+		if(literal[i] < unreached){
+			int in_chunk = run[i] % max_length + 1;
+			int cost = literal[i] + 1 + (in_chunk == 1) + (in_chunk == short_length + 1);
+			literal[i + 1] = cost;
+			run[i + 1] = run[i] + 1;
+			continued[i + 1] = true;
+		}
+		if(closed[i] + 2 < literal[i + 1]){
+			literal[i + 1] = closed[i] + 2;
+			run[i + 1] = 1;
+			continued[i + 1] = false;
+		}
+		
+		bool from_literal = literal[i] < closed[i];
+		int base = qMin(literal[i], closed[i]);
+		auto relax = [&](int command, int longest, int argument_size, int argument, bool relative){
+			auto try_length = [&](int length){
+				int cost = base + (length > short_length ? 2 : 1) + argument_size;
+				if(cost < closed[i + length]){
+					closed[i + length] = cost;
+					chosen[i + length] = {(unsigned char)command, relative, from_literal, (unsigned short)length, argument};
+				}
+			};
+			for(int length = 1; length <= qMin(longest, short_length); length++){
+				try_length(length);
+			}
+			if(longest > short_length){
+				try_length(longest);
+			}
+		};
+		
+		relax(BYTE_FILL, same[i], 1, 0, false);
+		relax(WORD_FILL, alternating[i], 2, 0, false);
+		if(extended && !data[i]){
+			relax(SEQUENCE_FILL, same[i], 0, 0, false);
+		}else if(!extended){
+			relax(SEQUENCE_FILL, increasing[i], 1, 0, false);
+		}
+		
+		if(i + 2 >= size){
+			continue;
+		}
+		int limit = qMin(max_length, size - i);
+		int hash = hash_chain::key(data[i], data[i + 1], data[i + 2]);
+		bool searching = i >= skip_until;
+		auto search = [&](int command, const hash_chain &chain, auto matches){
+			int absolute = 0, absolute_source = 0, relative = 0, relative_source = 0;
+			int depth = 0;
+			for(int j = chain.head[hash]; searching && j != -1 && depth < max_chain; j = chain.previous[j], depth++){
+				int length = matches(j, limit);
+				if(extended && i - j <= 0x80 && length > relative){
+					relative = length;
+					relative_source = j;
+				}
+				if(j <= max_absolute && length > absolute){
+					absolute = length;
+					absolute_source = j;
+				}
+				if(absolute >= nice_length || absolute == limit){
+					break;
+				}
+			}
+			if(qMax(absolute, relative) >= nice_length){
+				skip_until = qMax(skip_until, i + qMax(absolute, relative));
+			}
+			if(absolute >= 3){
+				relax(command, absolute, 2, absolute_source, false);
+			}
+			if(relative >= 3){
+				relax(command, relative, 1, relative_source, true);
+			}
+		};
+		search(REPEAT, forward, [&](int j, int limit){
+			int length = 0;
+			while(length < limit && data[j + length] == data[i + length]){
+				length++;
+			}
+			return length;
+		});
+		if(extended){
+			search(REVERSED_REPEAT, reversed, [&](int j, int limit){
+				int length = 0;
+				while(length < limit && reverse_bits(data[j + length]) == data[i + length]){
+					length++;
+				}
+				return length;
+			});
+			search(BACKWARD_REPEAT, backward, [&](int j, int limit){
+				int length = 0;
+				while(length < limit && length <= j && data[j - length] == data[i + length]){
+					length++;
+				}
+				return length;
+			});
+			reversed.insert(hash_chain::key(reverse_bits(data[i]), reverse_bits(data[i + 1]), reverse_bits(data[i + 2])), i);
+		}
+		forward.insert(hash, i);
+		if(extended && i >= 2){
+			backward.insert(hash_chain::key(data[i], data[i - 1], data[i - 2]), i);
+		}
+	}
+	
+	//Walk back from the end, then merge the single literal bytes into runs
+	QVector<step> reverse_steps;
+	bool in_literal = literal[size] < closed[size];
+	for(int i = size; i > 0;){
+		if(in_literal){
+			reverse_steps.append({DIRECT_COPY, false, false, 1, 0});
+			in_literal = continued[i];
+			i--;
+		}else{
+			reverse_steps.append(chosen[i]);
+			in_literal = chosen[i].from_literal;
+			i -= chosen[i].length;
+		}
+	}
+	QVector<step> steps;
+	for(int i = reverse_steps.size() - 1; i >= 0; i--){
+		const step &next = reverse_steps.at(i);
+		if(next.command == DIRECT_COPY && !steps.isEmpty() && steps.last().command == DIRECT_COPY &&
+		   steps.last().length < max_length){
+			steps.last().length++;
+		}else{
+			steps.append(next);
+		}
+	}
+	return steps;
+}
+
+void lz_codec::write_step(QByteArray &output, const uchar *data, int position, const step &command) const
+{
+	int length = command.length - 1;
+	if(length < short_length){
+		output.append(command.command << 5 | length);
+	}else{
+		output.append(LONG_COMMAND << 5 | command.command << 2 | length >> 8);
+		output.append(length & 0xFF);
+	}
+	
+	switch(command.command){
+		case DIRECT_COPY:
+			output.append((const char *)data + position, command.length);
+		break;
+		case BYTE_FILL:
+			output.append(data[position]);
+		break;
+		case WORD_FILL:
+			output.append(data[position]);
+			output.append(command.length > 1 ? data[position + 1] : 0);
+		break;
+		case SEQUENCE_FILL:
+			if(variant != LZ3){
+				output.append(data[position]);
+			}
+		break;
+		default:
+			if(command.relative){
+				output.append((position - command.argument - 1) | 0x80);
+			}else if(variant == LZ1){
+				output.append(command.argument & 0xFF);
+				output.append(command.argument >> 8);
+			}else{
+				output.append(command.argument >> 8);
+				output.append(command.argument & 0xFF);
+			}
+	}
+}
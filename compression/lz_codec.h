@@ -0,0 +1,58 @@
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+#include "codec.h"
+
+//Nintendo's LZ family. Each command is a three bit type with a length of up to 32, type 7 extends the length
+//to 1024 with a second byte and 0xFF ends the stream. LZ1 and LZ2 only differ in the byte order of copy offsets.
+//LZ3 fills with zero instead of an increasing byte, adds bit reversed and backwards copies and can give a
+//copy offset as a single byte relative to the output.
+class lz_codec : public codec
+{
+	public:
+		enum variants{
+			LZ1,
+			LZ2,
+			LZ3
+		};
+		
+		explicit lz_codec(variants v) : variant(v){}
+		virtual QString name() const;
+		virtual int decompress(const uchar *data, int size, QByteArray &output, int limit = max_output) const;
+		virtual QByteArray compress(const QByteArray &input) const;
+		virtual bool canonical(const uchar *data, int size) const;
+		virtual bool valid_header(const uchar *data, int size) const;
+		
+	private:
+		enum commands{
+			DIRECT_COPY,
+			BYTE_FILL,
+			WORD_FILL,
+			SEQUENCE_FILL,
+			REPEAT,
+			REVERSED_REPEAT,
+			BACKWARD_REPEAT,
+			LONG_COMMAND
+		};
+		
+		struct step{
+			unsigned char command;
+			bool relative;
+			bool from_literal;
+			unsigned short length;
+			int argument;
+		};
+		
+		static const int max_length = 1024;
+		static const int short_length = 32;
+		static const int max_chain = 32;
+		static const int nice_length = 64;
+		
+		variants variant;
+		
+		int decode(const uchar *data, int size, uchar *output, int limit, int &position) const;
+		QVector<step> parse(const uchar *data, int size) const;
+		void write_step(QByteArray &output, const uchar *data, int position, const step &command) const;
+};
+
+#endif // LZ_CODEC_H
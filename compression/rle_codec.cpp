@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include "rle_codec.h"
+
+const int rle_codec::max_copy;
+const int rle_codec::max_run;
+
+int rle_codec::decompress(const uchar *data, int size, QByteArray &output, int limit) const
+{
+	output.resize(limit);
+	uchar *out = (uchar *)output.data();
+	int position = 0;
+	int in = 0;
+	while(in < size){
+		uchar control = data[in++];
+		if(!control){
+			output.resize(position);
+			return in;
+		}
+		int length = control & 0x80 ? (control & 0x7F) + 2 : control;
+		if(position + length > limit || in + (control & 0x80 ? 1 : length) > size){
+			break;
+		}
+		if(control & 0x80){
+			memset(out + position, data[in++], length);
+		}else{
+			memcpy(out + position, data + in, length);
+			in += length;
+		}
+		position += length;
+	}
+	output.clear();
+	return -1;
+}
+
+//An encoder joins copies next to each other and never splits a run that fits in one command
+bool rle_codec::canonical(const uchar *data, int size) const
+{
+	int previous = 0;
+	int previous_byte = -1;
+	for(int in = 0; in < size && data[in];){
+		uchar control = data[in++];
+		if(control & 0x80){
+			if(previous & 0x80 && previous != (0x80 | (max_run - 2)) && data[in] == previous_byte){
+				return false;
+			}
+			previous_byte = data[in++];
+		}else{
+			if(previous && !(previous & 0x80) && previous != max_copy){
+				return false;
+			}
+			in += control;
+		}
+		previous = control;
+	}
+	return true;
+}
+
+//Runs of three or more always pay off, shorter ones are left in the copy around them
+QByteArray rle_codec::compress(const QByteArray &input) const
+{
+	const uchar *data = (const uchar *)input.constData();
+	int size = input.size();
+	QByteArray output;
+	output.reserve(size + size / max_copy + 2);
+	int copy_start = 0;
+	auto flush = [&](int end){
+		while(copy_start < end){
+			int length = qMin(max_copy, end - copy_start);
+			output.append(length);
+			output.append((const char *)data + copy_start, length);
+			copy_start += length;
+		}
+	};
+	for(int i = 0; i < size;){
+		int run = 1;
+		while(i + run < size && run < max_run && data[i + run] == data[i]){
+			run++;
+		}
+		if(run < 3){
+			i += run;
+			continue;
+		}
+		flush(i);
+		output.append(0x80 | (run - 2));
+		output.append(data[i]);
+		i += run;
+		copy_start = i;
+	}
+	flush(size);
+	output.append((char)0x00);
+	return output;
+}
@@ -0,0 +1,22 @@
+#ifndef RLE_CODEC_H
+#define RLE_CODEC_H
+
+#include "codec.h"
+
+//Plain run length encoding. A control byte of 0x01-0x7F copies that many bytes, 0x80-0xFF repeats the next byte
+//its low seven bits plus two times and 0x00 ends the stream.
+class rle_codec : public codec
+{
+	public:
+		virtual QString name() const { return "RLE"; }
+		virtual int decompress(const uchar *data, int size, QByteArray &output, int limit = max_output) const;
+		virtual QByteArray compress(const QByteArray &input) const;
+		virtual bool canonical(const uchar *data, int size) const;
+		virtual bool valid_header(const uchar *data, int size) const { return size > 1 && data[0]; }
+		
+	private:
+		static const int max_copy = 0x7F;
+		static const int max_run = 0x81;
+};
+
+#endif // RLE_CODEC_H
@@ -3,6 +3,9 @@
 #include "dialogs/goto_dialog.h"
 #include "dialogs/select_range_dialog.h"
 #include "dialogs/expand_rom_dialog.h"
+#include "dialogs/convert_mapper_dialog.h"
+#include "dialogs/decompress_dialog.h"
+#include "dialogs/free_space_dialog.h"
 #include "dialogs/metadata_editor_dialog.h"
 #include "dialogs/map_editor_dialog.h"
 #include "dialogs/settings_dialog.h"
@@ -15,6 +18,9 @@ dialog_manager::dialog_manager(QWidget *parent) :
 	dialog_map[GOTO] = new goto_dialog(parent);
 	dialog_map[SELECT_RANGE] = new select_range_dialog(parent);
 	dialog_map[EXPAND] = new expand_ROM_dialog(parent);
+	dialog_map[CONVERT_MAPPER] = new convert_mapper_dialog(parent);
+	dialog_map[DECOMPRESS] = new decompress_dialog(parent);
+	dialog_map[FREE_SPACE] = new free_space_dialog(parent);
 	dialog_map[METADATA_EDITOR] = new metadata_editor_dialog(parent);
 	dialog_map[FIND_REPLACE] = new find_replace_dialog(parent);
 	dialog_map[MAP_EDITOR] = new map_editor_dialog(parent);
@@ -27,6 +33,10 @@ void dialog_manager::connect_to_editor(hex_editor *editor)
 #define CONNECT(D,E,S,T) connect((D *)find_dialog(E), &D::S, editor, &hex_editor::T);
 	CONNECT(goto_dialog, GOTO, triggered, goto_offset);
 	CONNECT(select_range_dialog, SELECT_RANGE, triggered, select_range);
+	CONNECT(convert_mapper_dialog, CONVERT_MAPPER, triggered, convert_mapper);
+	CONNECT(expand_ROM_dialog, EXPAND, triggered, expand_ROM);
+	CONNECT(decompress_dialog, DECOMPRESS, triggered, decompress);
+	CONNECT(free_space_dialog, FREE_SPACE, triggered, claim_free_space);
 	CONNECT(find_replace_dialog, FIND_REPLACE, count, count);
 	CONNECT(find_replace_dialog, FIND_REPLACE, search, search);
 	CONNECT(find_replace_dialog, FIND_REPLACE, replace, replace);
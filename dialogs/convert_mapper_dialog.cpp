@@ -0,0 +1,49 @@
+#include "convert_mapper_dialog.h"
+#include "debug.h"
+
+convert_mapper_dialog::convert_mapper_dialog(QWidget *parent) : abstract_dialog(parent)
+{
+	connect(close, &QPushButton::clicked, this, &QDialog::close);
+	connect(convert, &QPushButton::clicked, this, &convert_mapper_dialog::convert_clicked);
+	
+	target_label->setBuddy(target);
+	relocate->setChecked(true);
+	relocate->setStatusTip("Moves bookmarks along with the bytes they mark.");
+	
+	QGridLayout *layout = new QGridLayout(this);
+	layout->addWidget(current_label, 0, 0);
+	layout->addWidget(current_mapper, 0, 1, 1, 2);
+	layout->addWidget(target_label, 1, 0);
+	layout->addWidget(target, 1, 1, 1, 2);
+	layout->addWidget(relocate, 2, 0, 1, 3);
+	layout->addWidget(convert, 3, 1);
+	layout->addWidget(close, 3, 2);
+	setLayout(layout);
+}
+
+//Only mappers the current one can be converted to are offered
+void convert_mapper_dialog::refresh()
+{
+	abstract_dialog::refresh();
+	target->clear();
+	if(!active_editor){
+		return;
+	}
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	current_mapper->setText(ROM_metadata::mapper_strings[buffer->get_mapper()].second);
+	for(int mapper = LOROM; mapper <= SDD1ROM; mapper++){
+		if(buffer->can_convert((memory_mapper)mapper)){
+			target->addItem(ROM_metadata::mapper_strings[mapper].second, mapper);
+		}
+	}
+	convert->setEnabled(target->count());
+}
+
+void convert_mapper_dialog::convert_clicked()
+{
+	if(!target->count()){
+		return;
+	}
+	emit triggered(target->currentData().toInt(), relocate->isChecked());
+	refresh();
+}
@@ -0,0 +1,33 @@
+#ifndef CONVERT_MAPPER_DIALOG_H
+#define CONVERT_MAPPER_DIALOG_H
+
+#include <QComboBox>
+#include <QCheckBox>
+
+#include "abstract_dialog.h"
+
+class convert_mapper_dialog : public abstract_dialog
+{
+		Q_OBJECT
+	public:
+		explicit convert_mapper_dialog(QWidget *parent);
+		
+	signals:
+		void triggered(int mapper, bool relocate);
+		
+	public slots:
+		virtual void refresh();
+		void convert_clicked();
+		
+	private:
+		QLabel *current_label = new QLabel("Current mapper: ", this);
+		QLabel *current_mapper = new QLabel("", this);
+		QLabel *target_label = new QLabel("&Convert to: ", this);
+		QComboBox *target = new QComboBox(this);
+		QCheckBox *relocate = new QCheckBox("&Relocate bookmarks", this);
+		
+		QPushButton *convert = new QPushButton("Convert", this);
+		QPushButton *close = new QPushButton("Close", this);
+};
+
+#endif // CONVERT_MAPPER_DIALOG_H
@@ -0,0 +1,123 @@
+#include <QtConcurrent>
+#include <QHeaderView>
+
+#include "decompress_dialog.h"
+#include "compression/codec.h"
+#include "utility.h"
+
+decompress_dialog::decompress_dialog(QWidget *parent) : abstract_dialog(parent)
+{
+	connect(close, &QPushButton::clicked, this, &QDialog::close);
+	connect(decompress, &QPushButton::clicked, this, &decompress_dialog::decompress_clicked);
+	connect(scan, &QPushButton::clicked, this, &decompress_dialog::scan_clicked);
+	connect(watcher, &QFutureWatcher<QVector<block_scanner::result>>::finished, this, &decompress_dialog::scan_finished);
+	connect(results, &QTableView::doubleClicked, this, &decompress_dialog::result_double_clicked);
+	
+	codec_label->setBuddy(codecs);
+	address_label->setBuddy(address_input);
+	codecs->addItems(codec::names());
+	address_input->setProperty("maxLength", 7);
+	decompress->setStatusTip("Opens the decompressed data in a new tab, edits there are compressed back into the ROM.");
+	scan->setStatusTip("Looks for compressed blocks at pointer targets and bank starts, analyze the ROM first to find more.");
+	
+	QStringList labels;
+	labels << "Offset" << "Format" << "Size" << "Decompressed";
+	model->setHorizontalHeaderLabels(labels);
+	results->setModel(model);
+	results->verticalHeader()->hide();
+	results->setSelectionBehavior(QAbstractItemView::SelectRows);
+	results->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	results->horizontalHeader()->setStretchLastSection(true);
+	
+	QGridLayout *layout = new QGridLayout(this);
+	layout->addWidget(codec_label, 0, 0);
+	layout->addWidget(codecs, 0, 1, 1, 2);
+	layout->addWidget(address_label, 1, 0);
+	layout->addWidget(address_input, 1, 1, 1, 2);
+	layout->addWidget(scan, 2, 0);
+	layout->addWidget(decompress, 2, 1);
+	layout->addWidget(close, 2, 2);
+	layout->addWidget(scan_status, 3, 0, 1, 3);
+	layout->addWidget(results, 4, 0, 1, 3);
+	setLayout(layout);
+}
+
+//Starts at the cursor so a block can be opened without typing its address
+void decompress_dialog::refresh()
+{
+	abstract_dialog::refresh();
+	if(!active_editor){
+		return;
+	}
+	int address = active_editor->get_buffer()->pc_to_snes(active_editor->get_cursor_nibble() / 2);
+	address_input->setText(address < 0 ? "" : to_hex(address, 6));
+	if(scanned_editor != active_editor){
+		model->removeRows(0, model->rowCount());
+		scan_status->clear();
+	}
+}
+
+void decompress_dialog::decompress_clicked()
+{
+	bool status;
+	QString input = address_input->text().remove(QRegExp("[^0-9A-Fa-f]"));
+	int address = input.toInt(&status, 16);
+	if(input.isEmpty() || !status){
+		return;
+	}
+	if(validate_address(address)){
+		emit triggered(codecs->currentText(), address);
+	}
+}
+
+//The scan reads a snapshot of the ROM on another thread, so editing can go on while it runs
+void decompress_dialog::scan_clicked()
+{
+	if(!active_editor || watcher->isRunning()){
+		return;
+	}
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	QByteArray rom = buffer->snapshot();
+	QVector<int> offsets = block_scanner::candidates(buffer);
+	scanned_editor = active_editor;
+	scan->setEnabled(false);
+	scan_status->setText("Scanning " + QString::number(offsets.size()) + " offsets...");
+	timer.start();
+	watcher->setFuture(QtConcurrent::run([rom, offsets](){
+		return block_scanner::scan(rom, offsets);
+	}));
+}
+
+//Results for an editor that was closed or switched away from in the meantime are dropped
+void decompress_dialog::scan_finished()
+{
+	scan->setEnabled(true);
+	if(!scanned_editor || scanned_editor != active_editor){
+		scan_status->clear();
+		return;
+	}
+	QVector<block_scanner::result> blocks = watcher->result();
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	model->removeRows(0, model->rowCount());
+	for(const auto &block : blocks){
+		QList<QStandardItem *> items;
+		items << new QStandardItem(buffer->get_formatted_address(block.offset))
+		      << new QStandardItem(block.codec)
+		      << new QStandardItem(QString::number(block.size))
+		      << new QStandardItem(QString::number(block.output_size));
+		items.first()->setData(block.offset, Qt::UserRole);
+		model->appendRow(items);
+	}
+	scan_status->setText(QString::number(blocks.size()) + " blocks found in " + QString::number(timer.elapsed()) + "ms");
+}
+
+void decompress_dialog::result_double_clicked(QModelIndex index)
+{
+	if(scanned_editor != active_editor){
+		return;
+	}
+	int offset = model->index(index.row(), 0).data(Qt::UserRole).toInt();
+	codecs->setCurrentText(model->index(index.row(), 1).data().toString());
+	address_input->setText(to_hex(active_editor->get_buffer()->pc_to_snes(offset), 6));
+	decompress_clicked();
+}
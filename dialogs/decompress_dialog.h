@@ -0,0 +1,48 @@
+#ifndef DECOMPRESS_DIALOG_H
+#define DECOMPRESS_DIALOG_H
+
+#include <QComboBox>
+#include <QTableView>
+#include <QStandardItemModel>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QPointer>
+
+#include "abstract_dialog.h"
+#include "compression/block_scanner.h"
+
+class decompress_dialog : public abstract_dialog
+{
+		Q_OBJECT
+	public:
+		explicit decompress_dialog(QWidget *parent);
+		
+	signals:
+		void triggered(QString codec, int address);
+		
+	public slots:
+		virtual void refresh();
+		void decompress_clicked();
+		void scan_clicked();
+		void scan_finished();
+		void result_double_clicked(QModelIndex index);
+		
+	private:
+		QLabel *codec_label = new QLabel("&Format: ", this);
+		QComboBox *codecs = new QComboBox(this);
+		QLabel *address_label = new QLabel("&SNES offset: ", this);
+		QLineEdit *address_input = new QLineEdit(this);
+		
+		QPushButton *decompress = new QPushButton("Decompress", this);
+		QPushButton *close = new QPushButton("Close", this);
+		QPushButton *scan = new QPushButton("Scan ROM", this);
+		QLabel *scan_status = new QLabel(this);
+		QTableView *results = new QTableView(this);
+		QStandardItemModel *model = new QStandardItemModel(this);
+		
+		QFutureWatcher<QVector<block_scanner::result>> *watcher = new QFutureWatcher<QVector<block_scanner::result>>(this);
+		QPointer<hex_editor> scanned_editor;
+		QElapsedTimer timer;
+};
+
+#endif // DECOMPRESS_DIALOG_H
@@ -2,8 +2,55 @@
 
 expand_ROM_dialog::expand_ROM_dialog(QWidget *parent) : abstract_dialog(parent)
 {
+	connect(close, &QPushButton::clicked, this, &QDialog::close);
+	connect(expand, &QPushButton::clicked, this, &expand_ROM_dialog::expand_clicked);
+	connect(fill, &QRadioButton::toggled, pattern_input, &QLineEdit::setEnabled);
+	
+	size_label->setBuddy(target_size);
+	fill->setChecked(true);
+	pattern_input->setStatusTip("Hex bytes repeated over the new space.");
+	mirror->setStatusTip("Repeats the ROM the way the console sees it past its end.");
+	
 	QGridLayout *layout = new QGridLayout(this);
-	QLabel *label = new QLabel("todo.");
-	layout->addWidget(label, 0, 0);
+	layout->addWidget(current_label, 0, 0);
+	layout->addWidget(current_size, 0, 1, 1, 2);
+	layout->addWidget(size_label, 1, 0);
+	layout->addWidget(target_size, 1, 1, 1, 2);
+	layout->addWidget(fill, 2, 0);
+	layout->addWidget(pattern_input, 2, 1, 1, 2);
+	layout->addWidget(mirror, 3, 0, 1, 3);
+	layout->addWidget(expand, 4, 1);
+	layout->addWidget(close, 4, 2);
 	setLayout(layout);
 }
+
+//Sizes are offered in 512KB steps up to what the mapper can address
+void expand_ROM_dialog::refresh()
+{
+	abstract_dialog::refresh();
+	target_size->clear();
+	if(!active_editor){
+		return;
+	}
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	current_size->setText(format_size(buffer->size()));
+	for(int size = (buffer->size() & ~0x7FFFF) + 0x80000; size <= buffer->max_size(); size += 0x80000){
+		target_size->addItem(format_size(size), size);
+	}
+	expand->setEnabled(target_size->count());
+}
+
+void expand_ROM_dialog::expand_clicked()
+{
+	QString hex = pattern_input->text().remove(QRegExp("[^0-9A-Fa-f]"));
+	if(!target_size->count() || (fill->isChecked() && (hex.isEmpty() || hex.length() & 1))){
+		return;
+	}
+	emit triggered(target_size->currentData().toInt(), QByteArray::fromHex(hex.toUtf8()), mirror->isChecked());
+	refresh();
+}
+
+QString expand_ROM_dialog::format_size(int size)
+{
+	return QString::number(size / 1048576.0) + "MB (" + QString::number(size >> 17) + "Mbit)";
+}
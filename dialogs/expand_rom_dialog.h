@@ -1,6 +1,9 @@
 #ifndef EXPAND_ROM_DIALOG_H
 #define EXPAND_ROM_DIALOG_H
 
+#include <QComboBox>
+#include <QRadioButton>
+
 #include "abstract_dialog.h"
 
 class expand_ROM_dialog : public abstract_dialog
@@ -8,6 +11,27 @@ class expand_ROM_dialog : public abstract_dialog
 		Q_OBJECT
 	public:
 		explicit expand_ROM_dialog(QWidget *parent);
+		
+	signals:
+		void triggered(int size, QByteArray pattern, bool mirror);
+		
+	public slots:
+		virtual void refresh();
+		void expand_clicked();
+		
+	private:
+		QLabel *current_label = new QLabel("Current size: ", this);
+		QLabel *current_size = new QLabel("", this);
+		QLabel *size_label = new QLabel("&Expand to: ", this);
+		QComboBox *target_size = new QComboBox(this);
+		QRadioButton *fill = new QRadioButton("&Fill with bytes: ", this);
+		QLineEdit *pattern_input = new QLineEdit("00", this);
+		QRadioButton *mirror = new QRadioButton("&Mirror the existing banks", this);
+		
+		QPushButton *expand = new QPushButton("Expand", this);
+		QPushButton *close = new QPushButton("Close", this);
+		
+		static QString format_size(int size);
 };
 
 #endif // EXPAND_ROM_DIALOG_H
@@ -0,0 +1,66 @@
+#include "free_space_dialog.h"
+
+free_space_dialog::free_space_dialog(QWidget *parent) : abstract_dialog(parent)
+{
+	connect(close, &QPushButton::clicked, this, &QDialog::close);
+	connect(claim, &QPushButton::clicked, this, &free_space_dialog::claim_clicked);
+	
+	length_label->setBuddy(length_input);
+	first_label->setBuddy(first_input);
+	last_label->setBuddy(last_input);
+	length_input->setProperty("maxLength", 6);
+	first_input->setProperty("maxLength", 2);
+	last_input->setProperty("maxLength", 2);
+	length_input->setStatusTip("Hex byte count, the space is selected and not handed out again until the ROM is resized.");
+	
+	QGridLayout *layout = new QGridLayout(this);
+	layout->addWidget(free_label, 0, 0);
+	layout->addWidget(free_total, 0, 1, 1, 2);
+	layout->addWidget(length_label, 1, 0);
+	layout->addWidget(length_input, 1, 1, 1, 2);
+	layout->addWidget(first_label, 2, 0);
+	layout->addWidget(first_input, 2, 1, 1, 2);
+	layout->addWidget(last_label, 3, 0);
+	layout->addWidget(last_input, 3, 1, 1, 2);
+	layout->addWidget(claim, 4, 1);
+	layout->addWidget(close, 4, 2);
+	setLayout(layout);
+}
+
+//The index is built the first time it is asked for, so nothing is scanned while the dialog is hidden
+void free_space_dialog::refresh()
+{
+	abstract_dialog::refresh();
+	if(!active_editor || !isVisible()){
+		return;
+	}
+	const free_space_index &free_space = active_editor->get_buffer()->get_free_space();
+	free_total->setText(QString::number(free_space.total()) + " bytes in " + 
+	                    QString::number(free_space.get_runs().size()) + " runs");
+}
+
+void free_space_dialog::claim_clicked()
+{
+	int length = parse_hex(length_input->text());
+	int first_bank = parse_hex(first_input->text());
+	int last_bank = parse_hex(last_input->text());
+	if(length <= 0 || first_bank < 0 || last_bank < first_bank){
+		return;
+	}
+	emit triggered(length, first_bank, last_bank);
+	refresh();
+}
+
+void free_space_dialog::showEvent(QShowEvent *event)
+{
+	abstract_dialog::showEvent(event);
+	refresh();
+}
+
+int free_space_dialog::parse_hex(QString input)
+{
+	bool status;
+	input.remove(QRegExp("[^0-9A-Fa-f]"));
+	int value = input.toInt(&status, 16);
+	return input.isEmpty() || !status ? -1 : value;
+}
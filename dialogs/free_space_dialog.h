@@ -0,0 +1,38 @@
+#ifndef FREE_SPACE_DIALOG_H
+#define FREE_SPACE_DIALOG_H
+
+#include "abstract_dialog.h"
+
+class free_space_dialog : public abstract_dialog
+{
+		Q_OBJECT
+	public:
+		explicit free_space_dialog(QWidget *parent);
+		
+	signals:
+		void triggered(int length, int first_bank, int last_bank);
+		
+	public slots:
+		virtual void refresh();
+		void claim_clicked();
+		
+	protected:
+		virtual void showEvent(QShowEvent *event);
+		
+	private:
+		QLabel *free_label = new QLabel("Free space: ", this);
+		QLabel *free_total = new QLabel("", this);
+		QLabel *length_label = new QLabel("&Bytes needed: ", this);
+		QLineEdit *length_input = new QLineEdit(this);
+		QLabel *first_label = new QLabel("&First bank: ", this);
+		QLineEdit *first_input = new QLineEdit("00", this);
+		QLabel *last_label = new QLabel("&Last bank: ", this);
+		QLineEdit *last_input = new QLineEdit("FF", this);
+		
+		QPushButton *claim = new QPushButton("Claim", this);
+		QPushButton *close = new QPushButton("Close", this);
+		
+		static int parse_hex(QString input);
+};
+
+#endif // FREE_SPACE_DIALOG_H
@@ -26,6 +26,11 @@ settings_dialog::settings_dialog(QWidget *parent) : abstract_dialog(parent)
 	
 	QColor highlight_color = QApplication::palette().color(QPalette::Active, QPalette::Highlight).lighter();
 	QColor diff_color = QApplication::palette().color(QPalette::Active, QPalette::HighlightedText).darker();
+	QColor code_color = QColor(0xDC, 0xF0, 0xDC);
+	QColor data_color = QColor(0xDC, 0xE6, 0xF8);
+	QColor pointer_color = QColor(0xF0, 0xE4, 0xF8);
+	QColor text_color = QColor(0xF8, 0xF0, 0xD8);
+	QColor free_color = QColor(0xEC, 0xEC, 0xEC);
 	
 	setting<QLineEdit>("Editor font size", "display/font", font_validator, QApplication::font().pointSize());
 	setting<QCheckBox>("Do not prompt on size change:", "editor/size_change", null_validator, false);
@@ -42,6 +47,11 @@ settings_dialog::settings_dialog(QWidget *parent) : abstract_dialog(parent)
 			});
 	setting<QPushable>("Highlight color:", "display/highlight", null_validator, highlight_color, make_color);
 	setting<QPushable>("Diff color:", "display/diff", null_validator, diff_color, make_color);
+	setting<QPushable>("Code color:", "display/overlay_code", null_validator, code_color, make_color);
+	setting<QPushable>("Data color:", "display/overlay_data", null_validator, data_color, make_color);
+	setting<QPushable>("Pointer color:", "display/overlay_pointer", null_validator, pointer_color, make_color);
+	setting<QPushable>("Text color:", "display/overlay_text", null_validator, text_color, make_color);
+	setting<QPushable>("Free space color:", "display/overlay_free", null_validator, free_color, make_color);
 	
 	int row = layout->rowCount();
 	layout->addWidget(refresh_button, row, 0);
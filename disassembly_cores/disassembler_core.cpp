@@ -1,124 +1,234 @@
 #include <QStringBuilder>
+#include <algorithm>
 
 #include "utility.h"
 #include "disassembler_core.h"
 #include "debug.h"
 
-QString disassembler_core::disassemble(selection selection_area, const ROM_buffer *b)
+void disassembler_core::disassemble(selection selection_area, const ROM_buffer *b)
 {
 	reset();
 	buffer = b;
 	region = selection_area;
 	data = buffer->range(region.get_start_aligned(), region.get_end_aligned());
-	
-	const bookmark_map *bookmarks = buffer->get_bookmark_map();
-	const QVector<int> rats_tags = buffer->get_rats_tags();
+	initial_state = get_state();
 
+	label_mode = REFERENCE;
 	while(delta < data.size() && error.isEmpty()){
-		const QString address = buffer->get_formatted_address(get_base()+delta);
-		if(bookmarks->contains(address)){
-			bookmark_data bookmark = bookmarks->value(address);
-			if(bookmark.data_type & bookmark_data::CODE && !(bookmark.data_type & bookmark_data::UNKNOWN)){
-				set_flags(bookmark.data_type);
-			}else if(!(bookmark.data_type & bookmark_data::CODE)){
-				disassemble_table(bookmark);
-				continue;
+		index_next();
+	}
+	label_mode = LOOKUP;
+	
+	merge_labels();
+	update_state();
+}
+
+//Re-decodes whatever changed in the buffer since it was disassembled, returns false if nothing did
+bool disassembler_core::refresh()
+{
+	if(!buffer || rows.isEmpty()){
+		return false;
+	}
+	QByteArray current = buffer->range(region.get_start_aligned(), region.get_end_aligned());
+	if(current.size() != data.size() || !error.isEmpty()){
+		//Inserts and deletes shift everything after them, so start over
+		set_state(initial_state);
+		disassemble(region, buffer);
+		return true;
+	}
+	
+	int first = 0;
+	while(first < data.size() && data.at(first) == current.at(first)){
+		first++;
+	}
+	if(first == data.size()){
+		return false;
+	}
+	int last = data.size() - 1;
+	while(data.at(last) == current.at(last)){
+		last--;
+	}
+	redisassemble(first, last, current);
+	return true;
+}
+
+//Lines are only formatted once they are needed, the decoder state is restored from the index
+QString disassembler_core::format_line(int row)
+{
+	static const char *prefix[] = {"\tdb ", "\tdw ", "\tdl ", "\tdd "};
+	const line &l = rows.at(row);
+	int saved_delta = delta;
+	unsigned char saved_state = get_state();
+	delta = l.delta;
+	line_length = 0;
+	
+	switch(l.format){
+		case line::CODE:
+			if(!labels.isEmpty()){
+				append('\t');
+			}
+			set_state(l.state);
+			delta++;
+			decode(data.at(l.delta));
+		break;
+		case line::DATA_PACKED ... line::DATA_UNPACKED_END:{
+			int width = table_width(l);
+			append(prefix[width]);
+			for(int i = 0; i < l.count; i++){
+				if(i){
+					append(", ");
+				}
+				append(format_data_value(width, table_value(l.delta + i * (width + 1), width), l.is_pointer));
 			}
-		}else if(rats_tags.contains(region.get_start_byte() + delta) && delta + 8 < data.size()){
-			disassemble_rats();
-			continue;
 		}
-		disassemble_code();
+		break;
+		case line::DATA_STRING:
+			append(prefix[0]);
+			append('"');
+			append(QString::fromLatin1(data.mid(l.delta, l.count)));
+			append('"');
+		break;
+		case line::LABEL:
+			append(labels.value(get_base() + l.delta).text);
+			append(':');
+		break;
+		case line::ERROR_TEXT:
+			append(error);
+		break;
 	}
 	
-	update_state();
-	return disassembly_text() + error;
+	QString text = QString::fromLatin1(line_buffer, line_length);
+	delta = saved_delta;
+	set_state(saved_state);
+	return text;
+}
+
+//Returns the first line at or after the offset, or -1 if the offset isn't disassembled
+int disassembler_core::find_line(int offset)
+{
+	int target = offset - region.get_start_byte();
+	if(rows.isEmpty() || target < 0 || target >= data.size()){
+		return -1;
+	}
+	auto result = std::lower_bound(rows.begin(), rows.end(), target, 
+	                               [](const line &l, int target){ return l.delta < target; });
+	return qMin((int)(result - rows.begin()), rows.size() - 1);
+}
+
+//Returns the instruction or data line the offset belongs to, or -1 if the offset isn't disassembled
+int disassembler_core::find_instruction(int offset)
+{
+	int target = offset - region.get_start_byte();
+	if(rows.isEmpty() || target < 0 || target >= data.size()){
+		return -1;
+	}
+	auto result = std::upper_bound(rows.begin(), rows.end(), target, 
+	                               [](int target, const line &l){ return target < l.delta; });
+	int row = qMax((int)(result - rows.begin()) - 1, 0);
+	while(row > 0 && rows.at(row).format == line::LABEL){
+		row--;
+	}
+	return row;
 }
 
+int disassembler_core::line_offset(int row)
+{
+	return region.get_start_byte() + rows.at(row).delta;
+}
+
+//Labels are reference counted while indexing, so re-decoding part of the range can drop them again
 QString disassembler_core::add_label(int destination, QString prefix)
 {
-	block &b = disassembly_list[destination];
-	if(b.label.isEmpty()){
-		label_id++;
-		b.label = (prefix.isEmpty() ? "label_" : prefix) % address_to_label(destination) % ":\n";
+	auto entry = labels.find(destination);
+	if(entry == labels.end()){
+		const char *symbol = buffer->get_symbols().find(symbol_address(destination));
+		QString text = symbol ? QString::fromLatin1(symbol) : 
+		                        (prefix.isEmpty() ? "label_" : prefix) % address_to_label(destination);
+		if(label_mode != REFERENCE){
+			return text;
+		}
+		entry = labels.insert(destination, {text, 0});
 	}
-	QString label(b.label);
-	label.chop(2);
-	return label;
+	if(label_mode == REFERENCE){
+		entry->references++;
+	}else if(label_mode == RELEASE && --entry->references <= 0){
+		QString text = entry->text;
+		labels.erase(entry);
+		return text;
+	}
+	return entry->text;
 }
 
 QString disassembler_core::disassembly_text()
 {
-	const QString prefix[] = {"\tdb ", "\tdw ", "\tdl ", "\tdd "};
 	QString text;
-	QString table_line;
-	table_line.reserve(42);
-	for(const auto &b : disassembly_list){
-		if(!b.label.isEmpty() || table_line.length() > 42){
-			table_line.chop(2);
-			text += table_line % '\n' % b.label;
-			table_line.clear();
-		}
-		if(b.data.isEmpty()){
-			continue;
-		}
-		switch(b.format){
-			case block::CODE:
-				text += (label_id > 0 ? "\t" : "") % b.data % '\n';
-			break;
-			case block::DATA_PACKED ... block::DATA_PACKED_END:
-				if(table_line.isEmpty()){
-					table_line = prefix[b.format - block::DATA_PACKED];
-				}
-				table_line += b.data % ", ";
-			break;
-			case block::DATA_UNPACKED ... block::DATA_UNPACKED_END:
-				text += prefix[b.format - block::DATA_UNPACKED] % b.data % '\n';
-			break;
-			case block::DATA_STRING:
-				text += prefix[0] % '"' % b.data % "\"\n";
-			break;
-			default:
-				qDebug() << "Unknown formatter" << b.format;
-			break;
-		}
+	for(int i = 0; i < rows.size(); i++){
+		text += format_line(i) % '\n';
 	}
 	return text;
 }
 
 void disassembler_core::reset()
 {
-	disassembly_list.clear();
+	lines.clear();
+	rows.clear();
+	labels.clear();
+	table_sizes.clear();
 	error.clear();
-	label_id = 0;
 	delta = 0;
 }
 
-void disassembler_core::decode_name_args(QString &name)
+unsigned int disassembler_core::read_operand(int size, int offset)
 {
-	int length = name.length();
-	QString encoded = name;
-	name.clear();
-	for(int i = 0; i < length; i++){
-		int size = 0;
-		if(encoded[i] != '%'){
-			name += encoded[i];
-		}else{
-			char arg = encoded.at(++i).toLatin1();
-			name += decode_name_arg(arg, size);
-			delta += size;
-		}
+	unsigned int operand = 0;
+	for(int i = 0; i < size && delta + offset + i < data.size(); i++){
+		operand |= (unsigned char)data.at(delta + offset + i) << (i * 8);
 	}
+	return operand;
 }
 
-unsigned int disassembler_core::get_instruction()
+void disassembler_core::append(const char *text)
 {
-	return (unsigned int)data.at(delta-1);
+	while(*text && line_length < line_size){
+		line_buffer[line_length++] = *text++;
+	}
 }
 
-unsigned int disassembler_core::get_operand(int n)
+void disassembler_core::append(const QString &text)
 {
-	return delta+n < data.size() ? ((unsigned char)data.at(delta+n) << n*8) : 0;
+	for(int i = 0; i < text.length() && line_length < line_size; i++){
+		line_buffer[line_length++] = text.at(i).toLatin1();
+	}
+}
+
+void disassembler_core::append_hex(unsigned int value, int digits)
+{
+	static const char hex_digits[] = "0123456789ABCDEF";
+	if(line_length + digits > line_size){
+		return;
+	}
+	for(int i = digits - 1; i >= 0; i--){
+		line_buffer[line_length + i] = hex_digits[value & 0x0F];
+		value >>= 4;
+	}
+	line_length += digits;
+}
+
+//Labels the SNES address if it lies in the disassembled range or has a symbol, otherwise prints the operand
+void disassembler_core::append_label(int target, unsigned int operand, int digits)
+{
+	int address = buffer->snes_to_pc(target);
+	if(!in_range(address)){
+		const char *symbol = buffer->get_symbols().find(target);
+		if(symbol){
+			append(symbol);
+			return;
+		}
+		append('$');
+		append_hex(operand, digits);
+		return;
+	}
+	append(add_label(address));
 }
 
 bool disassembler_core::in_range(int address)
@@ -126,10 +236,177 @@ bool disassembler_core::in_range(int address)
 	return region.get_start_byte() < address && region.get_end_byte() > address;
 }
 
-void disassembler_core::add_data(int destination, QString data, block::data_format format)
+unsigned int disassembler_core::table_value(int offset, int width)
+{
+	unsigned int value = 0;
+	for(int i = width; i >= 0; i--){
+		if(offset + i < data.size()){
+			value |= (unsigned char)data.at(offset + i) << (i * 8);
+		}
+	}
+	return value;
+}
+
+int disassembler_core::table_width(const line &l)
 {
-	disassembly_list[get_base()+destination].data = data;
-	disassembly_list[get_base()+destination].format = format;
+	return l.format - (l.format >= line::DATA_UNPACKED ? line::DATA_UNPACKED : line::DATA_PACKED);
+}
+
+void disassembler_core::index_next()
+{
+	const code_map &analysis = get_analysis();
+	const bookmark_data *found = buffer->get_bookmarks().at(get_base() + delta);
+	if(found){
+		const bookmark_data &bookmark = *found;
+		if(bookmark.data_type & bookmark_data::CODE && !(bookmark.data_type & bookmark_data::UNKNOWN)){
+			set_flags(bookmark.data_type);
+		}else if(!(bookmark.data_type & bookmark_data::CODE)){
+			disassemble_table(bookmark);
+			return;
+		}
+	}else if(buffer->is_rats_tag(region.get_start_byte() + delta) && 
+	         delta + 8 < data.size()){
+		disassemble_rats();
+		return;
+	}else if(analysis.is_opcode(region.get_start_byte() + delta)){
+		apply_analysis(analysis.at(region.get_start_byte() + delta));
+	}
+	disassemble_code();
+}
+
+void disassembler_core::apply_analysis(unsigned char state)
+{
+	set_flags((bookmark_data::types)(bookmark_data::CODE | 
+	          ((state & code_map::A_16) ? bookmark_data::A : 0) |
+	          ((state & code_map::I_16) ? bookmark_data::I : 0)));
+}
+
+//Decodes from the line holding the first changed byte until the new instructions line up with the old ones
+void disassembler_core::redisassemble(int first, int last, const QByteArray &current)
+{
+	auto start_line = std::upper_bound(lines.begin(), lines.end(), first, 
+	                                   [](int target, const line &l){ return target < l.delta; });
+	int start = qMax((int)(start_line - lines.begin()) - 1, 0);
+	while(start > 0 && lines.at(start).format != line::CODE){
+		start--; //Tables and RATS tags are only recognized from their first line
+	}
+	
+	QVector<line> tail = lines.mid(start);
+	lines.resize(start);
+	QHash<int, int> old_sizes; //Tables indexed again at the same delta would replace these
+	for(const line &l : tail){
+		if(table_sizes.contains(l.delta)){
+			old_sizes.insert(l.delta, table_sizes.take(l.delta));
+		}
+	}
+	QByteArray previous = data;
+	data = current;
+	unsigned char end_state = get_state();
+	delta = tail.first().delta;
+	set_state(tail.first().state);
+	
+	label_mode = REFERENCE;
+	int old_index = 0;
+	bool synchronized = false;
+	while(delta < data.size() && error.isEmpty()){
+		while(old_index < tail.size() && tail.at(old_index).delta < delta){
+			old_index++;
+		}
+		if(delta > last && old_index < tail.size() && tail.at(old_index).delta == delta && 
+		   tail.at(old_index).state == get_state()){
+			synchronized = true;
+			break;
+		}
+		index_next();
+	}
+	if(!synchronized){
+		old_index = tail.size();
+		end_state = get_state();
+	}
+	
+	//The replaced lines release their labels against the bytes they were decoded from
+	data.swap(previous);
+	label_mode = RELEASE;
+	for(int i = 0; i < old_index; i++){
+		release_line(tail.at(i), old_sizes);
+	}
+	for(auto size = old_sizes.constBegin(); size != old_sizes.constEnd(); size++){
+		table_sizes.insert(size.key(), size.value());
+	}
+	data.swap(previous);
+	label_mode = LOOKUP;
+	
+	lines += tail.mid(old_index);
+	set_state(end_state);
+	merge_labels();
+	update_state();
+}
+
+//Tables and RATS tags drop the labels they added from their first line
+void disassembler_core::release_line(const line &l, QHash<int, int> &old_sizes)
+{
+	delta = l.delta;
+	line_length = 0;
+	if(l.format == line::CODE){
+		set_state(l.state);
+		delta++;
+		decode(data.at(l.delta));
+		return;
+	}
+	if(l.is_pointer){
+		int width = table_width(l);
+		for(int i = 0; i < l.count; i++){
+			format_data_value(width, table_value(l.delta + i * (width + 1), width), true);
+		}
+	}
+	if(old_sizes.contains(l.delta)){
+		add_label(get_base() + l.delta);
+		add_label(get_base() + l.delta + old_sizes.take(l.delta));
+	}else if(l.format == line::DATA_STRING){
+		add_label(get_base() + l.delta, "RATS_tag_");
+		add_label(get_base() + l.delta + 8, "RATS_start_");
+		add_label(get_base() + l.delta + 8 + read_word(data, l.delta + 4) + 1, "RATS_end_");
+	}
+}
+
+//Labels are found out of order, so they're slotted in front of their lines once everything is indexed
+void disassembler_core::merge_labels()
+{
+	rows.clear();
+	rows.reserve(lines.size() + labels.size() + 1);
+	auto label = labels.constBegin();
+	for(line current : lines){
+		int width = current.format >= line::DATA_PACKED && current.format <= line::DATA_PACKED_END ? 
+		            table_width(current) + 1 : 0;
+		while(label != labels.constEnd() && label.key() - get_base() <= current.delta){
+			rows.append({label.key() - get_base(), 0, line::LABEL, 0, false});
+			label++;
+		}
+		
+		//Packed lines get split where a label points inside of them
+		while(width && label != labels.constEnd() && 
+		      label.key() - get_base() < current.delta + current.count * width){
+			int entries = (label.key() - get_base() - current.delta + width - 1) / width;
+			if(entries){
+				line split = current;
+				split.count = entries;
+				rows.append(split);
+				current.delta += entries * width;
+				current.count -= entries;
+			}
+			rows.append({label.key() - get_base(), 0, line::LABEL, 0, false});
+			label++;
+		}
+		if(current.count){
+			rows.append(current);
+		}
+	}
+	for(; label != labels.constEnd(); label++){
+		rows.append({label.key() - get_base(), 0, line::LABEL, 0, false});
+	}
+	if(!error.isEmpty()){
+		rows.append({delta, 0, line::ERROR_TEXT, 0, false});
+	}
 }
 
 void disassembler_core::disassemble_table(const bookmark_data &bookmark)
@@ -139,24 +416,31 @@ void disassembler_core::disassemble_table(const bookmark_data &bookmark)
 		    (bookmark.data_type & bookmark_data::WORD) ? 1 :
 	            (bookmark.data_type & bookmark_data::LONG) ? 2 :
 	                                                         3 ; //double
+	int per_line = packed ? qMax(8 / (width + 1), 2) : 1;
+	int entries = (bookmark.size + width) / (width + 1);
+	unsigned char format = (packed ? line::DATA_PACKED : line::DATA_UNPACKED) + width;
 	add_label(get_base() + delta);
-	add_label(get_base() + delta + bookmark.size, "\nlabel_");
-	for(int i = 0; i < bookmark.size && i + delta < data.size(); i += width + 1){
-		unsigned int table_value = 0;
-		for(int j = width; j >= 0 && (i + j + delta) < data.size(); j--){
-			table_value |= (unsigned char)data.at(delta+i+j) << (j * 8);
+	add_label(get_base() + delta + bookmark.size);
+	if(label_mode == REFERENCE){
+		table_sizes.insert(delta, bookmark.size);
+	}
+	for(int i = 0; i < entries && i * (width + 1) + delta < data.size(); i += per_line){
+		int offset = delta + i * (width + 1);
+		int count = qMin(per_line, entries - i);
+		//Pointers have to be labeled while indexing so the labels are known before anything is shown
+		for(int j = 0; bookmark.data_is_pointer && j < count; j++){
+			format_data_value(width, table_value(offset + j * (width + 1), width), true);
 		}
-		add_data(delta + i, format_data_value(width, table_value, bookmark.data_is_pointer),
-			  (block::data_format)((packed ? block::DATA_PACKED : block::DATA_UNPACKED) + width));
+		lines.append({offset, (unsigned short)count, format, get_state(), bookmark.data_is_pointer});
 	}
 	delta += bookmark.size;
 }
 
 void disassembler_core::disassemble_rats()
 {
-	add_data(delta, "STAR", block::DATA_STRING);
-	add_data(delta + 4, to_hex(read_word(data, delta + 4), 4), block::DATA_UNPACKED_WORD);
-	add_data(delta + 6, to_hex(read_word(data, delta + 6), 4), block::DATA_UNPACKED_WORD);
+	lines.append({delta, 4, line::DATA_STRING, get_state(), false});
+	lines.append({delta + 4, 1, line::DATA_UNPACKED_WORD, get_state(), false});
+	lines.append({delta + 6, 1, line::DATA_UNPACKED_WORD, get_state(), false});
 	
 	add_label(get_base() + delta, "RATS_tag_");
 	delta += 8;
@@ -168,13 +452,14 @@ void disassembler_core::disassemble_code()
 {
 	int opcode_address = delta;
 	unsigned char hex = data.at(delta);
-	disassembler_core::opcode op = get_opcode(hex);	
 	if(abort_unlikely(hex)){
 		error = "Unlikely opcode detected, aborting!";
 	}
+	unsigned char state = get_state();
 	delta++;
-	decode_name_args(op.name);
-	add_data(opcode_address, op.name, block::CODE);
+	line_length = 0;
+	decode(hex);
+	lines.append({opcode_address, 1, line::CODE, state, false});
 	
 	if(delta > data.size()){
 		error = "Disassembly range too small, last opcode may be invalid.";
@@ -2,6 +2,7 @@
 #define DISASSEMBLER_CORE_H
 
 #include <QGridLayout>
+#include <QHash>
 
 #include "rom_buffer.h"
 #include "selection.h"
@@ -11,56 +12,103 @@ class disassembler_core : public QObject
 	Q_OBJECT
 	public:
 		struct opcode{
-			QString name;
+			unsigned char mnemonic;
+			unsigned char mode;
 		};
 		using QObject::QObject;
 		virtual QGridLayout *core_layout() = 0;
-		virtual QString disassemble(selection selection_area, const ROM_buffer *b);
+		virtual void disassemble(selection selection_area, const ROM_buffer *b);
+		bool refresh();
+		int line_count() const { return rows.size(); }
+		QString format_line(int row);
+		int find_line(int offset);
+		int find_instruction(int offset);
+		int line_offset(int row);
+		QString disassembly_text();
 		
 	protected:
 		QByteArray data;
 		selection region;
-		const ROM_buffer *buffer;
+		const ROM_buffer *buffer = nullptr;
 		int delta;
 		QString error;
 		
 		QString add_label(int destination, QString prefix = "");
-		QString disassembly_text();
 		void reset();
-		void decode_name_args(QString &name);
-		unsigned int get_instruction();
-		unsigned int get_operand(int n);
+		unsigned int read_operand(int size, int offset = 0);
 		bool in_range(int address);
 		
-		virtual QString decode_name_arg(const char arg, int &size) = 0;
+		//Instructions are formatted into a fixed line buffer and converted to a string once
+		void append(char c){ if(line_length < line_size){ line_buffer[line_length++] = c; } }
+		void append(const char *text);
+		void append(const QString &text);
+		void append_hex(unsigned int value, int digits);
+		void append_label(int target, unsigned int operand, int digits);
+		
+		virtual void decode(unsigned char op) = 0;
 		virtual QString address_to_label(int address) = 0;
+		virtual int symbol_address(int address) = 0;
 		virtual QString format_data_value(int size, int value, bool is_pointer) = 0;
-		virtual opcode get_opcode(int op) = 0;
 		virtual int get_base() = 0;
 		virtual bool abort_unlikely(int op) = 0;
 		virtual void update_state() = 0;
 		virtual void set_flags(bookmark_data::types flags) = 0;
+		virtual unsigned char get_state() = 0;
+		virtual void set_state(unsigned char state) = 0;
+		
+		//Hints from a whole ROM analysis, the 65c816 one unless a core has its own
+		virtual const code_map &get_analysis(){ return buffer->get_code_map(); }
+		virtual void apply_analysis(unsigned char state);
 		
 	private:
-		struct block{
-			enum data_format{
+		//One entry per displayed line, the text itself is only produced by format_line
+		struct line{
+			enum line_format{
 				CODE = 0,
 				DATA_PACKED = 1,
 				DATA_PACKED_END = 4,
 				DATA_UNPACKED = 5,
 				DATA_UNPACKED_WORD = DATA_UNPACKED + 1,
-				DATA_UNPACKED_END = 9,
-				DATA_STRING = 10
+				DATA_UNPACKED_END = 8,
+				DATA_STRING = 10,
+				LABEL = 11,
+				ERROR_TEXT = 12
 			};
-			QString label = "";
-			QString data = "";
-			data_format format;
+			int delta;
+			unsigned short count;
+			unsigned char format;
+			unsigned char state;
+			bool is_pointer;
 		};
-
-		QMap<int, block> disassembly_list;
-		int label_id;
 		
-		void add_data(int destination, QString data, block::data_format format);
+		struct label{
+			QString text;
+			int references;
+		};
+		
+		enum label_modes{
+			LOOKUP,
+			REFERENCE,
+			RELEASE
+		};
+		
+		static const int line_size = 80;
+		
+		QVector<line> lines;
+		QVector<line> rows;
+		QMap<int, label> labels;
+		QHash<int, int> table_sizes; //By the delta of each table's first line, so its labels can be released
+		label_modes label_mode = LOOKUP;
+		unsigned char initial_state = 0;
+		char line_buffer[line_size];
+		int line_length = 0;
+		
+		unsigned int table_value(int offset, int width);
+		int table_width(const line &l);
+		void index_next();
+		void redisassemble(int first, int last, const QByteArray &current);
+		void release_line(const line &l, QHash<int, int> &old_sizes);
+		void merge_labels();
 		void disassemble_table(const bookmark_data &bookmark);
 		void disassemble_rats();
 		void disassemble_code();
@@ -22,68 +22,68 @@ QGridLayout *isa_65c816::core_layout()
 	return grid;
 }
 
-template <typename V> 
-QString isa_65c816::label_op(int offset, int size, V validator)
+const isa_65c816::mode_format isa_65c816::mode_formats[isa_65c816::MODE_COUNT] = {
+	{0, "", ""}, {0, " A", ""}, {1, " #$", ""}, {1, " #$", ""}, {1, " #$", ""},
+	{1, " $", ""}, {1, " $", ",X"}, {1, " $", ",Y"}, {1, " ($", ")"}, {1, " ($", ",X)"}, {1, " ($", "),Y"},
+	{1, " [$", "]"}, {1, " [$", "],Y"}, {1, " $", ",S"}, {1, " ($", ",S),Y"},
+	{1, " ", ""}, {2, " ", ""}, {2, " $", ""}, {2, " $", ",X"}, {2, " $", ",Y"}, {2, " ", ""},
+	{2, " (", ")"}, {2, " (", ",X)"}, {2, " [", "]"}, {2, " $", ""},
+	{3, " $", ""}, {3, " $", ",X"}, {3, " ", ""}
+};
+
+int isa_65c816::operand_size(unsigned char op, bool A_state, bool I_state)
 {
-	QByteArray little_endian = QByteArray::fromHex(QByteArray(to_hex(offset, size).toLatin1()));
-	int address = buffer->snes_to_pc((buffer->*validator)(delta * 2 + get_base(), little_endian));
-	if(!in_range(address)){
-		return '$' + to_hex(offset, size);
-	}
-	return add_label(address);
+	unsigned char mode = opcode_list[op].mode;
+	return mode == IMMEDIATE_M ? 1 + A_state :
+	       mode == IMMEDIATE_X ? 1 + I_state :
+	                             mode_formats[mode].size;
 }
 
-QString isa_65c816::decode_name_arg(const char arg, int &size)
+void isa_65c816::decode(unsigned char op)
 {
-	QString decode;
-	decode.reserve(7);
-	unsigned int operand = get_operand(0) | get_operand(1) | get_operand(2);
-	switch(arg){
-		case 'l':
-			size += 3;
-			return "$" + to_hex(operand & 0xFFFFFF, 6);
-		case 'w':
-			size += 2;
-			return "$" + to_hex(operand & 0x00FFFF, 4);
-		case 'b':
-			size++;
-			return "$" + to_hex(operand & 0x0000FF, 2);	
-		case 'r':
-			size++;
-			return label_op(operand & 0x0000FF, 2, &ROM_buffer::branch_address);
-		case 'R':
-			size += 2;
-			return label_op(operand & 0x00FFFF, 4, &ROM_buffer::branch_address);
-		case 'j':
-			size += 2;
-			return label_op(operand & 0x00FFFF, 4, &ROM_buffer::jump_address);
-		case 'J':
-			size += 3;
-			return label_op(operand & 0xFFFFFF, 6, &ROM_buffer::jump_address);
-		case 'a':
-			size += 1 + A_state;
-			if(A_state){
-				return "#$" + to_hex(operand & 0x00FFFF, 4);	
-			}else{
-				return "#$" + to_hex(operand & 0x0000FF, 2);	
-			}
-		case 'i':
-			size += 1 + I_state;
-			if(I_state){
-				return "#$" + to_hex(operand & 0x00FFFF, 4);	
-			}else{
-				return "#$" + to_hex(operand & 0x0000FF, 2);	
-			}
-		case 'f':
-			A_state = (operand & 0x20) ? data.at(delta-1) == (char)0xC2 : A_state;
-			I_state = (operand & 0x10) ? data.at(delta-1) == (char)0xC2 : I_state;
-		case 'c':
-			size++;
-			return "#$" + to_hex(operand & 0x0000FF, 2);	
+	const opcode &entry = opcode_list[op];
+	int size = operand_size(op, A_state, I_state);
+	unsigned int operand = read_operand(size);
+	int address = buffer->pc_to_snes(get_base() + delta);
+	int bank = address & 0xFF0000;
+	
+	append(mnemonic_names[entry.mnemonic]);
+	append(mode_formats[entry.mode].prefix);
+	switch(entry.mode){
+		case IMPLIED:
+		case ACCUMULATOR:
+		break;
+		case RELATIVE:
+			append_label(bank | ((address + 1 + (char)operand) & 0xFFFF), operand, 2);
+		break;
+		case RELATIVE_LONG:
+			append_label(bank | ((address + 2 + (short)operand) & 0xFFFF), operand, 4);
+		break;
+		case ABSOLUTE_JUMP:
+		case ABSOLUTE_INDIRECT:
+		case ABSOLUTE_X_INDIRECT:
+		case ABSOLUTE_INDIRECT_LONG:
+			append_label(bank | operand, operand, 4);
+		break;
+		case LONG_JUMP:
+			append_label(operand, operand, 6);
+		break;
+		case BLOCK_MOVE:
+			append_hex(operand >> 8, 2);
+			append(",$");
+			append_hex(operand & 0xFF, 2);
+		break;
 		default:
-			qFatal("Invalid name decode arg");
+			append_hex(operand, size * 2);
+		break;
+	}
+	append(mode_formats[entry.mode].suffix);
+	
+	if(op == 0xC2 || op == 0xE2){
+		A_state = (operand & 0x20) ? op == 0xC2 : A_state;
+		I_state = (operand & 0x10) ? op == 0xC2 : I_state;
 	}
-	return "";
+	delta += size;
 }
 
 QString isa_65c816::address_to_label(int address)
@@ -95,14 +95,13 @@ QString isa_65c816::format_data_value(int size, int value, bool is_pointer)
 {
 	if(!is_pointer){
 		return '$' + to_hex(value, (size+1)*2);
-	}else{
-		return label_op(value, (size+1)*2, &ROM_buffer::jump_address);
 	}
-}
-
-disassembler_core::opcode isa_65c816::get_opcode(int op)
-{
-	return opcode_list[op];
+	int bank = buffer->pc_to_snes(get_base() + delta) & 0xFF0000;
+	int address = buffer->snes_to_pc(size >= 2 ? value : bank | value);
+	if(!in_range(address)){
+		return '$' + to_hex(value, (size+1)*2);
+	}
+	return add_label(address);
 }
 
 int isa_65c816::get_base()
@@ -134,263 +133,48 @@ isa_65c816::~isa_65c816()
 	delete set_I;
 }
 
-const QList<disassembler_core::opcode> isa_65c816::opcode_list = {
-        {"BRK %c"},
-	{"ORA (%b,X)"},
-	{"COP %c"},
-	{"ORA %b,s"},
-	{"TSB %b"},
-	{"ORA %b"},
-	{"ASL %b"},
-	{"ORA [%b]"},
-	{"PHP"},
-	{"ORA %a"},
-	{"ASL A"},
-	{"PHD"},
-	{"TSB %w"},
-	{"ORA %w"},
-	{"ASL %w"},
-	{"ORA %l"},
-	{"BPL %r"},
-	{"ORA (%b),Y"},
-	{"ORA (%b)"},
-	{"ORA (%b,S),Y"},
-	{"TRB %b"},
-	{"ORA %b,X"},
-	{"ASL %b,X"},
-	{"ORA [%b],Y"},
-	{"CLC"},
-	{"ORA %w,Y"},
-	{"INC A"},
-	{"TCS"},
-	{"TRB %w"},
-	{"ORA %w,X"},
-	{"ASL %w,X"},
-	{"ORA %l,X"},
-	{"JSR %j"},
-	{"AND (%b,X)"},
-	{"JSL %J"},
-	{"AND %b"},
-	{"BIT %b"},
-	{"AND %b"},
-	{"ROL %b"},
-	{"AND [%b]"},
-	{"PLP"},
-	{"AND %a"},
-	{"ROL A"},
-	{"PLD"},
-	{"BIT %w"},
-	{"AND %w"},
-	{"ROL %w"},
-	{"AND %l"},
-	{"BMI %r"},
-	{"AND (%b),Y"},
-	{"AND (%b)"},
-	{"AND (%b,S),Y"},
-	{"BIT %b,X"},
-	{"AND %b,X"},
-	{"ROL %b,X"},
-	{"AND [%b],Y"},
-	{"SEC"},
-	{"AND %w,Y"},
-	{"DEC A"},
-	{"TSC"},
-	{"BIT %b,X"},
-	{"AND %b,X"},
-	{"ROL %b,X"},
-	{"AND %l,X"},
-	{"RTI"},
-	{"EOR (%b,X)"},
-	{"WDM %b"},
-	{"EOR %b,S"},
-	{"MVN %w"},
-	{"EOR %b"},
-	{"LSR %b"},
-	{"EOR [%b]"},
-	{"PHA"},
-	{"EOR %a"},
-	{"LSR A"},
-	{"PHK"},
-	{"JMP %j"},
-	{"EOR %w"},
-	{"LSR %w"},
-	{"EOR %l"},
-	{"BVC %r"},
-	{"EOR (%b),Y"},
-	{"EOR (%b)"},
-	{"EOR (%b,S),Y"},
-	{"MVN %w"},
-	{"EOR %b,X"},
-	{"LSR %b,X"},
-	{"EOR [%b],Y"},
-	{"CLI"},
-	{"EOR %w,Y"},
-	{"PHY"},
-	{"TCD"},
-	{"JML %J"},
-	{"EOR %w,X"},
-	{"LSR %w,X"},
-	{"EOR %l,X"},
-	{"RTS"},
-	{"ADC (%b,X)"},
-	{"PER %w"},
-	{"ADC %b,S"},
-	{"STZ %b"},
-	{"ADC %b"},
-	{"ROR %b"},
-	{"ADC [%b]"},
-	{"PLA"},
-	{"ADC %a"},
-	{"ROR A"},
-	{"RTL"},
-	{"JMP (%j)"},
-	{"ADC %w"},
-	{"ROR %w"},
-	{"ADC %l"},
-	{"BVS %r"},
-	{"ADC (%b),Y"},
-	{"ADC (%b)"},
-	{"ADC (%b,S),Y"},
-	{"STZ %b,X"},
-	{"ADC %b,X"},
-	{"ROR %b,X"},
-	{"ADC [%b],Y"},
-	{"SEI"},
-	{"ADC %w,Y"},
-	{"PLY"},
-	{"TDC"},
-	{"JMP (%j,X)"},
-	{"ADC %w,X"},
-	{"ROR %w,X"},
-	{"ADC %l,X"},
-	{"BRA %r"},
-	{"STA (%b,X)"},
-	{"BRL %R"},
-	{"STA %b,S"},
-	{"STY %b"},
-	{"STA %b"},
-	{"STX %b"},
-	{"STA [%b]"},
-	{"DEY"},
-	{"BIT %a"},
-	{"TXA"},
-	{"PHB"},
-	{"STY %w"},
-	{"STA %w"},
-	{"STX %w"},
-	{"STA %l"},
-	{"BCC %r"},
-	{"STA (%b),Y"},
-	{"STA (%b)"},
-	{"STA (%b,S),Y"},
-	{"STY %b,X"},
-	{"STA %b,X"},
-	{"STX %b,Y"},
-	{"STA [%b],Y"},
-	{"TYA"},
-	{"STA %w,Y"},
-	{"TXS"},
-	{"TXY"},
-	{"STZ %w"},
-	{"STA %w,X"},
-	{"STZ %w,X"},
-	{"STA %l,X"},
-	{"LDY %i"},
-	{"LDA (%b,X)"},
-	{"LDX %i"},
-	{"LDA %b,S"},
-	{"LDY %b"},
-	{"LDA %b"},
-	{"LDX %b"},
-	{"LDA [%b]"},
-	{"TAY"},
-	{"LDA %a"},
-	{"TAX"},
-	{"PLB"},
-	{"LDY %w"},
-	{"LDA %w"},
-	{"LDX %w"},
-	{"LDA %l"},
-	{"BCS %r"},
-	{"LDA (%b),Y"},
-	{"LDA (%b)"},
-	{"LDA (%b,S),Y"},
-	{"LDY %b,X"},
-	{"LDA %b,X"},
-	{"LDX %b,Y"},
-	{"LDA [%b],Y"},
-	{"CLV"},
-	{"LDA %w,Y"},
-	{"TSX"},
-	{"TYX"},
-	{"LDY %w,X"},
-	{"LDA %w,X"},
-	{"LDX %w,Y"},
-	{"LDA %l,X"},
-	{"CPY %i"},
-	{"CMP (%b,X)"},
-	{"REP %f"},
-	{"CMP %b"},
-	{"CPY %b"},
-	{"CMP %b"},
-	{"DEC %b"},
-	{"CMP [%b]"},
-	{"INY"},
-	{"CMP %a"},
-	{"DEX"},
-	{"WAI"},
-	{"CPY %w"},
-	{"CMP %w"},
-	{"DEC %w"},
-	{"CMP %l"},
-	{"BNE %r"},
-	{"CMP (%b),Y"},
-	{"CMP (%b)"},
-	{"CMP (%b,S),Y"},
-	{"PEI (%b)"},
-	{"CMP %b,X"},
-	{"DEC %b,X"},
-	{"CMP [%b],Y"},
-	{"CLD"},
-	{"CMP %w,Y"},
-	{"PHX"},
-	{"STP"},
-	{"JMP [%j]"},
-	{"CMP %w,X"},
-	{"DEC %w,X"},
-	{"CMP %l,X"},
-	{"CPX %i"},
-	{"SBC (%b,X)"},
-	{"SEP %f"},
-	{"SBC %b,S"},
-	{"CPX %b"},
-	{"SBC %b"},
-	{"INC %b"},
-	{"SBC [%b]"},
-	{"INX"},
-	{"SBC %a"},
-	{"NOP"},
-	{"XBA"},
-	{"CPX %w"},
-	{"SBC %w"},
-	{"INC %w"},
-	{"SBC %l"},
-	{"BEQ %r"},
-	{"SBC (%b),Y"},
-	{"SBC (%b)"},
-	{"SBC (%b,S),Y"},
-	{"PEA %w"},
-	{"SBC %b,X"},
-	{"INC %b,X"},
-	{"SBC [%b],Y"},
-	{"SED"},
-	{"SBC %w,Y"},
-	{"PLX"},
-	{"XCE"},
-	{"JSR (%j,X)"},
-	{"SBC %w,X"},
-	{"INC %w,X"},
-	{"SBC %l,X"}
+const disassembler_core::opcode isa_65c816::opcode_list[256] = {
+	{BRK, IMMEDIATE_8}, {ORA, DIRECT_X_INDIRECT}, {COP, IMMEDIATE_8}, {ORA, STACK}, {TSB, DIRECT}, {ORA, DIRECT}, {ASL, DIRECT}, {ORA, DIRECT_INDIRECT_LONG},
+	{PHP, IMPLIED}, {ORA, IMMEDIATE_M}, {ASL, ACCUMULATOR}, {PHD, IMPLIED}, {TSB, ABSOLUTE}, {ORA, ABSOLUTE}, {ASL, ABSOLUTE}, {ORA, LONG},
+	{BPL, RELATIVE}, {ORA, DIRECT_INDIRECT_Y}, {ORA, DIRECT_INDIRECT}, {ORA, STACK_INDIRECT_Y}, {TRB, DIRECT}, {ORA, DIRECT_X}, {ASL, DIRECT_X}, {ORA, DIRECT_INDIRECT_LONG_Y},
+	{CLC, IMPLIED}, {ORA, ABSOLUTE_Y}, {INC, ACCUMULATOR}, {TCS, IMPLIED}, {TRB, ABSOLUTE}, {ORA, ABSOLUTE_X}, {ASL, ABSOLUTE_X}, {ORA, LONG_X},
+	{JSR, ABSOLUTE_JUMP}, {AND, DIRECT_X_INDIRECT}, {JSL, LONG_JUMP}, {AND, STACK}, {BIT, DIRECT}, {AND, DIRECT}, {ROL, DIRECT}, {AND, DIRECT_INDIRECT_LONG},
+	{PLP, IMPLIED}, {AND, IMMEDIATE_M}, {ROL, ACCUMULATOR}, {PLD, IMPLIED}, {BIT, ABSOLUTE}, {AND, ABSOLUTE}, {ROL, ABSOLUTE}, {AND, LONG},
+	{BMI, RELATIVE}, {AND, DIRECT_INDIRECT_Y}, {AND, DIRECT_INDIRECT}, {AND, STACK_INDIRECT_Y}, {BIT, DIRECT_X}, {AND, DIRECT_X}, {ROL, DIRECT_X}, {AND, DIRECT_INDIRECT_LONG_Y},
+	{SEC, IMPLIED}, {AND, ABSOLUTE_Y}, {DEC, ACCUMULATOR}, {TSC, IMPLIED}, {BIT, ABSOLUTE_X}, {AND, ABSOLUTE_X}, {ROL, ABSOLUTE_X}, {AND, LONG_X},
+	{RTI, IMPLIED}, {EOR, DIRECT_X_INDIRECT}, {WDM, IMMEDIATE_8}, {EOR, STACK}, {MVP, BLOCK_MOVE}, {EOR, DIRECT}, {LSR, DIRECT}, {EOR, DIRECT_INDIRECT_LONG},
+	{PHA, IMPLIED}, {EOR, IMMEDIATE_M}, {LSR, ACCUMULATOR}, {PHK, IMPLIED}, {JMP, ABSOLUTE_JUMP}, {EOR, ABSOLUTE}, {LSR, ABSOLUTE}, {EOR, LONG},
+	{BVC, RELATIVE}, {EOR, DIRECT_INDIRECT_Y}, {EOR, DIRECT_INDIRECT}, {EOR, STACK_INDIRECT_Y}, {MVN, BLOCK_MOVE}, {EOR, DIRECT_X}, {LSR, DIRECT_X}, {EOR, DIRECT_INDIRECT_LONG_Y},
+	{CLI, IMPLIED}, {EOR, ABSOLUTE_Y}, {PHY, IMPLIED}, {TCD, IMPLIED}, {JML, LONG_JUMP}, {EOR, ABSOLUTE_X}, {LSR, ABSOLUTE_X}, {EOR, LONG_X},
+	{RTS, IMPLIED}, {ADC, DIRECT_X_INDIRECT}, {PER, RELATIVE_LONG}, {ADC, STACK}, {STZ, DIRECT}, {ADC, DIRECT}, {ROR, DIRECT}, {ADC, DIRECT_INDIRECT_LONG},
+	{PLA, IMPLIED}, {ADC, IMMEDIATE_M}, {ROR, ACCUMULATOR}, {RTL, IMPLIED}, {JMP, ABSOLUTE_INDIRECT}, {ADC, ABSOLUTE}, {ROR, ABSOLUTE}, {ADC, LONG},
+	{BVS, RELATIVE}, {ADC, DIRECT_INDIRECT_Y}, {ADC, DIRECT_INDIRECT}, {ADC, STACK_INDIRECT_Y}, {STZ, DIRECT_X}, {ADC, DIRECT_X}, {ROR, DIRECT_X}, {ADC, DIRECT_INDIRECT_LONG_Y},
+	{SEI, IMPLIED}, {ADC, ABSOLUTE_Y}, {PLY, IMPLIED}, {TDC, IMPLIED}, {JMP, ABSOLUTE_X_INDIRECT}, {ADC, ABSOLUTE_X}, {ROR, ABSOLUTE_X}, {ADC, LONG_X},
+	{BRA, RELATIVE}, {STA, DIRECT_X_INDIRECT}, {BRL, RELATIVE_LONG}, {STA, STACK}, {STY, DIRECT}, {STA, DIRECT}, {STX, DIRECT}, {STA, DIRECT_INDIRECT_LONG},
+	{DEY, IMPLIED}, {BIT, IMMEDIATE_M}, {TXA, IMPLIED}, {PHB, IMPLIED}, {STY, ABSOLUTE}, {STA, ABSOLUTE}, {STX, ABSOLUTE}, {STA, LONG},
+	{BCC, RELATIVE}, {STA, DIRECT_INDIRECT_Y}, {STA, DIRECT_INDIRECT}, {STA, STACK_INDIRECT_Y}, {STY, DIRECT_X}, {STA, DIRECT_X}, {STX, DIRECT_Y}, {STA, DIRECT_INDIRECT_LONG_Y},
+	{TYA, IMPLIED}, {STA, ABSOLUTE_Y}, {TXS, IMPLIED}, {TXY, IMPLIED}, {STZ, ABSOLUTE}, {STA, ABSOLUTE_X}, {STZ, ABSOLUTE_X}, {STA, LONG_X},
+	{LDY, IMMEDIATE_X}, {LDA, DIRECT_X_INDIRECT}, {LDX, IMMEDIATE_X}, {LDA, STACK}, {LDY, DIRECT}, {LDA, DIRECT}, {LDX, DIRECT}, {LDA, DIRECT_INDIRECT_LONG},
+	{TAY, IMPLIED}, {LDA, IMMEDIATE_M}, {TAX, IMPLIED}, {PLB, IMPLIED}, {LDY, ABSOLUTE}, {LDA, ABSOLUTE}, {LDX, ABSOLUTE}, {LDA, LONG},
+	{BCS, RELATIVE}, {LDA, DIRECT_INDIRECT_Y}, {LDA, DIRECT_INDIRECT}, {LDA, STACK_INDIRECT_Y}, {LDY, DIRECT_X}, {LDA, DIRECT_X}, {LDX, DIRECT_Y}, {LDA, DIRECT_INDIRECT_LONG_Y},
+	{CLV, IMPLIED}, {LDA, ABSOLUTE_Y}, {TSX, IMPLIED}, {TYX, IMPLIED}, {LDY, ABSOLUTE_X}, {LDA, ABSOLUTE_X}, {LDX, ABSOLUTE_Y}, {LDA, LONG_X},
+	{CPY, IMMEDIATE_X}, {CMP, DIRECT_X_INDIRECT}, {REP, IMMEDIATE_8}, {CMP, STACK}, {CPY, DIRECT}, {CMP, DIRECT}, {DEC, DIRECT}, {CMP, DIRECT_INDIRECT_LONG},
+	{INY, IMPLIED}, {CMP, IMMEDIATE_M}, {DEX, IMPLIED}, {WAI, IMPLIED}, {CPY, ABSOLUTE}, {CMP, ABSOLUTE}, {DEC, ABSOLUTE}, {CMP, LONG},
+	{BNE, RELATIVE}, {CMP, DIRECT_INDIRECT_Y}, {CMP, DIRECT_INDIRECT}, {CMP, STACK_INDIRECT_Y}, {PEI, DIRECT_INDIRECT}, {CMP, DIRECT_X}, {DEC, DIRECT_X}, {CMP, DIRECT_INDIRECT_LONG_Y},
+	{CLD, IMPLIED}, {CMP, ABSOLUTE_Y}, {PHX, IMPLIED}, {STP, IMPLIED}, {JML, ABSOLUTE_INDIRECT_LONG}, {CMP, ABSOLUTE_X}, {DEC, ABSOLUTE_X}, {CMP, LONG_X},
+	{CPX, IMMEDIATE_X}, {SBC, DIRECT_X_INDIRECT}, {SEP, IMMEDIATE_8}, {SBC, STACK}, {CPX, DIRECT}, {SBC, DIRECT}, {INC, DIRECT}, {SBC, DIRECT_INDIRECT_LONG},
+	{INX, IMPLIED}, {SBC, IMMEDIATE_M}, {NOP, IMPLIED}, {XBA, IMPLIED}, {CPX, ABSOLUTE}, {SBC, ABSOLUTE}, {INC, ABSOLUTE}, {SBC, LONG},
+	{BEQ, RELATIVE}, {SBC, DIRECT_INDIRECT_Y}, {SBC, DIRECT_INDIRECT}, {SBC, STACK_INDIRECT_Y}, {PEA, ABSOLUTE}, {SBC, DIRECT_X}, {INC, DIRECT_X}, {SBC, DIRECT_INDIRECT_LONG_Y},
+	{SED, IMPLIED}, {SBC, ABSOLUTE_Y}, {PLX, IMPLIED}, {XCE, IMPLIED}, {JSR, ABSOLUTE_X_INDIRECT}, {SBC, ABSOLUTE_X}, {INC, ABSOLUTE_X}, {SBC, LONG_X}
+};
+
+const char *const isa_65c816::mnemonic_names[] = {
+	"ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRA", "BRK", "BRL", "BVC", "BVS", "CLC",
+	"CLD", "CLI", "CLV", "CMP", "COP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR", "INC", "INX", "INY", "JML", "JMP",
+	"JSL", "JSR", "LDA", "LDX", "LDY", "LSR", "MVN", "MVP", "NOP", "ORA", "PEA", "PEI", "PER", "PHA", "PHB", "PHD",
+	"PHK", "PHP", "PHX", "PHY", "PLA", "PLB", "PLD", "PLP", "PLX", "PLY", "REP", "ROL", "ROR", "RTI", "RTL", "RTS",
+	"SBC", "SEC", "SED", "SEI", "SEP", "STA", "STP", "STX", "STY", "STZ", "TAX", "TAY", "TCD", "TCS", "TDC", "TRB",
+	"TSB", "TSC", "TSX", "TXA", "TXS", "TXY", "TYA", "TYX", "WAI", "WDM", "XBA", "XCE"
 };
 
 const QSet<unsigned char> isa_65c816::unlikely = {
@@ -15,6 +15,36 @@ class isa_65c816 : public disassembler_core
 		~isa_65c816();
 		QGridLayout *core_layout();
 		static QString id(){ return "65c816"; }
+		static int operand_size(unsigned char op, bool A_state, bool I_state);
+		
+		enum mnemonics{
+			ADC, AND, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRA, BRK, BRL, BVC, BVS, CLC,
+			CLD, CLI, CLV, CMP, COP, CPX, CPY, DEC, DEX, DEY, EOR, INC, INX, INY, JML, JMP,
+			JSL, JSR, LDA, LDX, LDY, LSR, MVN, MVP, NOP, ORA, PEA, PEI, PER, PHA, PHB, PHD,
+			PHK, PHP, PHX, PHY, PLA, PLB, PLD, PLP, PLX, PLY, REP, ROL, ROR, RTI, RTL, RTS,
+			SBC, SEC, SED, SEI, SEP, STA, STP, STX, STY, STZ, TAX, TAY, TCD, TCS, TDC, TRB,
+			TSB, TSC, TSX, TXA, TXS, TXY, TYA, TYX, WAI, WDM, XBA, XCE
+		};
+		
+		enum modes{
+			IMPLIED, ACCUMULATOR, IMMEDIATE_8, IMMEDIATE_M, IMMEDIATE_X,
+			DIRECT, DIRECT_X, DIRECT_Y, DIRECT_INDIRECT, DIRECT_X_INDIRECT, DIRECT_INDIRECT_Y,
+			DIRECT_INDIRECT_LONG, DIRECT_INDIRECT_LONG_Y, STACK, STACK_INDIRECT_Y,
+			RELATIVE, RELATIVE_LONG, ABSOLUTE, ABSOLUTE_X, ABSOLUTE_Y, ABSOLUTE_JUMP,
+			ABSOLUTE_INDIRECT, ABSOLUTE_X_INDIRECT, ABSOLUTE_INDIRECT_LONG, BLOCK_MOVE,
+			LONG, LONG_X, LONG_JUMP, MODE_COUNT
+		};
+		
+		//Operand size, text before the operand and text after it for every addressing mode
+		struct mode_format{
+			unsigned char size;
+			const char *prefix;
+			const char *suffix;
+		};
+		
+		static const opcode opcode_list[256];
+		static const mode_format mode_formats[MODE_COUNT];
+		static const char *mnemonic_name(unsigned char mnemonic){ return mnemonic_names[mnemonic]; }
 		
 	signals:
 		void A_changed(bool);
@@ -26,15 +56,16 @@ class isa_65c816 : public disassembler_core
 		void toggle_error_stop(bool state){ error_stop = state; }
 
 	protected:
-		QString decode_name_arg(const char arg, int &size);
+		void decode(unsigned char op);
 		QString address_to_label(int address);
+		int symbol_address(int address){ return buffer->pc_to_snes(address); }
 		QString format_data_value(int size, int value, bool is_pointer);
-		template <typename V> QString label_op(int offset, int size, V validator);
-		opcode get_opcode(int op);
 		int get_base();
 		bool abort_unlikely(int op);
 		void update_state();
 		void set_flags(bookmark_data::types type);
+		unsigned char get_state(){ return A_state | I_state << 1; }
+		void set_state(unsigned char state){ A_state = state & 1; I_state = state & 2; }
 	private:		
 		bool A_state = false;
 		bool I_state = false;
@@ -42,7 +73,7 @@ class isa_65c816 : public disassembler_core
 		QCheckBox *set_A = new QCheckBox("16 bit A");
 		QCheckBox *set_I = new QCheckBox("16 bit I");
 		QCheckBox *stop = new QCheckBox("Stop on unlikely");
-		static const QList<disassembler_core::opcode> opcode_list;
+		static const char *const mnemonic_names[];
 		static const QSet<unsigned char> unlikely;
 };
 
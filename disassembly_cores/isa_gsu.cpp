@@ -18,46 +18,81 @@ QGridLayout *isa_gsu::core_layout()
 	return grid;
 }
 
-template <typename V> 
-QString isa_gsu::label_op(int offset, int size, V validator)
+static const unsigned char mode_sizes[isa_gsu::MODE_COUNT] = {0, 0, 0, 0, 0, 1, 1, 2, 1, 2, 0};
+
+int isa_gsu::operand_size(unsigned char op, int alt)
 {
-	QByteArray little_endian = QByteArray::fromHex(QByteArray(to_hex(offset, size).toLatin1()));
-	int address = buffer->snes_to_pc((buffer->*validator)(delta * 2 + get_base(), little_endian));
-	if(!in_range(address)){
-		return '$' + to_hex(offset, size);
+	return mode_sizes[opcode_list[alt][op].mode];
+}
+
+void isa_gsu::decode(unsigned char op)
+{
+	const opcode &entry = opcode_list[alt_state][op];
+	int size = mode_sizes[entry.mode];
+	unsigned int operand = read_operand(size);
+	int address = buffer->pc_to_snes(get_base() + delta);
+	
+	append(mnemonic_names[entry.mnemonic]);
+	switch(entry.mode){
+		case IMPLIED:
+		break;
+		case REGISTER:
+		case PREFIX:
+			append(' ');
+			append_register(op & 0x0F);
+		break;
+		case REGISTER_INDIRECT:
+			append(" (");
+			append_register(op & 0x0F);
+			append(')');
+		break;
+		case IMMEDIATE:
+			append(" #");
+			append_number(op & 0x0F);
+		break;
+		case RELATIVE:
+			append(' ');
+			append_label((address & 0xFF0000) | ((address + 1 + (char)operand) & 0xFFFF), operand, 2);
+		break;
+		case REGISTER_BYTE:
+		case REGISTER_WORD:
+			append(' ');
+			append_register(op & 0x0F);
+			append(",#$");
+			append_hex(operand, size * 2);
+		break;
+		case REGISTER_SHORT_ADDRESS:
+		case REGISTER_ADDRESS:
+			append(' ');
+			append_register(op & 0x0F);
+			append(",($");
+			append_hex(entry.mode == REGISTER_SHORT_ADDRESS ? operand << 1 : operand, 4);
+			append(')');
+		break;
+		case ALTERNATE:
+			alt_state = op - 0x3C;
+		return;
 	}
-	return add_label(address);
+	
+	//The ALT state lasts until the next instruction which isn't a prefix
+	if(entry.mode != PREFIX){
+		alt_state = 0;
+	}
+	delta += size;
 }
 
-QString isa_gsu::decode_name_arg(const char arg, int &size)
+void isa_gsu::append_register(int reg)
 {
-	QString decode;
-	decode.reserve(7);
-	unsigned int operand = get_operand(0) | get_operand(1) | get_operand(2);
-	switch(arg){
-		case 'W':
-			size += 2;
-			return to_hex((operand & 0x00FFFF) << 1, 4);
-		case 'w':
-			size += 2;
-			return to_hex(operand & 0x00FFFF, 4);
-		case 'b':
-			size++;
-			return to_hex(operand & 0x0000FF, 2);	
-		case 'r':
-			size++;
-			return label_op(operand & 0x0000FF, 2, &ROM_buffer::branch_address);
-		case 'o':
-			return QString::number(get_instruction() & 0x0F);
-		case '1':
-		case '2':
-		case '3':
-			alt_state = arg - '0';
-			return "";
-		default:
-			qFatal("Invalid name decode arg");
+	append('r');
+	append_number(reg);
+}
+
+void isa_gsu::append_number(int value)
+{
+	if(value >= 10){
+		append('1');
 	}
-	return "";
+	append((char)('0' + value % 10));
 }
 
 QString isa_gsu::address_to_label(int address)
@@ -69,18 +104,13 @@ QString isa_gsu::format_data_value(int size, int value, bool is_pointer)
 {
 	if(!is_pointer){
 		return '$' + to_hex(value, (size+1)*2);
-	}else{
-		return label_op(value, (size+1)*2, &ROM_buffer::jump_address);
 	}
-}
-
-disassembler_core::opcode isa_gsu::get_opcode(int op)
-{
-	if(alt_state && alt_states[alt_state]->contains(op)){
-		int alt = alt_state;
-		return alt_states[(alt_state = 0), alt]->value(op);
+	int bank = buffer->pc_to_snes(get_base() + delta) & 0xFF0000;
+	int address = buffer->snes_to_pc(size >= 2 ? value : bank | value);
+	if(!in_range(address)){
+		return '$' + to_hex(value, (size+1)*2);
 	}
-	return opcode_list[op];
+	return add_label(address);
 }
 
 int isa_gsu::get_base()
@@ -104,143 +134,154 @@ isa_gsu::~isa_gsu()
 	delete set_alt;
 }
 
-#define OP1(O) {O}
-#define OP2(O) OP1(O), OP1(O)
-#define OP4(O) OP2(O), OP2(O)
-#define OP6(O) OP4(O), OP2(O)
-#define OP12(O) OP6(O), OP6(O)
-#define OP15(O) OP12(O), OP2(O), OP1(O)
-#define OP16(O) OP12(O), OP4(O)
-
-const QList<disassembler_core::opcode> isa_gsu::opcode_list = {
-	OP1 ("stop"),
-	OP1 ("nop"),
-	OP1 ("cache"),
-	OP1 ("lsr"),
-	OP1 ("rol"),
-	OP1 ("bra %r"),
-	OP1 ("blt %r"),
-	OP1 ("bge %r"),
-	OP1 ("bne %r"),
-	OP1 ("beq %r"),
-	OP1 ("bpl %r"),
-	OP1 ("bmi %r"),
-	OP1 ("bcc %r"),
-	OP1 ("bcs %r"),
-	OP1 ("bvc %r"),
-	OP1 ("bvs %r"),
-	OP16("to r%o"),
-	OP16("with r%o"),
-	OP12("stw (r%o)"),
-	OP1 ("loop"),
-	OP1 ("%1"),
-	OP1 ("%2"),
-	OP1 ("%3"),
-	OP12("ldw (r%o)"),
-	OP1 ("plot"),
-	OP1 ("swap"),
-	OP1 ("color"),
-	OP1 ("not"),
-	OP16("add r%o"),
-	OP16("sub r%o"),
-	OP1 ("merge"),
-	OP15("and r%o"),
-	OP16("mult r%o"),
-	OP1 ("sbk"),
-	OP4 ("link #%o"),
-	OP1 ("sex"),
-	OP1 ("asr"),
-	OP1 ("ror"),
-	OP6 ("jmp r%o"),
-	OP1 ("lob"),
-	OP1 ("fmult"),
-	OP16("ibt r%o,#$%b"),
-	OP16("from r%o"),
-	OP1 ("hib"),
-	OP15("or r%o"),
-	OP15("inc r%o"),
-	OP1 ("getc"),
-	OP15("dec r%o"),
-	OP1 ("getb"),
-	OP16("iwt r%o,#$%w")
-};
-
-#undef OP1
-#undef OP2
-#undef OP4
-#undef OP6
-#undef OP12
-#undef OP15
-#undef OP16
-
-#define OP1(I, O) {I, {O}}
-#define OP2(I, O) OP1(I, O), OP1(I + 1, O)
-#define OP4(I, O) OP2(I, O), OP2(I + 2, O)
-#define OP6(I, O) OP4(I, O), OP2(I + 4, O)
-#define OP12(I, O) OP6(I, O), OP6(I + 6, O)
-#define OP15(I, O) OP12(I, O), OP2(I + 12, O), {I+14, {O}}
-#define OP16(I, O) OP12(I, O), OP4(I + 12, O)
-
-const QMap<unsigned char, disassembler_core::opcode> isa_gsu::alt1 = {
-	OP12(0x30, "stb (r%o)"),
-	OP12(0x40, "ldb (r%o)"),
-	OP1 (0x4C, "rpix"),
-	OP1 (0x4E, "cmode"),
-	OP16(0x50, "adc r%o"),
-	OP16(0x60, "sbc r%o"),
-	OP15(0x71, "bic r%o"),
-	OP16(0x80, "umult r%o"),
-	OP1 (0x96, "div2"),
-	OP6 (0x98, "ljmp r%o"),
-	OP1 (0x9F, "lmult"),
-	OP16(0xA0, "lms r%o,(#$%W)"),
-	OP1 (0xC0, "hib"),
-	OP15(0xC1, "xor r%o"),
-	OP1 (0xEF, "getbh"),
-	OP16(0xF0, "lm r%o")
-};
-
-const QMap<unsigned char, disassembler_core::opcode> isa_gsu::alt2 = {
-	OP16(0x50, "add #%o"),
-	OP16(0x60, "sub #%o"),
-	OP15(0x71, "and #%o"),
-	OP16(0x80, "mult #%o"),
-	OP16(0xA0, "sms r%o,(#$%W)"),
-	OP1 (0xC0, "hib"),
-	OP15(0xC1, "or #%o"),
-	OP1 (0xDF, "ramb"),
-	OP1 (0xEF, "getbl"), 
-	OP16(0xF0, "sm r%o")
+const disassembler_core::opcode isa_gsu::opcode_list[4][256] = {
+	{ //ALT0
+		{STOP, IMPLIED}, {NOP, IMPLIED}, {CACHE, IMPLIED}, {LSR, IMPLIED}, {ROL, IMPLIED}, {BRA, RELATIVE}, {BLT, RELATIVE}, {BGE, RELATIVE},
+		{BNE, RELATIVE}, {BEQ, RELATIVE}, {BPL, RELATIVE}, {BMI, RELATIVE}, {BCC, RELATIVE}, {BCS, RELATIVE}, {BVC, RELATIVE}, {BVS, RELATIVE},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT},
+		{STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {LOOP, IMPLIED}, {ALT1, ALTERNATE}, {ALT2, ALTERNATE}, {ALT3, ALTERNATE},
+		{LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT},
+		{LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {PLOT, IMPLIED}, {SWAP, IMPLIED}, {COLOR, IMPLIED}, {NOT, IMPLIED},
+		{ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER},
+		{ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER}, {ADD, REGISTER},
+		{SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER},
+		{SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER}, {SUB, REGISTER},
+		{MERGE, IMPLIED}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER},
+		{AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER}, {AND, REGISTER},
+		{MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER},
+		{MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER}, {MULT, REGISTER},
+		{SBK, IMPLIED}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {SEX, IMPLIED}, {ASR, IMPLIED}, {ROR, IMPLIED},
+		{JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {LOB, IMPLIED}, {FMULT, IMPLIED},
+		{IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE},
+		{IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE}, {IBT, REGISTER_BYTE},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{HIB, IMPLIED}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER},
+		{OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER}, {OR, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {GETC, IMPLIED},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {GETB, IMPLIED},
+		{IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD},
+		{IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}, {IWT, REGISTER_WORD}
+	},
+	{ //ALT1
+		{STOP, IMPLIED}, {NOP, IMPLIED}, {CACHE, IMPLIED}, {LSR, IMPLIED}, {ROL, IMPLIED}, {BRA, RELATIVE}, {BLT, RELATIVE}, {BGE, RELATIVE},
+		{BNE, RELATIVE}, {BEQ, RELATIVE}, {BPL, RELATIVE}, {BMI, RELATIVE}, {BCC, RELATIVE}, {BCS, RELATIVE}, {BVC, RELATIVE}, {BVS, RELATIVE},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT},
+		{STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {LOOP, IMPLIED}, {ALT1, ALTERNATE}, {ALT2, ALTERNATE}, {ALT3, ALTERNATE},
+		{LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT},
+		{LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {RPIX, IMPLIED}, {SWAP, IMPLIED}, {CMODE, IMPLIED}, {NOT, IMPLIED},
+		{ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER},
+		{ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER}, {ADC, REGISTER},
+		{SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER},
+		{SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER}, {SBC, REGISTER},
+		{MERGE, IMPLIED}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER},
+		{BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER}, {BIC, REGISTER},
+		{UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER},
+		{UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER}, {UMULT, REGISTER},
+		{SBK, IMPLIED}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {SEX, IMPLIED}, {DIV2, IMPLIED}, {ROR, IMPLIED},
+		{LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LOB, IMPLIED}, {LMULT, IMPLIED},
+		{LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS},
+		{LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{HIB, IMPLIED}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER},
+		{XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER}, {XOR, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {GETC, IMPLIED},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {GETBH, IMPLIED},
+		{LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS},
+		{LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}
+	},
+	{ //ALT2
+		{STOP, IMPLIED}, {NOP, IMPLIED}, {CACHE, IMPLIED}, {LSR, IMPLIED}, {ROL, IMPLIED}, {BRA, RELATIVE}, {BLT, RELATIVE}, {BGE, RELATIVE},
+		{BNE, RELATIVE}, {BEQ, RELATIVE}, {BPL, RELATIVE}, {BMI, RELATIVE}, {BCC, RELATIVE}, {BCS, RELATIVE}, {BVC, RELATIVE}, {BVS, RELATIVE},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT},
+		{STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {STW, REGISTER_INDIRECT}, {LOOP, IMPLIED}, {ALT1, ALTERNATE}, {ALT2, ALTERNATE}, {ALT3, ALTERNATE},
+		{LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT},
+		{LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {LDW, REGISTER_INDIRECT}, {PLOT, IMPLIED}, {SWAP, IMPLIED}, {COLOR, IMPLIED}, {NOT, IMPLIED},
+		{ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE},
+		{ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE}, {ADD, IMMEDIATE},
+		{SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE},
+		{SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE}, {SUB, IMMEDIATE},
+		{MERGE, IMPLIED}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE},
+		{AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE}, {AND, IMMEDIATE},
+		{MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE},
+		{MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE}, {MULT, IMMEDIATE},
+		{SBK, IMPLIED}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {SEX, IMPLIED}, {ASR, IMPLIED}, {ROR, IMPLIED},
+		{JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {JMP, REGISTER}, {LOB, IMPLIED}, {FMULT, IMPLIED},
+		{SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS},
+		{SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS}, {SMS, REGISTER_SHORT_ADDRESS},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{HIB, IMPLIED}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE},
+		{OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE}, {OR, IMMEDIATE},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {RAMB, IMPLIED},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {GETBL, IMPLIED},
+		{SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS},
+		{SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}, {SM, REGISTER_ADDRESS}
+	},
+	{ //ALT3
+		{STOP, IMPLIED}, {NOP, IMPLIED}, {CACHE, IMPLIED}, {LSR, IMPLIED}, {ROL, IMPLIED}, {BRA, RELATIVE}, {BLT, RELATIVE}, {BGE, RELATIVE},
+		{BNE, RELATIVE}, {BEQ, RELATIVE}, {BPL, RELATIVE}, {BMI, RELATIVE}, {BCC, RELATIVE}, {BCS, RELATIVE}, {BVC, RELATIVE}, {BVS, RELATIVE},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX}, {TO, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX}, {WITH, PREFIX},
+		{STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT},
+		{STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {STB, REGISTER_INDIRECT}, {LOOP, IMPLIED}, {ALT1, ALTERNATE}, {ALT2, ALTERNATE}, {ALT3, ALTERNATE},
+		{LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT},
+		{LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {LDB, REGISTER_INDIRECT}, {RPIX, IMPLIED}, {SWAP, IMPLIED}, {CMODE, IMPLIED}, {NOT, IMPLIED},
+		{ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE},
+		{ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE}, {ADC, IMMEDIATE},
+		{CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER},
+		{CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER}, {CMP, REGISTER},
+		{MERGE, IMPLIED}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE},
+		{BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE}, {BIC, IMMEDIATE},
+		{UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE},
+		{UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE}, {UMULT, IMMEDIATE},
+		{SBK, IMPLIED}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {LINK, IMMEDIATE}, {SEX, IMPLIED}, {DIV2, IMPLIED}, {ROR, IMPLIED},
+		{LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LJMP, REGISTER}, {LOB, IMPLIED}, {LMULT, IMPLIED},
+		{LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS},
+		{LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS}, {LMS, REGISTER_SHORT_ADDRESS},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX}, {FROM, PREFIX},
+		{HIB, IMPLIED}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE},
+		{XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE}, {XOR, IMMEDIATE},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER},
+		{INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {INC, REGISTER}, {ROMB, IMPLIED},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER},
+		{DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {DEC, REGISTER}, {GETBS, IMPLIED},
+		{LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS},
+		{LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}, {LM, REGISTER_ADDRESS}
+	}
 };
 
-const QMap<unsigned char, disassembler_core::opcode> isa_gsu::alt3 = {
-	OP12(0x30, "stb (r%o)"),
-	OP12(0x40, "ldb (r%o)"),
-	OP1 (0x4C, "rpix"),
-	OP1 (0x4E, "cmode"),
-	OP16(0x50, "adc #%o"),
-	OP16(0x60, "cmp r%o"),
-	OP15(0x71, "bic #%o"),
-	OP16(0x80, "umult #%o"),
-	OP1 (0x96, "div2"),
-	OP6 (0x98, "ljmp r%o"),
-	OP1 (0x9f, "lmult"),
-	OP16(0xA0, "lms r%o"),
-	OP1 (0xC0, "hib"),
-	OP15(0xC1, "xor #%o"),
-	OP1 (0xDF, "romb"),
-	OP1 (0xEF, "getbs"),
-	OP16(0xF0, "lm r%o")
+const char *const isa_gsu::mnemonic_names[] = {
+	"adc", "add", "alt1", "alt2", "alt3", "and", "asr", "bcc", "bcs", "beq", "bge", "bic",
+	"blt", "bmi", "bne", "bpl", "bra", "bvc", "bvs", "cache", "cmode", "cmp", "color", "dec",
+	"div2", "fmult", "from", "getb", "getbh", "getbl", "getbs", "getc", "hib", "ibt", "inc", "iwt",
+	"jmp", "ldb", "ldw", "link", "ljmp", "lm", "lms", "lmult", "lob", "loop", "lsr", "merge",
+	"mult", "nop", "not", "or", "plot", "ramb", "rol", "romb", "ror", "rpix", "sbc", "sbk",
+	"sex", "sm", "sms", "stb", "stop", "stw", "sub", "swap", "to", "umult", "with", "xor"
 };
 
 const QSet<unsigned char> isa_gsu::unlikely = {
 	0x00
 };
-
-#undef OP1
-#undef OP2
-#undef OP4
-#undef OP6
-#undef OP12
-#undef OP15
-#undef OP16
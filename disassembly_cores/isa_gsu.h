@@ -2,7 +2,6 @@
 #define ISA_GSU_H
 
 #include <QCheckBox>
-#include <QMap>
 #include <QSet>
 #include <QGridLayout>
 
@@ -16,34 +15,53 @@ class isa_gsu : public disassembler_core
 		~isa_gsu();
 		QGridLayout *core_layout();
 		static QString id(){ return "gsu"; }
+		static int operand_size(unsigned char op, int alt);
+		
+		enum mnemonics{
+			ADC, ADD, ALT1, ALT2, ALT3, AND, ASR, BCC, BCS, BEQ, BGE, BIC,
+			BLT, BMI, BNE, BPL, BRA, BVC, BVS, CACHE, CMODE, CMP, COLOR, DEC,
+			DIV2, FMULT, FROM, GETB, GETBH, GETBL, GETBS, GETC, HIB, IBT, INC, IWT,
+			JMP, LDB, LDW, LINK, LJMP, LM, LMS, LMULT, LOB, LOOP, LSR, MERGE,
+			MULT, NOP, NOT, OR, PLOT, RAMB, ROL, ROMB, ROR, RPIX, SBC, SBK,
+			SEX, SM, SMS, STB, STOP, STW, SUB, SWAP, TO, UMULT, WITH, XOR
+		};
+		
+		enum modes{
+			IMPLIED, REGISTER, PREFIX, REGISTER_INDIRECT, IMMEDIATE, RELATIVE,
+			REGISTER_BYTE, REGISTER_WORD, REGISTER_SHORT_ADDRESS, REGISTER_ADDRESS,
+			ALTERNATE, MODE_COUNT
+		};
+		
+		//One table per ALT state, opcodes an ALT prefix doesn't change repeat the ALT0 entry
+		static const opcode opcode_list[4][256];
 		
 	public slots:
 		void change_alt(const QString &text){ alt_state = text.toInt(); }
 		void toggle_error_stop(bool state){ error_stop = state; }
 
 	protected:
-		QString decode_name_arg(const char arg, int &size);
+		void decode(unsigned char op);
+		void append_register(int reg);
+		void append_number(int value);
 		QString address_to_label(int address);
+		int symbol_address(int address){ return buffer->pc_to_snes(address); }
 		QString format_data_value(int size, int value, bool is_pointer);
-		template <typename V> QString label_op(int offset, int size, V validator);
-		opcode get_opcode(int op);
 		int get_base();
 		bool abort_unlikely(int op);
 		void update_state();
 		void set_flags(bookmark_data::types type){ Q_UNUSED(type); }
+		unsigned char get_state(){ return alt_state; }
+		void set_state(unsigned char state){ alt_state = state; }
+		const code_map &get_analysis(){ return buffer->get_gsu_map(); }
+		void apply_analysis(unsigned char state){ alt_state = code_map::alt_state(state); }
 	private:		
 		int alt_state = 0;
 		bool error_stop = false;
 		QLineEdit *set_alt = new QLineEdit();
 		QCheckBox *stop = new QCheckBox("Stop on unlikely");
 		
-		static const QList<disassembler_core::opcode> opcode_list;
-		static const QMap<unsigned char, disassembler_core::opcode> alt1;
-		static const QMap<unsigned char, disassembler_core::opcode> alt2;
-		static const QMap<unsigned char, disassembler_core::opcode> alt3;
+		static const char *const mnemonic_names[];
 		static const QSet<unsigned char> unlikely;
-		
-		const QMap<unsigned char, disassembler_core::opcode> *alt_states[4] = {nullptr, &alt1, &alt2, &alt3};
 };
 
 #endif // ISA_GSU_H
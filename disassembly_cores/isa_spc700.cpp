@@ -7,9 +7,40 @@ isa_spc700::isa_spc700(QObject *parent) :
 {
 	connect(stop, &QCheckBox::toggled, this, &isa_spc700::toggle_error_stop);
 	connect(base_input, &QLineEdit::textChanged, this, &isa_spc700::update_base);
+	connect(scan_button, &QPushButton::clicked, this, &isa_spc700::scan_requested);
+	connect(upload_list, resolve<int>::from(&QComboBox::activated), this, &isa_spc700::select_upload);
 	base_input->setInputMask("HHHH");
 }
 
+//Every uploaded block is listed on its own, the one holding the entry point is marked
+void isa_spc700::set_uploads(const QVector<spc_upload_scanner::upload> &uploads, const ROM_buffer *b)
+{
+	upload_list->clear();
+	upload_blocks.clear();
+	for(const auto &upload : uploads){
+		for(const auto &block : upload.blocks){
+			bool entry = upload.entry >= block.destination && upload.entry < block.destination + block.length;
+			upload_list->addItem(b->get_formatted_address(block.offset) + " -> $" + 
+			                     to_hex(block.destination, 4) + ", " + QString::number(block.length) + 
+			                     " bytes" + (entry ? " (entry $" + to_hex(upload.entry, 4) + ")" : ""));
+			upload_blocks.append(block);
+		}
+	}
+	if(upload_blocks.isEmpty()){
+		upload_list->addItem("No uploads found");
+	}
+}
+
+void isa_spc700::select_upload(int index)
+{
+	if(index < 0 || index >= upload_blocks.size()){
+		return;
+	}
+	const spc_upload_scanner::block &block = upload_blocks[index];
+	base_input->setText(to_hex(block.destination, 4));
+	emit upload_selected(selection::create_selection(block.offset, block.length));
+}
+
 void isa_spc700::update_base(QString new_base)
 {
 	base = new_base.toInt(nullptr, 16);
@@ -21,50 +52,86 @@ QGridLayout *isa_spc700::core_layout()
 	grid->addWidget(base_text, 0, 0, 1, 1);
 	grid->addWidget(base_input, 0, 1, 1, 2);
 	grid->addWidget(stop, 1, 0, 2, 1);
+	grid->addWidget(scan_button, 3, 0, 1, 1);
+	grid->addWidget(upload_list, 3, 1, 1, 2);
 	return grid;
 }
 
-QString isa_spc700::decode_name_arg(const char arg, int &size)
+//Operand size, text before the operand and text after it, registers have no size
+static const struct{
+	unsigned char size;
+	const char *prefix;
+	const char *suffix;
+} operand_formats[isa_spc700::OPERAND_COUNT] = {
+	{0, "", ""}, {0, "a", ""}, {0, "x", ""}, {0, "y", ""}, {0, "ya", ""}, {0, "sp", ""},
+	{0, "p", ""}, {0, "c", ""}, {0, "(x)", ""}, {0, "(x)+", ""}, {0, "(y)", ""}, {1, "$", ""},
+	{1, "$", "+x"}, {1, "$", "+y"}, {1, "($", "+x)"}, {1, "($", ")+y"}, {2, "$", ""}, {2, "$", "+x"},
+	{2, "$", "+y"}, {2, "($", "+x)"}, {1, "#$", ""}, {1, "", ""}, {2, "", ""}, {2, "$", ""},
+	{2, "!$", ""}, {1, "$FF", ""}
+};
+
+void isa_spc700::decode(unsigned char op)
+{
+	const instruction &entry = opcode_list[op];
+	int first_size = operand_formats[entry.first].size;
+	int second_size = operand_formats[entry.second].size;
+	//With two memory operands the destination is encoded last, unless the second one is a branch
+	bool swapped = first_size && second_size && entry.second != RELATIVE;
+	int size = first_size + second_size;
+	
+	append(mnemonic_names[entry.mnemonic]);
+	if(entry.first != NONE){
+		append(' ');
+		append_operand(entry.first, swapped ? second_size : 0, size);
+	}
+	if(entry.second != NONE){
+		append(", ");
+		append_operand(entry.second, swapped ? 0 : first_size, size);
+	}
+	delta += size;
+}
+
+void isa_spc700::append_operand(unsigned char type, int offset, int size)
 {
-	QString decode;
-	decode.reserve(7);
-	unsigned int operand = get_operand(0) | get_operand(1) | get_operand(2);
-	int relative = (char)(operand & 0xFF) + 2 + delta;
-	switch(arg){
-		case 'b':
-			size++;
-			return "$" + to_hex(operand & 0x0000FF, 2);
-		case 'w':
-			size += 2;
-			return "$" + to_hex(operand & 0x00FFFF, 4);
-		// m and i are a pair always used together
-		case 'm':
-			return "$" + to_hex(operand & 0x001FFF, 4);
-		case 'i':
-			size += 2;
-			return "$" + to_hex((operand & 0x00E000) >> 13, 2);
-		case 'c':
-			size += 2;
-			return "$"  + to_hex((operand & 0x00FF00) >> 8, 2) +
-			       "#$" + to_hex((operand & 0x0000FF) >> 0, 2);
-		case 'r':
-			size++;
-			operand &= 0xFF;
+	unsigned int operand = read_operand(operand_formats[type].size, offset);
+	append(operand_formats[type].prefix);
+	switch(type){
+		case RELATIVE:{
+			int relative = (char)operand + delta + size;
 			if(relative < 0 || relative > data.size()){
-				return '$' + to_hex(operand & 0xFF, 2);
+				append('$');
+				append_hex(operand, 2);
+			}else{
+				append(add_label(relative + base));
 			}
-			return add_label(relative + base);
-		case 'j':
-			size += 2;
-			operand &= 0xFFFF;
+		}
+		break;
+		case JUMP:
 			if(operand < base || operand > base + data.size()){
-				return '$' + to_hex(operand, 4);
+				const char *symbol = buffer->get_symbols().find(symbol_address(operand));
+				if(symbol){
+					append(symbol);
+					break;
+				}
+				append('$');
+				append_hex(operand, 4);
+			}else{
+				append(add_label(operand));
 			}
-			return add_label(operand);
+		break;
+		case MEMORY_BIT:
+		case NOT_MEMORY_BIT:
+			append_hex(operand & 0x1FFF, 4);
+			append('.');
+			append((char)('0' + (operand >> 13)));
+		break;
 		default:
-			qFatal("Invalid name decode arg");
+			if(operand_formats[type].size){
+				append_hex(operand, operand_formats[type].size * 2);
+			}
+		break;
 	}
-	return "";
+	append(operand_formats[type].suffix);
 }
 
 QString isa_spc700::address_to_label(int address)
@@ -84,11 +151,6 @@ QString isa_spc700::format_data_value(int size, int value, bool is_pointer)
 	}
 }
 
-disassembler_core::opcode isa_spc700::get_opcode(int op)
-{
-	return opcode_list[op];
-}
-
 int isa_spc700::get_base()
 {
 	return base;
@@ -104,265 +166,56 @@ isa_spc700::~isa_spc700()
 	delete stop;
 	delete base_text;
 	delete base_input;
+	delete scan_button;
+	delete upload_list;
 }
 
-const QList<disassembler_core::opcode> isa_spc700::opcode_list = {
-        {"nop"},
-	{"tcall 0"},
-	{"set0 %b"},
-	{"bbs0 %b, %r"},
-	{"or a, %b"},
-	{"or a, %w"},
-	{"or a, (x)"},
-	{"or a, (%b+x)"},
-	{"or a, #%b"},
-	{"or %b, %b"},
-	{"or1 c, %m:%b"},
-	{"asl %b"},
-	{"asl %w"},
-	{"push p"},
-	{"tset %w, a"},
-	{"brk"},
-	{"bpl %r"},
-	{"tcall 1"},
-	{"clr0 %b"},
-	{"bbc0 %b, %r"},
-	{"or a, %b+x"},
-	{"or a, %w"},
-	{"or a, %w"},
-	{"or a, (%b)+y"},
-	{"or %i"},
-	{"or (x), (y)"},
-	{"decw %b"},
-	{"asl %b+x"},
-	{"asl a"},
-	{"dec x"},
-	{"cmp x, %w"},
-	{"jmp (%w+x)"},
-	{"clrp"},
-	{"tcall 2"},
-	{"set1 %b"},
-	{"bbs1 %b, %r"},
-	{"and a, %b"},
-	{"and a, %w"},
-	{"and a, (x)"},
-	{"and a, (%b+x)"},
-	{"and a, #%b"},
-	{"and %b, %b"},
-	{"or1 c, !%m:%b"},
-	{"rol %b"},
-	{"rol %w"},
-	{"push a"},
-	{"cbne %b, %r"},
-	{"bra %r"},
-	{"bmi %r"},
-	{"tcall 3"},
-	{"clr1 %b"},
-	{"bbc1 %b, %r"},
-	{"and a, %b+x"},
-	{"and a, %w"},
-	{"and a, %w"},
-	{"and a, (%b)+y"},
-	{"and %i"},
-	{"and (x), (y)"},
-	{"incw %b"},
-	{"rol %b+x"},
-	{"rol a"},
-	{"inc x"},
-	{"cmp x, %b"},
-	{"call %j"},
-	{"setp"},
-	{"tcall 4"},
-	{"set2 %b"},
-	{"bbs2 %b, %r"},
-	{"eor a, %b"},
-	{"eor a, %w"},
-	{"eor a, (x)"},
-	{"eor a, (%b+x)"},
-	{"eor a, #%b"},
-	{"eor %b, %b"},
-	{"and1 c, %m:%b"},
-	{"lsr %b"},
-	{"lsr %w"},
-	{"push x"},
-	{"tclr %w, a"},
-	{"pcall $ff#%b"},
-	{"bvc %r"},
-	{"tcall 5"},
-	{"clr2 %b"},
-	{"bbc2 %b, %r"},
-	{"eor a, %b+x"},
-	{"eor a, %w"},
-	{"eor a, %w"},
-	{"eor a, (%b)+y"},
-	{"eor %i"},
-	{"eor (x), (y)"},
-	{"cmpw ya, %b"},
-	{"lsr %b+x"},
-	{"lsr a"},
-	{"mov x, a"},
-	{"cmp y, %w"},
-	{"jmp %w"},
-	{"clrc"},
-	{"tcall 6"},
-	{"set3 %b"},
-	{"bbs3 %b, %r"},
-	{"cmp a, %b"},
-	{"cmp a, %w"},
-	{"cmp a, (x)"},
-	{"cmp a, (%b+x)"},
-	{"cmp a, #%b"},
-	{"cmp %b, %b"},
-	{"and1 c, !%m:%b"},
-	{"ror %b"},
-	{"ror %w"},
-	{"push y"},
-	{"dbnz %b, %r"},
-	{"ret"},
-	{"bvs %r"},
-	{"tcall 7"},
-	{"clr3 %b"},
-	{"bbc3 %b, %r"},
-	{"cmp a, %b+x"},
-	{"cmp a, %w"},
-	{"cmp a, %w"},
-	{"cmp a, (%b)+y"},
-	{"cmp %i"},
-	{"cmp (x), (y)"},
-	{"addw ya, %b"},
-	{"ror %b+x"},
-	{"ror a"},
-	{"mov a, x"},
-	{"cmp y, %b"},
-	{"reti"},
-	{"setc"},
-	{"tcall 8"},
-	{"set4 %b"},
-	{"bbs4 %b, %r"},
-	{"adc a, %b"},
-	{"adc a, %w"},
-	{"adc a, (x)"},
-	{"adc a, (%b+x)"},
-	{"adc a, #%b"},
-	{"adc %b, %b"},
-	{"eor1 c, %m:%b"},
-	{"dec %b"},
-	{"dec %w"},
-	{"mov y, #%b"},
-	{"pop p"},
-	{"mov %i"},
-	{"bcc %r"},
-	{"tcall 9"},
-	{"clr4 %b"},
-	{"bbc4 %b, %r"},
-	{"adc a, %b+x"},
-	{"adc a, %w"},
-	{"adc a, %w"},
-	{"adc a, (%b)+y"},
-	{"adc %i"},
-	{"adc (x), (y)"},
-	{"subw ya, %b"},
-	{"dec %b+x"},
-	{"dec a"},
-	{"mov x, sp"},
-	{"div ya, x"},
-	{"xcn a"},
-	{"ei"},
-	{"tcall 10"},
-	{"set5 %b"},
-	{"bbs5 %b, %r"},
-	{"sbc a, %b"},
-	{"sbc a, %w"},
-	{"sbc a, (x)"},
-	{"sbc a, (%b+x)"},
-	{"sbc a, #%b"},
-	{"sbc %b, %b"},
-	{"mov1 c, %m:%b"},
-	{"inc %b"},
-	{"inc %w"},
-	{"cmp y, #%b"},
-	{"pop a"},
-	{"mov (x)+, a"},
-	{"bcs %r"},
-	{"tcall 11"},
-	{"clr5 %b"},
-	{"bbc5 %b, %r"},
-	{"sbc a, %b+x"},
-	{"sbc a, %w"},
-	{"sbc a, %w"},
-	{"sbc a, (%b)+y"},
-	{"sbc %i"},
-	{"sbc (x), (y)"},
-	{"movw ya, %b"},
-	{"inc %b+x"},
-	{"inc a"},
-	{"mov sp, x"},
-	{"das a"},
-	{"mov a, (x)+"},
-	{"di"},
-	{"tcall 12"},
-	{"set6 %b"},
-	{"bbs6 %b, %r"},
-	{"mov %b, a"},
-	{"mov %w, a"},
-	{"mov (x), a"},
-	{"mov (%b+x), a"},
-	{"cmp x, #%b"},
-	{"mov %w, x"},
-	{"mov1 %m:%b, c"},
-	{"mov %b, y"},
-	{"mov %w, y"},
-	{"mov x, #%b"},
-	{"pop x"},
-	{"mul ya"},
-	{"bne %r"},
-	{"tcall 13"},
-	{"clr6 %b"},
-	{"bbc6 %b, %r"},
-	{"mov %b+x, a"},
-	{"mov %w+x, a"},
-	{"mov %w+y, a"},
-	{"mov (%b)+y, a"},
-	{"mov %b, x"},
-	{"mov %b+y, x"},
-	{"movw %b, ya"},
-	{"mov %b+x, y"},
-	{"dec y"},
-	{"mov a, y"},
-	{"cbne %b, %r"},
-	{"daa a"},
-	{"clrv"},
-	{"tcall 14"},
-	{"set7 %b"},
-	{"bbs7 %b, %r"},
-	{"mov a, %b"},
-	{"mov a, %w"},
-	{"mov a, (x)"},
-	{"mov a, (%b+x)"},
-	{"mov a, #%b"},
-	{"mov x, %w"},
-	{"not1 c, %m:%b"},
-	{"mov y, %b"},
-	{"mov y, %w"},
-	{"notc"},
-	{"pop y"},
-	{"sleep"},
-	{"beq %r"},
-	{"tcall 15"},
-	{"clr7 %b"},
-	{"bbc7 %b, %r"},
-	{"mov a, %b+x"},
-	{"mov a, %w"},
-	{"mov a, %w"},
-	{"mov a, (%b)+y"},
-	{"mov x, %b"},
-	{"mov x, %b+y"},
-	{"mov %b, %b"},
-	{"mov y, %b+x"},
-	{"inc y"},
-	{"mov y, a"},
-	{"dbnz y, %r"},
-	{"stop"}
+const isa_spc700::instruction isa_spc700::opcode_list[256] = {
+	{NOP, NONE, NONE}, {TCALL_0, NONE, NONE}, {SET0, DIRECT, NONE}, {BBS0, DIRECT, RELATIVE}, {OR, A, DIRECT}, {OR, A, ABSOLUTE}, {OR, A, INDIRECT_X}, {OR, A, DIRECT_X_INDIRECT},
+	{OR, A, IMMEDIATE}, {OR, DIRECT, DIRECT}, {OR1, C, MEMORY_BIT}, {ASL, DIRECT, NONE}, {ASL, ABSOLUTE, NONE}, {PUSH, PSW, NONE}, {TSET, ABSOLUTE, A}, {BRK, NONE, NONE},
+	{BPL, RELATIVE, NONE}, {TCALL_1, NONE, NONE}, {CLR0, DIRECT, NONE}, {BBC0, DIRECT, RELATIVE}, {OR, A, DIRECT_X}, {OR, A, ABSOLUTE_X}, {OR, A, ABSOLUTE_Y}, {OR, A, DIRECT_INDIRECT_Y},
+	{OR, DIRECT, IMMEDIATE}, {OR, INDIRECT_X, INDIRECT_Y}, {DECW, DIRECT, NONE}, {ASL, DIRECT_X, NONE}, {ASL, A, NONE}, {DEC, X, NONE}, {CMP, X, ABSOLUTE}, {JMP, ABSOLUTE_X_INDIRECT, NONE},
+	{CLRP, NONE, NONE}, {TCALL_2, NONE, NONE}, {SET1, DIRECT, NONE}, {BBS1, DIRECT, RELATIVE}, {AND, A, DIRECT}, {AND, A, ABSOLUTE}, {AND, A, INDIRECT_X}, {AND, A, DIRECT_X_INDIRECT},
+	{AND, A, IMMEDIATE}, {AND, DIRECT, DIRECT}, {OR1, C, NOT_MEMORY_BIT}, {ROL, DIRECT, NONE}, {ROL, ABSOLUTE, NONE}, {PUSH, A, NONE}, {CBNE, DIRECT, RELATIVE}, {BRA, RELATIVE, NONE},
+	{BMI, RELATIVE, NONE}, {TCALL_3, NONE, NONE}, {CLR1, DIRECT, NONE}, {BBC1, DIRECT, RELATIVE}, {AND, A, DIRECT_X}, {AND, A, ABSOLUTE_X}, {AND, A, ABSOLUTE_Y}, {AND, A, DIRECT_INDIRECT_Y},
+	{AND, DIRECT, IMMEDIATE}, {AND, INDIRECT_X, INDIRECT_Y}, {INCW, DIRECT, NONE}, {ROL, DIRECT_X, NONE}, {ROL, A, NONE}, {INC, X, NONE}, {CMP, X, DIRECT}, {CALL, JUMP, NONE},
+	{SETP, NONE, NONE}, {TCALL_4, NONE, NONE}, {SET2, DIRECT, NONE}, {BBS2, DIRECT, RELATIVE}, {EOR, A, DIRECT}, {EOR, A, ABSOLUTE}, {EOR, A, INDIRECT_X}, {EOR, A, DIRECT_X_INDIRECT},
+	{EOR, A, IMMEDIATE}, {EOR, DIRECT, DIRECT}, {AND1, C, MEMORY_BIT}, {LSR, DIRECT, NONE}, {LSR, ABSOLUTE, NONE}, {PUSH, X, NONE}, {TCLR, ABSOLUTE, A}, {PCALL, UPPER_PAGE, NONE},
+	{BVC, RELATIVE, NONE}, {TCALL_5, NONE, NONE}, {CLR2, DIRECT, NONE}, {BBC2, DIRECT, RELATIVE}, {EOR, A, DIRECT_X}, {EOR, A, ABSOLUTE_X}, {EOR, A, ABSOLUTE_Y}, {EOR, A, DIRECT_INDIRECT_Y},
+	{EOR, DIRECT, IMMEDIATE}, {EOR, INDIRECT_X, INDIRECT_Y}, {CMPW, YA, DIRECT}, {LSR, DIRECT_X, NONE}, {LSR, A, NONE}, {MOV, X, A}, {CMP, Y, ABSOLUTE}, {JMP, JUMP, NONE},
+	{CLRC, NONE, NONE}, {TCALL_6, NONE, NONE}, {SET3, DIRECT, NONE}, {BBS3, DIRECT, RELATIVE}, {CMP, A, DIRECT}, {CMP, A, ABSOLUTE}, {CMP, A, INDIRECT_X}, {CMP, A, DIRECT_X_INDIRECT},
+	{CMP, A, IMMEDIATE}, {CMP, DIRECT, DIRECT}, {AND1, C, NOT_MEMORY_BIT}, {ROR, DIRECT, NONE}, {ROR, ABSOLUTE, NONE}, {PUSH, Y, NONE}, {DBNZ, DIRECT, RELATIVE}, {RET, NONE, NONE},
+	{BVS, RELATIVE, NONE}, {TCALL_7, NONE, NONE}, {CLR3, DIRECT, NONE}, {BBC3, DIRECT, RELATIVE}, {CMP, A, DIRECT_X}, {CMP, A, ABSOLUTE_X}, {CMP, A, ABSOLUTE_Y}, {CMP, A, DIRECT_INDIRECT_Y},
+	{CMP, DIRECT, IMMEDIATE}, {CMP, INDIRECT_X, INDIRECT_Y}, {ADDW, YA, DIRECT}, {ROR, DIRECT_X, NONE}, {ROR, A, NONE}, {MOV, A, X}, {CMP, Y, DIRECT}, {RETI, NONE, NONE},
+	{SETC, NONE, NONE}, {TCALL_8, NONE, NONE}, {SET4, DIRECT, NONE}, {BBS4, DIRECT, RELATIVE}, {ADC, A, DIRECT}, {ADC, A, ABSOLUTE}, {ADC, A, INDIRECT_X}, {ADC, A, DIRECT_X_INDIRECT},
+	{ADC, A, IMMEDIATE}, {ADC, DIRECT, DIRECT}, {EOR1, C, MEMORY_BIT}, {DEC, DIRECT, NONE}, {DEC, ABSOLUTE, NONE}, {MOV, Y, IMMEDIATE}, {POP, PSW, NONE}, {MOV, DIRECT, IMMEDIATE},
+	{BCC, RELATIVE, NONE}, {TCALL_9, NONE, NONE}, {CLR4, DIRECT, NONE}, {BBC4, DIRECT, RELATIVE}, {ADC, A, DIRECT_X}, {ADC, A, ABSOLUTE_X}, {ADC, A, ABSOLUTE_Y}, {ADC, A, DIRECT_INDIRECT_Y},
+	{ADC, DIRECT, IMMEDIATE}, {ADC, INDIRECT_X, INDIRECT_Y}, {SUBW, YA, DIRECT}, {DEC, DIRECT_X, NONE}, {DEC, A, NONE}, {MOV, X, SP}, {DIV, YA, X}, {XCN, A, NONE},
+	{EI, NONE, NONE}, {TCALL_10, NONE, NONE}, {SET5, DIRECT, NONE}, {BBS5, DIRECT, RELATIVE}, {SBC, A, DIRECT}, {SBC, A, ABSOLUTE}, {SBC, A, INDIRECT_X}, {SBC, A, DIRECT_X_INDIRECT},
+	{SBC, A, IMMEDIATE}, {SBC, DIRECT, DIRECT}, {MOV1, C, MEMORY_BIT}, {INC, DIRECT, NONE}, {INC, ABSOLUTE, NONE}, {CMP, Y, IMMEDIATE}, {POP, A, NONE}, {MOV, INDIRECT_X_INCREMENT, A},
+	{BCS, RELATIVE, NONE}, {TCALL_11, NONE, NONE}, {CLR5, DIRECT, NONE}, {BBC5, DIRECT, RELATIVE}, {SBC, A, DIRECT_X}, {SBC, A, ABSOLUTE_X}, {SBC, A, ABSOLUTE_Y}, {SBC, A, DIRECT_INDIRECT_Y},
+	{SBC, DIRECT, IMMEDIATE}, {SBC, INDIRECT_X, INDIRECT_Y}, {MOVW, YA, DIRECT}, {INC, DIRECT_X, NONE}, {INC, A, NONE}, {MOV, SP, X}, {DAS, A, NONE}, {MOV, A, INDIRECT_X_INCREMENT},
+	{DI, NONE, NONE}, {TCALL_12, NONE, NONE}, {SET6, DIRECT, NONE}, {BBS6, DIRECT, RELATIVE}, {MOV, DIRECT, A}, {MOV, ABSOLUTE, A}, {MOV, INDIRECT_X, A}, {MOV, DIRECT_X_INDIRECT, A},
+	{CMP, X, IMMEDIATE}, {MOV, ABSOLUTE, X}, {MOV1, MEMORY_BIT, C}, {MOV, DIRECT, Y}, {MOV, ABSOLUTE, Y}, {MOV, X, IMMEDIATE}, {POP, X, NONE}, {MUL, YA, NONE},
+	{BNE, RELATIVE, NONE}, {TCALL_13, NONE, NONE}, {CLR6, DIRECT, NONE}, {BBC6, DIRECT, RELATIVE}, {MOV, DIRECT_X, A}, {MOV, ABSOLUTE_X, A}, {MOV, ABSOLUTE_Y, A}, {MOV, DIRECT_INDIRECT_Y, A},
+	{MOV, DIRECT, X}, {MOV, DIRECT_Y, X}, {MOVW, DIRECT, YA}, {MOV, DIRECT_X, Y}, {DEC, Y, NONE}, {MOV, A, Y}, {CBNE, DIRECT_X, RELATIVE}, {DAA, A, NONE},
+	{CLRV, NONE, NONE}, {TCALL_14, NONE, NONE}, {SET7, DIRECT, NONE}, {BBS7, DIRECT, RELATIVE}, {MOV, A, DIRECT}, {MOV, A, ABSOLUTE}, {MOV, A, INDIRECT_X}, {MOV, A, DIRECT_X_INDIRECT},
+	{MOV, A, IMMEDIATE}, {MOV, X, ABSOLUTE}, {NOT1, MEMORY_BIT, NONE}, {MOV, Y, DIRECT}, {MOV, Y, ABSOLUTE}, {NOTC, NONE, NONE}, {POP, Y, NONE}, {SLEEP, NONE, NONE},
+	{BEQ, RELATIVE, NONE}, {TCALL_15, NONE, NONE}, {CLR7, DIRECT, NONE}, {BBC7, DIRECT, RELATIVE}, {MOV, A, DIRECT_X}, {MOV, A, ABSOLUTE_X}, {MOV, A, ABSOLUTE_Y}, {MOV, A, DIRECT_INDIRECT_Y},
+	{MOV, X, DIRECT}, {MOV, X, DIRECT_Y}, {MOV, DIRECT, DIRECT}, {MOV, Y, DIRECT_X}, {INC, Y, NONE}, {MOV, Y, A}, {DBNZ, Y, RELATIVE}, {STOP, NONE, NONE}
+};
+
+const char *const isa_spc700::mnemonic_names[] = {
+	"adc", "addw", "and", "and1", "asl", "bbc0", "bbc1", "bbc2", "bbc3", "bbc4", "bbc5", "bbc6",
+	"bbc7", "bbs0", "bbs1", "bbs2", "bbs3", "bbs4", "bbs5", "bbs6", "bbs7", "bcc", "bcs", "beq",
+	"bmi", "bne", "bpl", "bra", "brk", "bvc", "bvs", "call", "cbne", "clr0", "clr1", "clr2",
+	"clr3", "clr4", "clr5", "clr6", "clr7", "clrc", "clrp", "clrv", "cmp", "cmpw", "daa", "das",
+	"dbnz", "dec", "decw", "di", "div", "ei", "eor", "eor1", "inc", "incw", "jmp", "lsr",
+	"mov", "mov1", "movw", "mul", "nop", "not1", "notc", "or", "or1", "pcall", "pop", "push",
+	"ret", "reti", "rol", "ror", "sbc", "set0", "set1", "set2", "set3", "set4", "set5", "set6",
+	"set7", "setc", "setp", "sleep", "stop", "subw", "tcall 0", "tcall 1", "tcall 2", "tcall 3", "tcall 4", "tcall 5",
+	"tcall 6", "tcall 7", "tcall 8", "tcall 9", "tcall 10", "tcall 11", "tcall 12", "tcall 13", "tcall 14", "tcall 15", "tclr", "tset",
+	"xcn"
 };
 
 const QSet<unsigned char> isa_spc700::unlikely = {
@@ -5,8 +5,11 @@
 #include <QLineEdit>
 #include <QLabel>
 #include <QSet>
+#include <QPushButton>
+#include <QComboBox>
 
 #include "disassembler_core.h"
+#include "analysis/spc_upload_scanner.h"
 
 class isa_spc700 : public disassembler_core
 {
@@ -16,26 +19,68 @@ class isa_spc700 : public disassembler_core
 		~isa_spc700();
 		QGridLayout *core_layout();
 		static QString id(){ return "SPC700"; }
+		
+		enum mnemonics{
+			ADC, ADDW, AND, AND1, ASL, BBC0, BBC1, BBC2, BBC3, BBC4, BBC5, BBC6,
+			BBC7, BBS0, BBS1, BBS2, BBS3, BBS4, BBS5, BBS6, BBS7, BCC, BCS, BEQ,
+			BMI, BNE, BPL, BRA, BRK, BVC, BVS, CALL, CBNE, CLR0, CLR1, CLR2,
+			CLR3, CLR4, CLR5, CLR6, CLR7, CLRC, CLRP, CLRV, CMP, CMPW, DAA, DAS,
+			DBNZ, DEC, DECW, DI, DIV, EI, EOR, EOR1, INC, INCW, JMP, LSR,
+			MOV, MOV1, MOVW, MUL, NOP, NOT1, NOTC, OR, OR1, PCALL, POP, PUSH,
+			RET, RETI, ROL, ROR, SBC, SET0, SET1, SET2, SET3, SET4, SET5, SET6,
+			SET7, SETC, SETP, SLEEP, STOP, SUBW, TCALL_0, TCALL_1, TCALL_2, TCALL_3, TCALL_4, TCALL_5,
+			TCALL_6, TCALL_7, TCALL_8, TCALL_9, TCALL_10, TCALL_11, TCALL_12, TCALL_13, TCALL_14, TCALL_15, TCLR, TSET,
+			XCN
+		};
+		
+		enum operands{
+			NONE, A, X, Y, YA, SP,
+			PSW, C, INDIRECT_X, INDIRECT_X_INCREMENT, INDIRECT_Y, DIRECT,
+			DIRECT_X, DIRECT_Y, DIRECT_X_INDIRECT, DIRECT_INDIRECT_Y, ABSOLUTE, ABSOLUTE_X,
+			ABSOLUTE_Y, ABSOLUTE_X_INDIRECT, IMMEDIATE, RELATIVE, JUMP, MEMORY_BIT,
+			NOT_MEMORY_BIT, UPPER_PAGE, OPERAND_COUNT
+		};
+		
+		struct instruction{
+			unsigned char mnemonic;
+			unsigned char first;
+			unsigned char second;
+		};
+		
+		static const instruction opcode_list[256];
+
+		void set_uploads(const QVector<spc_upload_scanner::upload> &uploads, const ROM_buffer *b);
+		
+	signals:
+		void scan_requested();
+		void upload_selected(selection area);
 
 	public slots:
 		void toggle_error_stop(bool state){ error_stop = state; }
 		void update_base(QString new_base);
+		void select_upload(int index);
 
 	protected:
-		QString decode_name_arg(const char arg, int &size);
+		void decode(unsigned char op);
+		void append_operand(unsigned char type, int offset, int size);
 		QString address_to_label(int address);
+		int symbol_address(int address){ return address | symbol_table::SPC700; }
 		QString format_data_value(int size, int value, bool is_pointer);
-		opcode get_opcode(int op);
 		int get_base();
 		bool abort_unlikely(int op);
 		void update_state(){}
 		void set_flags(bookmark_data::types type){ Q_UNUSED(type); }
+		unsigned char get_state(){ return 0; }
+		void set_state(unsigned char state){ Q_UNUSED(state); }
 	private:		
 		bool error_stop = false;
 		QCheckBox *stop = new QCheckBox("Stop on unlikely");
 		QLineEdit *base_input = new QLineEdit("0500");
 		QLabel *base_text = new QLabel("Base address");
-		static const QList<disassembler_core::opcode> opcode_list;
+		QPushButton *scan_button = new QPushButton("Find uploads");
+		QComboBox *upload_list = new QComboBox();
+		QVector<spc_upload_scanner::block> upload_blocks;
+		static const char *const mnemonic_names[];
 		static const QSet<unsigned char> unlikely;
 		
 		unsigned int base = 0x0500;
@@ -12,10 +12,24 @@ void address_display::paintEvent(QPaintEvent *event)
 	text_display::paintEvent(event);
 }
 
+int address_display::get_line_characters() const
+{
+	return buffer->get_symbols().is_empty() ? line_characters : line_characters + symbol_characters;
+}
+
+//The first symbol inside the row is shown after its address
 void address_display::get_line(int start, int end, QTextStream &stream)
 {
-	Q_UNUSED(end);
 	stream << buffer->get_formatted_address(start) << ": ";
+	const symbol_table &symbols = buffer->get_symbols();
+	int address = buffer->pc_to_snes(start);
+	if(symbols.is_empty() || address < 0){
+		return;
+	}
+	QVector<int> row_symbols = symbols.range(address, address + end - start);
+	if(!row_symbols.isEmpty()){
+		stream << symbols.name(row_symbols.first()).left(symbol_characters - 1);
+	}
 }
 
 int address_display::screen_to_nibble(QPoint position, bool byte_align)
@@ -11,7 +11,7 @@ class address_display : public text_display
 	protected:
 		virtual void paintEvent(QPaintEvent *event);
 		
-		virtual int get_line_characters() const { return line_characters; }
+		virtual int get_line_characters() const;
 		virtual void get_line(int start, int end, QTextStream &stream);
 		
 		virtual int screen_to_nibble(QPoint position, bool byte_align = false);
@@ -22,6 +22,7 @@ class address_display : public text_display
 		
 	private:
 		const int line_characters = 9;
+		const int symbol_characters = 16;
 		
 };
 
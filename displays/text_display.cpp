@@ -22,6 +22,7 @@ text_display::text_display(const ROM_buffer *b, hex_editor *parent) :
 	
 	settings_manager::add_listener(this, {"display/highlight",
 						"display/diff"});
+	settings_manager::add_listener(this, overlay_keys);
 	connect(editor_font::instance(), &editor_font::font_changed, this, &text_display::update_size);
 }
 
@@ -74,19 +75,12 @@ void text_display::paintEvent(QPaintEvent *event)
 	painter.setFont(editor_font::get_font());
 	painter.setClipping(true);
 	
-	const bookmark_map *bookmarks = buffer->get_bookmark_map();
-	if(bookmarks){
-		for(const auto &bookmark : *bookmarks){
-			selection bookmark_selection = selection::create_selection(
-							buffer->snes_to_pc(bookmark.address), bookmark.size);
-			//non-sequential just skip
-			if(bookmark_selection.get_end_byte() < offset || 
-			   bookmark_selection.get_start_byte() > end_offset){
-				continue;
-			}
-			paint_selection(painter, bookmark_selection, bookmark.color);
-		}
-	}
+	paint_overlay(painter, offset, qMin(end_offset, buffer->size()));
+	
+	buffer->get_bookmarks().overlapping(offset, end_offset, [&](const bookmark_index::interval &bookmark){
+		selection bookmark_selection = selection::create_selection(bookmark.start, bookmark.end - bookmark.start);
+		paint_selection(painter, bookmark_selection, bookmark.bookmark.color);
+	});
 	
 	if(editor->is_comparing()){
 		auto diffs = editor->get_diff();
@@ -169,6 +163,34 @@ void text_display::paint_selection(QPainter &painter, selection &selection_area,
 	                 position2.y() - position1.y() + editor_font::get_height(), color);
 }
 
+//Each row finds its first run with one binary search and then walks forward through the runs it covers
+void text_display::paint_overlay(QPainter &painter, int start, int end)
+{
+	const type_overlay &overlay = buffer->get_overlay();
+	if(overlay.is_empty() || focusPolicy() == Qt::NoFocus){
+		return;
+	}
+	painter.setClipping(false);
+	for(int row_start = start, row = 0; row_start < end; row_start += get_columns(), row++){
+		int row_end = qMin(row_start + get_columns(), end);
+		for(int run = overlay.find(row_start); run != -1 && run < overlay.run_count(); run++){
+			int run_start = qMax(overlay.run_start(run), row_start);
+			int run_end = qMin(overlay.run_end(run), row_end);
+			if(run_start >= row_end){
+				break;
+			}
+			const QColor &color = overlay_colors[overlay.run_kind(run)];
+			if(!color.isValid()){
+				continue;
+			}
+			int x1 = nibble_to_screen(run_start * 2).x();
+			int x2 = nibble_to_screen(run_end * 2 - 1).x() + editor_font::get_width();
+			painter.fillRect(x1, row * editor_font::get_height(), x2 - x1, editor_font::get_height(), color);
+		}
+	}
+	painter.setClipping(true);
+}
+
 bool text_display::event(QEvent *event)
 {
 	if(event->type() == (QEvent::Type)SETTINGS_EVENT){
@@ -177,6 +199,11 @@ bool text_display::event(QEvent *event)
 			selection_color = e->data().second.value<QColor>();
 		}else if(e->data().first == "display/diff"){
 			diff_color = e->data().second.value<QColor>();
+		}else if(e->data().first.startsWith("display/overlay_")){
+			int kind = overlay_keys.indexOf(e->data().first);
+			if(kind != -1){
+				overlay_colors[kind + type_overlay::CODE] = e->data().second.value<QColor>();
+			}
 		}
 		
 		return true;
@@ -279,3 +306,7 @@ bool text_display::comparing = false;
 
 QColor text_display::selection_color;
 QColor text_display::diff_color;
+QColor text_display::overlay_colors[type_overlay::KIND_COUNT];
+const QStringList text_display::overlay_keys = {"display/overlay_code", "display/overlay_data", 
+                                                "display/overlay_pointer", "display/overlay_text", 
+                                                "display/overlay_free"};
@@ -49,6 +49,7 @@ class text_display : public QWidget
 		
 		virtual void paintEvent(QPaintEvent *event);
 		virtual void paint_selection(QPainter &painter, selection &selection_area, const QColor &color);
+		void paint_overlay(QPainter &painter, int start, int end);
 		virtual bool event(QEvent *event);
 		virtual void mousePressEvent(QMouseEvent *event);
 		virtual void mouseMoveEvent(QMouseEvent *event);
@@ -82,6 +83,8 @@ class text_display : public QWidget
 		static const int cursor_width = 1;
 		static QColor selection_color;
 		static QColor diff_color;
+		static QColor overlay_colors[type_overlay::KIND_COUNT];
+		static const QStringList overlay_keys;
 		
 		static int rows;
 		static int columns;
@@ -22,6 +22,11 @@ enum editor_events{
 	CLOSE_COMPARE,
 	NEXT,
 	PREVIOUS,
+	ANALYZE,
+	IMPORT_SYMBOLS,
+	EXPORT_SYMBOLS,
+	EXPORT_SOURCE,
+	IMPORT_TRACE,
 	EDITOR_EVENT_MAX
 };
 
@@ -43,6 +48,9 @@ enum dialog_events{
         FIND_REPLACE,
         GOTO,
         EXPAND,
+	CONVERT_MAPPER,
+	DECOMPRESS,
+	FREE_SPACE,
         METADATA_EDITOR,
         MAP_EDITOR,
 	SETTINGS,
@@ -53,6 +61,9 @@ enum dialog_events{
 enum panel_events{
 	DISASSEMBLER = DIALOG_EVENT_MAX+1,
 	BOOKMARKS,
+	XREFS,
+	TILES,
+	PALETTE,
 	PANEL_EVENT_MAX
 };
 
@@ -0,0 +1,21 @@
+#include "bgr555.h"
+
+//The channels are moved into the byte lanes of a QRgb first, then widened together. Shifting up by three
+//and filling the low bits with the top three keeps 0x1F at full brightness. The loop has no branches,
+//so the compiler is free to vectorize it.
+QVector<QRgb> bgr555::to_rgb(const uchar *data, int count)
+{
+	QVector<QRgb> colors(count);
+	QRgb *out = colors.data();
+	for(int i = 0; i < count; i++){
+		quint32 word = data[i * 2] | data[i * 2 + 1] << 8;
+		quint32 lanes = (word & 0x001F) << 16 | (word & 0x03E0) << 3 | (word & 0x7C00) >> 10;
+		out[i] = 0xFF000000 | lanes << 3 | (lanes >> 2 & 0x070707);
+	}
+	return colors;
+}
+
+unsigned short bgr555::from_rgb(QRgb color)
+{
+	return qRed(color) >> 3 | (qGreen(color) >> 3) << 5 | (qBlue(color) >> 3) << 10;
+}
@@ -0,0 +1,15 @@
+#ifndef BGR555_H
+#define BGR555_H
+
+#include <QColor>
+#include <QVector>
+
+//SNES colors are little endian words with five bits each of red, green and blue, red in the lowest bits
+class bgr555
+{
+	public:
+		static QVector<QRgb> to_rgb(const uchar *data, int count);
+		static unsigned short from_rgb(QRgb color);
+};
+
+#endif // BGR555_H
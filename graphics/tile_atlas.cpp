@@ -0,0 +1,75 @@
+#include <cstring>
+
+#include "tile_atlas.h"
+
+tile_atlas::tile_atlas()
+{
+	reserve(columns);
+}
+
+void tile_atlas::set_format(tile_format::formats new_format)
+{
+	if(format != new_format){
+		format = new_format;
+		clear();
+	}
+}
+
+void tile_atlas::set_palette(const QVector<QRgb> &colors)
+{
+	indexed.setColorTable(colors);
+	changed = true;
+}
+
+//Rounded up to whole atlas rows, shrinking keeps what is already decoded
+void tile_atlas::reserve(int tiles)
+{
+	tiles = (tiles + columns - 1) / columns * columns;
+	if(tiles <= offsets.size()){
+		return;
+	}
+	QVector<QRgb> colors = indexed.colorTable();
+	indexed = QImage(columns * tile_format::tile_width, tiles / columns * tile_format::tile_width, 
+	                 QImage::Format_Indexed8);
+	indexed.setColorTable(colors);
+	offsets.resize(tiles);
+	sources.resize(tiles * tile_format::tile_size(tile_format::MODE7));
+	clear();
+}
+
+void tile_atlas::clear()
+{
+	offsets.fill(-1);
+	changed = true;
+}
+
+//Tiles running past the end of the ROM are padded with zero
+QRect tile_atlas::tile(const char *rom, int rom_size, int offset)
+{
+	int size = tile_format::tile_size(format);
+	int slot = offset / size % offsets.size();
+	QRect area(slot % columns * tile_format::tile_width, slot / columns * tile_format::tile_width, 
+	           tile_format::tile_width, tile_format::tile_width);
+	
+	uchar data[64] = {};
+	memcpy(data, rom + offset, qMin(size, rom_size - offset));
+	char *source = sources.data() + slot * sizeof(data);
+	if(offsets[slot] == offset && !memcmp(source, data, size)){
+		return area;
+	}
+	offsets[slot] = offset;
+	memcpy(source, data, size);
+	tile_format::decode(format, data, indexed.scanLine(area.y()) + area.x(), indexed.bytesPerLine());
+	changed = true;
+	return area;
+}
+
+//Painting an indexed image converts it every time, so the converted atlas is kept until a tile or the palette changes
+const QImage &tile_atlas::image()
+{
+	if(changed){
+		converted = indexed.convertToFormat(QImage::Format_RGB32);
+		changed = false;
+	}
+	return converted;
+}
@@ -0,0 +1,35 @@
+#ifndef TILE_ATLAS_H
+#define TILE_ATLAS_H
+
+#include <QImage>
+#include <QVector>
+
+#include "tile_format.h"
+
+//Decoded tiles in an indexed image with a slot for each tile in a ring a few screens long.
+//Slots keep the bytes they were decoded from, so a tile is only decoded again when it scrolls into view
+//or its bytes were edited. The palette is the image's color table and never needs a decode.
+class tile_atlas
+{
+	public:
+		tile_atlas();
+		void set_format(tile_format::formats new_format);
+		void set_palette(const QVector<QRgb> &colors);
+		void reserve(int tiles);
+		QRect tile(const char *rom, int rom_size, int offset);
+		const QImage &image();
+		
+	private:
+		static const int columns = 16;
+		
+		tile_format::formats format = tile_format::BPP4;
+		QImage indexed;
+		QImage converted;
+		QVector<int> offsets;
+		QByteArray sources;
+		bool changed = true;
+		
+		void clear();
+};
+
+#endif // TILE_ATLAS_H
@@ -0,0 +1,37 @@
+#include <QtEndian>
+#include <cstring>
+
+#include "tile_format.h"
+
+QString tile_format::name(formats format)
+{
+	static const char *names[] = {"2bpp", "4bpp", "8bpp", "Mode 7"};
+	return names[format];
+}
+
+//Moves each bit of a plane byte into the low bit of its own byte lane, the leftmost pixel in the lowest lane
+inline quint64 tile_format::spread(uchar plane)
+{
+	quint64 lanes = (plane * 0x0101010101010101ULL) & 0x0102040810204080ULL;
+	return ((lanes + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+}
+
+//Transposes a whole row of eight pixels at once, each plane is shifted into place over all lanes
+void tile_format::decode(formats format, const uchar *data, uchar *pixels, int stride)
+{
+	if(format == MODE7){
+		for(int row = 0; row < tile_width; row++){
+			memcpy(pixels + row * stride, data + row * tile_width, tile_width);
+		}
+		return;
+	}
+	int pairs = tile_size(format) / 16;
+	for(int row = 0; row < tile_width; row++){
+		quint64 indexes = 0;
+		for(int pair = 0; pair < pairs; pair++){
+			const uchar *planes = data + pair * 16 + row * 2;
+			indexes |= spread(planes[0]) << (pair * 2) | spread(planes[1]) << (pair * 2 + 1);
+		}
+		qToLittleEndian(indexes, pixels + row * stride);
+	}
+}
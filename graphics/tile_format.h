@@ -0,0 +1,30 @@
+#ifndef TILE_FORMAT_H
+#define TILE_FORMAT_H
+
+#include <QString>
+#include <QtGlobal>
+
+//SNES tiles are 8x8. The planar formats store each row as a byte of one bitplane next to a byte of the
+//next, every further pair of planes comes 16 bytes after the last. Mode 7 tiles are a byte per pixel.
+class tile_format
+{
+	public:
+		enum formats{
+			BPP2,
+			BPP4,
+			BPP8,
+			MODE7
+		};
+		
+		static const int tile_width = 8;
+		
+		static QString name(formats format);
+		static int tile_size(formats format){ return format == BPP2 ? 16 : format == BPP4 ? 32 : 64; }
+		static int color_count(formats format){ return format == BPP2 ? 4 : format == BPP4 ? 16 : 256; }
+		static void decode(formats format, const uchar *data, uchar *pixels, int stride);
+		
+	private:
+		static quint64 spread(uchar plane);
+};
+
+#endif // TILE_FORMAT_H
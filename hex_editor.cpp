@@ -1,5 +1,7 @@
 #include <QMenu>
 #include <QMessageBox>
+#include <QElapsedTimer>
+#include <QFileDialog>
 
 #include "hex_editor.h"
 #include "character_mapper.h"
@@ -9,6 +11,12 @@
 #include "debug.h"
 #include "utility.h"
 #include "settings_manager.h"
+#include "analysis/code_analyzer.h"
+#include "analysis/analysis_cache.h"
+#include "analysis/source_exporter.h"
+#include "analysis/gsu_analyzer.h"
+#include "analysis/cpu_tracer.h"
+#include "analysis/trace_importer.h"
 
 hex_editor::hex_editor(QWidget *parent, QString file_name, QUndoGroup *undo_group, bool new_file) :
         QWidget(parent)
@@ -23,8 +31,33 @@ hex_editor::hex_editor(QWidget *parent, QString file_name, QUndoGroup *undo_grou
 	
 	if(new_file){
 		update_save_state(1);
+	}else{
+		code_map map;
+		if(analysis_cache::load(buffer, map)){
+			buffer->set_code_map(map);
+		}else{
+			buffer->update_overlay();
+		}
 	}
-	
+	create_displays();
+}
+
+//A decompressed block, every change is compressed again and written over the block in the source ROM
+hex_editor::hex_editor(QWidget *parent, hex_editor *source, const compressed_block &b, QUndoGroup *undo_group) :
+        QWidget(parent)
+{
+	block = b;
+	block_source = source;
+	QString address = to_hex(source->get_buffer()->pc_to_snes(block.offset), 6);
+	buffer = new ROM_buffer(source->get_file_name() + " $" + address + ' ' + block.codec, block.data);
+	buffer->initialize_undo(undo_group);
+	is_new = false;
+	create_displays();
+	connect(source, &hex_editor::buffer_changed, this, &hex_editor::reload_block);
+}
+
+void hex_editor::create_displays()
+{
 	setContextMenuPolicy(Qt::CustomContextMenu);
 	connect(this, &hex_editor::customContextMenuRequested, this, &hex_editor::context_menu);
 	
@@ -63,6 +96,19 @@ hex_editor::hex_editor(QWidget *parent, QString file_name, QUndoGroup *undo_grou
 	settings_manager::add_persistent_listener(this, "display/font");
 }
 
+void hex_editor::save(QString path)
+{
+	if(is_block()){
+		if(save_state && write_back()){
+			save_state = 0;
+			emit save_state_changed(true);
+		}
+		return;
+	}
+	buffer->save(path);
+	update_save_state(-save_state);
+}
+
 void hex_editor::set_focus()
 {
 	emit update_status_text(get_status_text());
@@ -192,10 +238,12 @@ void hex_editor::update_window()
 	if(!scroll_mode){
 		emit update_range(get_max_lines()+1);
 		emit update_slider(offset / text_display::get_columns());
+		emit offset_changed(offset);
 	}else{
 		emit update_range(height());
 	}
 	emit update_status_text(get_status_text());
+	emit cursor_moved(cursor_nibble / 2);
 	ascii->update_display();
 	hex->update_display();
 	address->update_display();
@@ -233,6 +281,16 @@ void hex_editor::handle_typed_character(unsigned char key, bool update_byte)
 	update_save_state(1);
 }
 
+void hex_editor::update_color(int position, unsigned short color)
+{
+	if(position < 0 || position + 1 >= buffer->size()){
+		return;
+	}
+	buffer->update_color(color, position);
+	update_save_state(1);
+	update_window();
+}
+
 void hex_editor::update_undo_action(bool direction)
 {
 	update_save_state((direction << 1) + -1);
@@ -393,6 +451,121 @@ void hex_editor::disassemble()
 	emit send_disassemble_data(selection_area, buffer);
 }
 
+void hex_editor::analyze()
+{
+	QElapsedTimer timer;
+	timer.start();
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	code_analyzer analyzer(buffer);
+	analyzer.add_vectors();
+	if(buffer->get_bookmark_map()){
+		analyzer.add_bookmarks(*buffer->get_bookmark_map());
+	}
+	QVector<quint64> hashes = analysis_cache::bank_hashes(buffer);
+	analyzer.resume(buffer->get_code_map(), hashes);
+	code_map map = analyzer.run();
+	map.set_bank_hashes(hashes);
+	
+	//Running the code settles the register sizes static analysis had to guess after PLP, RTI and jump tables
+	cpu_tracer tracer(buffer);
+	int traced = tracer.run(cpu_tracer::default_steps);
+	map = map.overlay(tracer.get_map());
+	buffer->set_code_map(map);
+	analysis_cache::save(buffer, map);
+	
+	QString gsu_text;
+	if(buffer->get_mapper() == SUPERFXROM){
+		gsu_analyzer gsu(buffer);
+		gsu.add_starts(map);
+		buffer->set_gsu_map(gsu.run());
+		gsu_text = ", " + QString::number(buffer->get_gsu_map().instruction_count()) + " GSU instructions";
+	}
+	QApplication::restoreOverrideCursor();
+	emit update_status_text(QString::number(buffer->get_code_map().instruction_count()) + 
+	                        " instructions" + gsu_text + " found, " + QString::number(traced) + 
+	                        " steps traced in " + QString::number(timer.elapsed()) + "ms");
+}
+
+void hex_editor::import_symbols()
+{
+	QString path = QFileDialog::getOpenFileName(this, "Import symbols", QDir::currentPath(), 
+	                                            "Symbol files (*.sym);;All files(*.*)");
+	if(path.isEmpty()){
+		return;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	int imported = buffer->get_symbols().import_file(path);
+	if(imported == -1){
+		emit update_status_text("Could not open " + path);
+		return;
+	}
+	emit update_status_text(QString::number(imported) + " symbols imported in " + 
+	                        QString::number(timer.elapsed()) + "ms");
+	address->invalidate_cache();
+	address->update_size();
+	update_window();
+}
+
+void hex_editor::export_symbols()
+{
+	QString path = QFileDialog::getSaveFileName(this, "Export symbols", QDir::currentPath(), 
+	                                            "Symbol files (*.sym);;All files(*.*)");
+	if(path.isEmpty()){
+		return;
+	}
+	if(!buffer->get_symbols().export_file(path)){
+		emit update_status_text("Could not write " + path);
+	}
+}
+
+void hex_editor::export_source()
+{
+	if(is_block()){
+		return;
+	}
+	QString directory = QFileDialog::getExistingDirectory(this, "Export source", QDir::currentPath());
+	if(directory.isEmpty()){
+		return;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	source_exporter exporter(buffer);
+	bool written = exporter.write(directory);
+	QApplication::restoreOverrideCursor();
+	emit update_status_text(written ? "Source exported in " + QString::number(timer.elapsed()) + "ms" : 
+	                                  exporter.get_error());
+}
+
+void hex_editor::import_trace()
+{
+	QString path = QFileDialog::getOpenFileName(this, "Import trace", QDir::currentPath(), 
+	                                            "Trace logs (*.log *.txt);;Code data logs (*.cdl);;All files(*.*)");
+	if(path.isEmpty()){
+		return;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	trace_importer importer(buffer);
+	bool imported = importer.import_file(path);
+	if(imported){
+		code_map map = buffer->get_code_map().overlay(importer.get_map());
+		buffer->set_code_map(map);
+		analysis_cache::save(buffer, map);
+	}
+	QApplication::restoreOverrideCursor();
+	if(!imported){
+		emit update_status_text("Could not import " + path);
+		return;
+	}
+	QString lines = importer.get_lines() ? QString::number(importer.get_lines()) + " lines, " : "";
+	emit update_status_text(lines + QString::number(importer.get_map().instruction_count()) + 
+	                        " instructions imported in " + QString::number(timer.elapsed()) + "ms");
+	update_window();
+}
+
 void hex_editor::create_bookmark()
 {
 	if(!selection_area.is_active()){
@@ -401,6 +574,141 @@ void hex_editor::create_bookmark()
 	emit send_bookmark_data(selection_area.get_start_byte(), selection_area.get_end_byte(), buffer);
 }
 
+void hex_editor::convert_mapper(int mapper, bool relocate)
+{
+	if(is_block() || !buffer->is_active()){
+		return;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	QString from = ROM_metadata::mapper_strings[buffer->get_mapper()].second;
+	QString to = ROM_metadata::mapper_strings[mapper].second;
+	QVector<int> addresses;
+	if(relocate && buffer->get_bookmark_map()){
+		for(const auto &bookmark : *buffer->get_bookmark_map()){
+			addresses.append(bookmark.address);
+		}
+	}
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	auto relocated = [this](const QVector<int> &old_addresses, const QVector<int> &new_addresses){
+		emit bookmarks_relocated(old_addresses, new_addresses);
+	};
+	bool converted = buffer->convert_mapper((memory_mapper)mapper, addresses, relocated);
+	QApplication::restoreOverrideCursor();
+	if(!converted){
+		emit update_status_text("The ROM does not fit " + to + " when converted from " + from);
+		return;
+	}
+	selection_area.set_active(false);
+	cursor_nibble = qMin(cursor_nibble, buffer->size() * 2 - 1);
+	offset = clamp(offset, 0, buffer->size() - text_display::get_rows_by_columns());
+	update_save_state(1);
+	update_window();
+	emit update_status_text("Converted " + from + " to " + to + " in " + QString::number(timer.elapsed()) + "ms");
+}
+
+void hex_editor::expand_ROM(int size, QByteArray pattern, bool mirror)
+{
+	if(is_block() || !buffer->is_active()){
+		return;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	int old_size = buffer->size();
+	if(!buffer->expand(size, pattern, mirror)){
+		emit update_status_text("The ROM can not be expanded to " + QString::number(size, 16).toUpper() + " bytes");
+		return;
+	}
+	update_save_state(1);
+	update_window();
+	QString sizes = QString::number(old_size, 16).toUpper() + " to " + QString::number(size, 16).toUpper();
+	emit update_status_text("Expanded the ROM from " + sizes + " bytes in " + QString::number(timer.elapsed()) + "ms");
+}
+
+void hex_editor::decompress(QString codec_name, int address)
+{
+	if(!buffer->is_active()){
+		return;
+	}
+	const codec *decoder = codec::find(codec_name);
+	compressed_block decompressed;
+	if(!decoder || !decoder->read_block(buffer->data(), buffer->size(), buffer->snes_to_pc(address), decompressed)){
+		emit update_status_text("No valid " + codec_name + " data at $" + to_hex(address, 6));
+		return;
+	}
+	emit block_opened(decompressed);
+}
+
+//Called on the source ROM of a block tab, the compressed data always fits the space the block had
+void hex_editor::write_block(int block_offset, const QByteArray &compressed)
+{
+	if(buffer->overwrite(block_offset, compressed, "Recompress block")){
+		update_save_state(1);
+	}else{
+		emit buffer_changed(); //Merged into the last write, still the same undo step
+	}
+	update_window();
+}
+
+//The claimed space is selected, so a patch can be pasted straight over it
+void hex_editor::claim_free_space(int length, int first_bank, int last_bank)
+{
+	if(is_block() || !buffer->is_active()){
+		return;
+	}
+	int start = buffer->allocate(length, first_bank, last_bank);
+	QString banks = "$" + to_hex(first_bank) + "-$" + to_hex(last_bank);
+	if(start == -1){
+		emit update_status_text("No free run of " + QString::number(length, 16).toUpper() + " bytes in banks " + banks);
+		return;
+	}
+	select_range(buffer->pc_to_snes(start), buffer->pc_to_snes(start + length - 1));
+	emit update_status_text("Claimed " + QString::number(length, 16).toUpper() + " bytes at $" + to_hex(buffer->pc_to_snes(start), 6));
+}
+
+//The source ROM changed under the block, by an undo for example. Writing back leaves the bytes as they
+//decompress here, so only a real difference reloads the block and drops its history.
+void hex_editor::reload_block()
+{
+	compressed_block current;
+	const ROM_buffer *source = block_source->get_buffer();
+	if(!codec::find(block.codec)->read_block(source->data(), source->size(), block.offset, current)){
+		emit update_status_text("The block no longer decompresses from the source ROM");
+		return;
+	}
+	if(current.data == QByteArray::fromRawData(buffer->data(), buffer->size())){
+		return;
+	}
+	buffer->reload(current.data);
+	selection_area.set_active(false);
+	cursor_nibble = qMin(cursor_nibble, buffer->size() * 2 - 1);
+	offset = clamp(offset, 0, qMax(0, buffer->size() - text_display::get_rows_by_columns()));
+	save_state = 0;
+	emit save_state_changed(true);
+	emit buffer_changed();
+	update_window();
+}
+
+bool hex_editor::write_back()
+{
+	if(!block_source){
+		emit update_status_text("The ROM this block came from has been closed");
+		return false;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	QByteArray compressed = codec::find(block.codec)->compress(QByteArray(buffer->data(), buffer->size()));
+	if(compressed.size() > block.size){
+		int over = compressed.size() - block.size;
+		emit update_status_text("The block compresses " + QString::number(over) + " bytes larger than its space in the ROM");
+		return false;
+	}
+	block_source->write_block(block.offset, compressed);
+	QString sizes = QString::number(buffer->size()) + " bytes to " + QString::number(compressed.size());
+	emit update_status_text("Compressed " + sizes + " in " + QString::number(timer.elapsed()) + "ms");
+	return true;
+}
+
 void hex_editor::count(QString find, bool mode)
 {
 	if(!buffer->is_active()){
@@ -575,6 +883,21 @@ bool hex_editor::event(QEvent *event)
 		case editor_events::DISASSEMBLE:
 			disassemble();
 			return true;
+		case editor_events::ANALYZE:
+			analyze();
+			return true;
+		case editor_events::IMPORT_SYMBOLS:
+			import_symbols();
+			return true;
+		case editor_events::EXPORT_SYMBOLS:
+			export_symbols();
+			return true;
+		case editor_events::EXPORT_SOURCE:
+			export_source();
+			return true;
+		case editor_events::IMPORT_TRACE:
+			import_trace();
+			return true;
 		case editor_events::BOOKMARK:
 			create_bookmark();
 			return true;
@@ -628,10 +951,18 @@ void hex_editor::calculate_diff()
 	}
 }
 
+//Block tabs are written back on every change, so they only stay modified while the block does not fit
 void hex_editor::update_save_state(int direction)
 {
+	bool changed = direction;
+	if(is_block() && direction && write_back()){
+		direction = -save_state;
+	}
 	save_state += direction;
 	emit save_state_changed(!save_state);
+	if(changed){
+		emit buffer_changed();
+	}
 	if(comparing){
 		calculate_diff();
 	}
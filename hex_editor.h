@@ -1,10 +1,13 @@
 #ifndef HEX_EDITOR_H
 #define HEX_EDITOR_H
 
+#include <QPointer>
+
 #include "events/event_types.h"
 #include "selection.h"
 #include "rom_buffer.h"
 #include "panels/bookmark_panel.h"
+#include "compression/codec.h"
 
 class hex_display;
 class ascii_display;
@@ -15,6 +18,7 @@ class hex_editor : public QWidget
 	Q_OBJECT
 	public:
 		explicit hex_editor(QWidget *parent, QString file_name, QUndoGroup *undo_group, bool new_file = false);
+		hex_editor(QWidget *parent, hex_editor *source, const compressed_block &b, QUndoGroup *undo_group);
 		~hex_editor();
 		void set_focus();
 		void compare(QString file);
@@ -28,9 +32,12 @@ class hex_editor : public QWidget
 		QString load_error() { return ROM_error; }
 		QString get_file_name() { return buffer->get_file_name(); }
 		int get_relative_position(int address){ return cursor_nibble / 2 + address; }
-		void save(QString path) { buffer->save(path); update_save_state(-save_state); }
+		void save(QString path);
 		bool can_save(){ return save_state; }
 		bool new_file(){ return is_new; }
+		bool is_block() const { return !block.codec.isEmpty(); }
+		bool is_ROM() const { return !is_block(); }
+		void write_block(int block_offset, const QByteArray &compressed);
 		
 		bool is_comparing(){ return comparing; }
 		bool is_selecting(){ return selection_area.is_active(); }
@@ -52,7 +59,12 @@ class hex_editor : public QWidget
 		void toggle_scroll_mode(bool mode);
 		void save_state_changed(bool save);
 		void send_disassemble_data(selection selection_area, const ROM_buffer *buffer);
+		void offset_changed(int offset);
+		void cursor_moved(int offset);
+		void buffer_changed();
 		void send_bookmark_data(int start, int end, const ROM_buffer *buffer);
+		void bookmarks_relocated(QVector<int> from, QVector<int> to);
+		void block_opened(compressed_block block);
 
 	public slots:
 		void update_window();
@@ -71,7 +83,18 @@ class hex_editor : public QWidget
 		void branch();
 		void jump();
 		void disassemble();
+		void analyze();
+		void import_symbols();
+		void export_symbols();
+		void export_source();
+		void import_trace();
 		void create_bookmark();
+		void convert_mapper(int mapper, bool relocate);
+		void expand_ROM(int size, QByteArray pattern, bool mirror);
+		void decompress(QString codec_name, int address);
+		void claim_free_space(int length, int first_bank, int last_bank);
+		void reload_block();
+		void update_color(int position, unsigned short color);
 		void count(QString find, bool mode);
 		void search(QString find, bool direction, bool mode);
 		void replace(QString find, QString replace, bool direction, bool mode);
@@ -106,10 +129,14 @@ class hex_editor : public QWidget
 		QString ROM_error = "";
 		int cursor_nibble = 0;
 		selection selection_area;
+		compressed_block block;
+		QPointer<hex_editor> block_source;
 		
 		static bool wheel_cursor;
 		static bool prompt_resize;
 		
+		void create_displays();
+		bool write_back();
 		void handle_search_result(QString target, int result, bool mode);
 		void calculate_diff();
 		void update_save_state(int direction);
@@ -1,4 +1,8 @@
 #include "main_window.h"
+#include "rom_buffer.h"
+#include "analysis/code_analyzer.h"
+#include "analysis/analysis_cache.h"
+#include "analysis/source_exporter.h"
 #include "debug.h"
 
 void message_handler(QtMsgType type, const char *message)
@@ -36,6 +40,30 @@ int main(int argc, char *argv[])
 	
 	QCoreApplication::setOrganizationName("p4programing");
 	QCoreApplication::setApplicationName("shex");
+	
+	//Headless export for build scripts: shex --export-source <rom> <directory>
+	QStringList arguments = a.arguments();
+	if(arguments.size() == 4 && arguments.at(1) == "--export-source"){
+		ROM_buffer buffer(arguments.at(2));
+		if(buffer.load_error() != ""){
+			qWarning() << buffer.load_error();
+			return 1;
+		}
+		code_map map;
+		if(!analysis_cache::load(&buffer, map)){
+			code_analyzer analyzer(&buffer);
+			analyzer.add_vectors();
+			map = analyzer.run();
+			map.set_bank_hashes(analysis_cache::bank_hashes(&buffer));
+		}
+		buffer.set_code_map(map);
+		source_exporter exporter(&buffer);
+		if(!exporter.write(arguments.at(3))){
+			qWarning() << exporter.get_error();
+			return 1;
+		}
+		return 0;
+	}
 	     
 	main_window window;
 	window.show();
@@ -242,6 +242,7 @@ void main_window::init_connections(hex_editor *editor, dynamic_scrollbar *scroll
 	connect(editor, &hex_editor::toggle_scroll_mode, scrollbar, &dynamic_scrollbar::toggle_mode);
 	connect(editor, &hex_editor::update_status_text, statusbar, &QLabel::setText);
 	connect(editor, &hex_editor::save_state_changed, this, &main_window::file_save_state);
+	connect(editor, &hex_editor::block_opened, this, [=](compressed_block block){ create_block_tab(editor, block); });
 	
 	dialog_controller->connect_to_editor(editor);
 	panel->connect_to_editor(editor);
@@ -254,7 +255,6 @@ void main_window::init_connections(hex_editor *editor, dynamic_scrollbar *scroll
 void main_window::create_new_tab(QString name, bool new_file)
 {
 	QWidget *widget = new QWidget(this);
-	QSize window_size = size();
 	hex_editor *editor = new hex_editor(widget, name, undo_group, new_file);
 	if(editor->load_error() != ""){
 		QMessageBox::critical(this, "Invalid ROM", editor->load_error(), QMessageBox::Ok);
@@ -262,6 +262,19 @@ void main_window::create_new_tab(QString name, bool new_file)
 		delete widget;
 		return;
 	}
+	add_tab(widget, editor, QFileInfo(name).fileName());
+}
+
+void main_window::create_block_tab(hex_editor *source, const compressed_block &block)
+{
+	QWidget *widget = new QWidget(this);
+	hex_editor *editor = new hex_editor(widget, source, block, undo_group);
+	add_tab(widget, editor, editor->get_file_name());
+}
+
+void main_window::add_tab(QWidget *widget, hex_editor *editor, QString title)
+{
+	QSize window_size = size();
 	dynamic_scrollbar *scrollbar = new dynamic_scrollbar(editor);
 	panel_manager *panel_controller = new panel_manager(editor);
 	init_connections(editor, scrollbar, panel_controller);
@@ -271,7 +284,7 @@ void main_window::create_new_tab(QString name, bool new_file)
 	hex_layout->addWidget(scrollbar);
 	hex_layout->addWidget(panel_controller);
 	widget->setLayout(hex_layout);
-	tab_widget->addTab(widget, QFileInfo(name).fileName());
+	tab_widget->addTab(widget, title);
 	
 	tab_widget->setCurrentWidget(widget);
 	editor->set_focus();
@@ -7,6 +7,7 @@
 #include "menu_manager.h"
 #include "rom_buffer.h"
 #include "editor_font.h"
+#include "compression/codec.h"
 #include "debug.h"
 
 class hex_editor;
@@ -48,6 +49,8 @@ class main_window : public QMainWindow
 
 		void init_connections(hex_editor *editor, dynamic_scrollbar *scrollbar, panel_manager *panel);
 		void create_new_tab(QString name, bool new_file = false);
+		void create_block_tab(hex_editor *source, const compressed_block &block);
+		void add_tab(QWidget *widget, hex_editor *editor, QString title);
 		hex_editor *get_editor(int i) const;
 		
 };
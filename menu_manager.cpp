@@ -74,6 +74,7 @@ void menu_manager::create_actions(QUndoGroup *undo_group)
 	toggle_function active_branch     = []() -> bool { MENU_TEST(follow_selection(true)); };
 	toggle_function active_selection  = []() -> bool { MENU_TEST(is_selecting()); };
 	toggle_function active_compare    = []() -> bool { MENU_TEST(is_comparing()); };
+	toggle_function active_ROMs       = []() -> bool { MENU_TEST(is_ROM()); };
 	toggle_function clipboard_usable  = []() -> bool { MENU_TEST(is_pasteable()); };
 	#undef MENU_TEST
 	
@@ -104,12 +105,20 @@ void menu_manager::create_actions(QUndoGroup *undo_group)
 	add_toggle_action<dialog_event>("&Goto offset",  GOTO,         active_editors,   hotkey("Ctrl+g"),  menu);
 	
 	menu = find_menu("&ROM utilities");
-	add_toggle_action<dialog_event>("&Expand ROM",      EXPAND,          active_editors,   hotkey("Ctrl+e"), menu);
-	add_toggle_action<dialog_event>("&Metadata editor", METADATA_EDITOR, active_editors,   hotkey("Ctrl+m"), menu);
+	add_toggle_action<dialog_event>("&Expand ROM",      EXPAND,          active_ROMs,      hotkey("Ctrl+e"), menu);
+	add_toggle_action<dialog_event>("&Convert mapper",  CONVERT_MAPPER,  active_ROMs,      hotkey("Ctrl+h"), menu);
+	add_toggle_action<dialog_event>("&Metadata editor", METADATA_EDITOR, active_ROMs,      hotkey("Ctrl+m"), menu);
+	add_toggle_action<dialog_event>("Decom&press",      DECOMPRESS,      active_editors,   hotkey("Ctrl+l"), menu);
+	add_toggle_action<dialog_event>("&Free space",      FREE_SPACE,      active_ROMs,      hotkey("Ctrl+u"), menu);
 	menu->addSeparator();
 	add_toggle_action<editor_event>("Follow b&ranch",   BRANCH,          active_branch,    hotkey("Alt+j"),  menu);
 	add_toggle_action<editor_event>("Follow &jump",     JUMP,            active_jump,      hotkey("Ctrl+j"), menu);
 	add_toggle_action<editor_event>("&Disassemble",     DISASSEMBLE,     active_selection, hotkey("Ctrl+d"), menu);
+	add_toggle_action<editor_event>("&Analyze ROM",     ANALYZE,         active_editors,   hotkey("Alt+a"),  menu);
+	add_toggle_action<editor_event>("&Import symbols",  IMPORT_SYMBOLS,  active_editors,   hotkey("Alt+i"),  menu);
+	add_toggle_action<editor_event>("E&xport symbols",  EXPORT_SYMBOLS,  active_editors,   hotkey("Alt+y"),  menu);
+	add_toggle_action<editor_event>("Export &source",   EXPORT_SOURCE,   active_ROMs,      hotkey("Alt+u"),  menu);
+	add_toggle_action<editor_event>("Import &trace",    IMPORT_TRACE,    active_editors,   hotkey("Alt+t"),  menu);
 	add_toggle_action<editor_event>("&Bookmark",        BOOKMARK,        active_selection, hotkey("Ctrl+b"), menu);
 
 	menu = find_menu("&Compare");
@@ -124,6 +133,9 @@ void menu_manager::create_actions(QUndoGroup *undo_group)
 	add_action       <dialog_event>("&Character map editor", MAP_EDITOR,                  hotkey("Alt+m"), menu);
 	add_check_action <panel_event> ("Disassembly panel",     DISASSEMBLER,                hotkey("Alt+d"), menu);
 	add_check_action <panel_event> ("Bookmark panel",        BOOKMARKS,                   hotkey("Alt+b"), menu);
+	add_check_action <panel_event> ("Xref panel",            XREFS,                       hotkey("Alt+x"), menu);
+	add_check_action <panel_event> ("Tile panel",            TILES,                       hotkey("Alt+l"), menu);
+	add_check_action <panel_event> ("Palette panel",         PALETTE,                     hotkey("Alt+q"), menu);
 	menu->addSeparator();
 	
 	menu->addMenu(find_menu("&Copy style"));
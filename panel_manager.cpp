@@ -1,12 +1,18 @@
 #include "panel_manager.h"
 #include "panels/disassembler_panel.h"
 #include "panels/bookmark_panel.h"
+#include "panels/xref_panel.h"
+#include "panels/tile_panel.h"
+#include "panels/palette_panel.h"
 #include "hex_editor.h"
 
 panel_manager::panel_manager(hex_editor *parent) : QWidget(parent)
 {
 	panel_map[DISASSEMBLER] = new disassembler_panel(this, parent);
 	panel_map[BOOKMARKS] = new bookmark_panel(this, parent);
+	panel_map[XREFS] = new xref_panel(this, parent);
+	panel_map[TILES] = new tile_panel(this, parent);
+	panel_map[PALETTE] = new palette_panel(this, parent);
 	
 	for(auto &panel : panel_map){
 		layout->addWidget(panel->get_display());
@@ -41,8 +47,30 @@ void panel_manager::connect_to_editor(hex_editor *editor)
 {
 	connect(editor, &hex_editor::send_disassemble_data, 
 	        (disassembler_panel *)find_panel(DISASSEMBLER), &disassembler_panel::disassemble);
+	connect(editor, &hex_editor::offset_changed, 
+	        (disassembler_panel *)find_panel(DISASSEMBLER), &disassembler_panel::follow_offset);
+	connect(editor, &hex_editor::cursor_moved, 
+	        (disassembler_panel *)find_panel(DISASSEMBLER), &disassembler_panel::follow_cursor);
+	connect(editor, &hex_editor::buffer_changed, 
+	        (disassembler_panel *)find_panel(DISASSEMBLER), &disassembler_panel::refresh);
 	connect(editor, &hex_editor::send_bookmark_data, 
 	        (bookmark_panel *)find_panel(BOOKMARKS), &bookmark_panel::create_bookmark);
+	connect(editor, &hex_editor::bookmarks_relocated, 
+	        (bookmark_panel *)find_panel(BOOKMARKS), &bookmark_panel::relocate_bookmarks);
+	connect(editor, &hex_editor::cursor_moved, 
+	        (xref_panel *)find_panel(XREFS), &xref_panel::show_references);
+	connect(editor, &hex_editor::buffer_changed, 
+	        (xref_panel *)find_panel(XREFS), &xref_panel::refresh);
+	connect(editor, &hex_editor::offset_changed, 
+	        (tile_panel *)find_panel(TILES), &tile_panel::follow_offset);
+	connect(editor, &hex_editor::buffer_changed, 
+	        (tile_panel *)find_panel(TILES), &tile_panel::refresh);
+	connect(editor, &hex_editor::cursor_moved, 
+	        (palette_panel *)find_panel(PALETTE), &palette_panel::follow_cursor);
+	connect(editor, &hex_editor::buffer_changed, 
+	        (palette_panel *)find_panel(PALETTE), &palette_panel::refresh);
+	connect((palette_panel *)find_panel(PALETTE), &palette_panel::palette_changed, 
+	        (tile_panel *)find_panel(TILES), &tile_panel::set_palette);
 }
 
 abstract_panel *panel_manager::find_panel(panel_events id)
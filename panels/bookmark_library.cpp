@@ -0,0 +1,407 @@
+#include <QFile>
+#include <QtEndian>
+#include <algorithm>
+
+#include "bookmark_library.h"
+#include "debug.h"
+
+//Walks JSON text in place, only strings that become descriptions are ever copied
+struct json_scanner{
+	const char *position;
+	const char *end;
+	
+	void skip_space()
+	{
+		while(position < end && (*position == ' ' || *position == '\n' || *position == '\r' || *position == '\t')){
+			position++;
+		}
+	}
+	
+	bool consume(char c)
+	{
+		skip_space();
+		if(position < end && *position == c){
+			position++;
+			return true;
+		}
+		return false;
+	}
+	
+	char peek()
+	{
+		skip_space();
+		return position < end ? *position : 0;
+	}
+	
+	//Leaves start and length pointing at the raw contents, escapes included
+	bool raw_string(const char *&start, int &length, bool &escaped)
+	{
+		if(!consume('"')){
+			return false;
+		}
+		start = position;
+		escaped = false;
+		while(position < end && *position != '"'){
+			if(*position == '\\'){
+				escaped = true;
+				position++;
+			}
+			position++;
+		}
+		if(position >= end){
+			return false;
+		}
+		length = position - start;
+		position++;
+		return true;
+	}
+	
+	bool string(QString &text)
+	{
+		const char *start;
+		int length;
+		bool escaped;
+		if(!raw_string(start, length, escaped)){
+			return false;
+		}
+		if(!escaped){
+			text = QString::fromUtf8(start, length);
+			return true;
+		}
+		text.clear();
+		text.reserve(length);
+		const char *run = start;
+		for(const char *c = start; c < start + length; c++){
+			if(*c != '\\'){
+				continue;
+			}
+			text += QString::fromUtf8(run, c - run);
+			c++;
+			switch(*c){
+				case 'b': text += '\b'; break;
+				case 'f': text += '\f'; break;
+				case 'n': text += '\n'; break;
+				case 'r': text += '\r'; break;
+				case 't': text += '\t'; break;
+				case 'u':
+					if(c + 4 < start + length){
+						text += QChar(QByteArray(c + 1, 4).toUShort(nullptr, 16));
+						c += 4;
+					}
+				break;
+				default: text += QChar(*c); break;
+			}
+			run = c + 1;
+		}
+		text += QString::fromUtf8(run, start + length - run);
+		return true;
+	}
+	
+	bool number(qint64 &value)
+	{
+		skip_space();
+		bool negative = position < end && *position == '-';
+		position += negative;
+		const char *start = position;
+		value = 0;
+		while(position < end && *position >= '0' && *position <= '9'){
+			value = value * 10 + *position++ - '0';
+		}
+		while(position < end && (*position == '.' || *position == 'e' || *position == 'E' || 
+		                         *position == '+' || *position == '-' || (*position >= '0' && *position <= '9'))){
+			position++; //Fractions are dropped, every field is an integer
+		}
+		value = negative ? -value : value;
+		return position != start;
+	}
+	
+	bool literal(bool &value)
+	{
+		skip_space();
+		if(end - position >= 4 && !memcmp(position, "true", 4)){
+			position += 4;
+			value = true;
+			return true;
+		}else if(end - position >= 5 && !memcmp(position, "false", 5)){
+			position += 5;
+			value = false;
+			return true;
+		}
+		return false;
+	}
+	
+	bool skip_value()
+	{
+		const char *start;
+		int length;
+		bool escaped;
+		switch(peek()){
+			case '"':
+				return raw_string(start, length, escaped);
+			case '{':
+			case '[':{
+				int depth = 0;
+				do{
+					char c = peek();
+					if(c == '"'){
+						if(!raw_string(start, length, escaped)){
+							return false;
+						}
+						continue;
+					}
+					depth += (c == '{' || c == '[') - (c == '}' || c == ']');
+					position++;
+				}while(depth && position < end);
+				return !depth;
+			}
+			default:
+				while(position < end && *position != ',' && *position != '}' && *position != ']'){
+					position++;
+				}
+				return position < end;
+		}
+	}
+};
+
+bool bookmark_library::read(const QString &path, bookmark_map &bookmarks, bool &binary)
+{
+	QFile file(path);
+	if(!file.open(QIODevice::ReadOnly)){
+		return false;
+	}
+	QByteArray contents;
+	qint64 size = file.size();
+	const char *position = (const char *)file.map(0, size);
+	if(!position){
+		contents = file.readAll();
+		position = contents.constData();
+		size = contents.size(); //readAll stops short on files too big for a QByteArray
+	}
+	const char *end = position + size;
+	binary = size >= header_size && qFromLittleEndian<quint32>((const uchar *)position) == magic;
+	if(!(binary ? read_binary(position, end, bookmarks) : read_json(position, end, bookmarks))){
+		return false;
+	}
+	remove_duplicates(bookmarks);
+	return true;
+}
+
+//Libraries used to be loaded into a map by address, so a repeated address keeps the record that came last
+void bookmark_library::remove_duplicates(bookmark_map &bookmarks)
+{
+	std::stable_sort(bookmarks.begin(), bookmarks.end(), [](const bookmark_data &a, const bookmark_data &b){
+		return a.address < b.address;
+	});
+	int kept = 0;
+	for(int i = 0; i < bookmarks.size(); i++){
+		if(i + 1 < bookmarks.size() && bookmarks.at(i + 1).address == bookmarks.at(i).address){
+			continue;
+		}
+		if(kept != i){
+			bookmarks[kept] = bookmarks.at(i);
+		}
+		kept++;
+	}
+	bookmarks.resize(kept);
+}
+
+//Objects missing a field or holding the wrong type are skipped like they always were
+bool bookmark_library::read_json(const char *position, const char *end, bookmark_map &bookmarks)
+{
+	enum fields{
+		ADDRESS = 1,
+		SIZE = 2,
+		DESCRIPTION = 4,
+		TYPE = 8,
+		IS_POINTER = 16,
+		COLOR = 32,
+		ALL_FIELDS = 63
+	};
+	
+	json_scanner scanner{position, end};
+	if(!scanner.consume('[')){
+		return false;
+	}
+	bookmarks.reserve((end - position) / 128);
+	if(scanner.consume(']')){
+		return true;
+	}
+	do{
+		if(scanner.peek() != '{'){
+			if(!scanner.skip_value()){
+				return false;
+			}
+			continue;
+		}
+		scanner.consume('{');
+		bookmark_data bookmark;
+		int found = 0;
+		while(scanner.peek() == '"'){
+			const char *key;
+			int length;
+			bool escaped;
+			if(!scanner.raw_string(key, length, escaped) || !scanner.consume(':')){
+				return false;
+			}
+			QLatin1String name(key, length);
+			char type = scanner.peek();
+			bool is_number = type == '-' || (type >= '0' && type <= '9');
+			qint64 value;
+			bool flag;
+			if(is_number && (name == QLatin1String("address") || name == QLatin1String("size") || 
+			                 name == QLatin1String("type") || name == QLatin1String("color"))){
+				scanner.number(value);
+				if(name == QLatin1String("address")){
+					bookmark.address = value;
+					found |= ADDRESS;
+				}else if(name == QLatin1String("size")){
+					bookmark.size = value;
+					found |= SIZE;
+				}else if(name == QLatin1String("type")){
+					bookmark.data_type = (bookmark_data::types)value;
+					found |= TYPE;
+				}else{
+					bookmark.color = QColor((QRgb)value);
+					found |= COLOR;
+				}
+			}else if(type == '"' && name == QLatin1String("description")){
+				if(!scanner.string(bookmark.description)){
+					return false;
+				}
+				found |= DESCRIPTION;
+			}else if((type == 't' || type == 'f') && name == QLatin1String("is_pointer") && scanner.literal(flag)){
+				bookmark.data_is_pointer = flag;
+				found |= IS_POINTER;
+			}else if(!scanner.skip_value()){
+				return false;
+			}
+			if(!scanner.consume(',')){
+				break;
+			}
+		}
+		if(!scanner.consume('}')){
+			return false;
+		}
+		if(found == ALL_FIELDS){
+			bookmarks.append(bookmark);
+		}
+	}while(scanner.consume(','));
+	return scanner.consume(']');
+}
+
+bool bookmark_library::read_binary(const char *position, const char *end, bookmark_map &bookmarks)
+{
+	const uchar *data = (const uchar *)position;
+	if(qFromLittleEndian<quint16>(data + 4) > version){
+		return false;
+	}
+	quint32 count = qFromLittleEndian<quint32>(data + 6);
+	data += header_size;
+	bookmarks.reserve(count);
+	for(quint32 i = 0; i < count; i++){
+		if(end - (const char *)data < record_size){
+			return false;
+		}
+		bookmark_data bookmark;
+		bookmark.address = qFromLittleEndian<qint32>(data);
+		bookmark.size = qFromLittleEndian<qint32>(data + 4);
+		bookmark.data_type = (bookmark_data::types)qFromLittleEndian<quint32>(data + 8);
+		bookmark.color = QColor::fromRgba(qFromLittleEndian<quint32>(data + 12));
+		bookmark.data_is_pointer = data[16];
+		int length = qFromLittleEndian<quint16>(data + 17);
+		data += record_size;
+		if(end - (const char *)data < length){
+			return false;
+		}
+		bookmark.description = QString::fromUtf8((const char *)data, length);
+		data += length;
+		bookmarks.append(bookmark);
+	}
+	return true;
+}
+
+bool bookmark_library::write(const QString &path, const bookmark_map &bookmarks, bool binary)
+{
+	QFile file(path);
+	if(path.isEmpty() || !file.open(QIODevice::WriteOnly)){
+		return false;
+	}
+	binary ? write_binary(file, bookmarks) : write_json(file, bookmarks);
+	return file.error() == QFile::NoError;
+}
+
+//One object per line, written out in chunks instead of building the whole document first
+void bookmark_library::write_json(QFile &file, const bookmark_map &bookmarks)
+{
+	QByteArray output;
+	output.reserve(chunk_size * 2);
+	output += "[\n";
+	for(int i = 0; i < bookmarks.size(); i++){
+		const bookmark_data &bookmark = bookmarks.at(i);
+		output += "    {\"address\": " + QByteArray::number(bookmark.address) + 
+		          ", \"color\": " + QByteArray::number((int)bookmark.color.rgb()) + 
+		          ", \"description\": ";
+		append_string(output, bookmark.description);
+		output += ", \"is_pointer\": ";
+		output += bookmark.data_is_pointer ? "true" : "false";
+		output += ", \"size\": " + QByteArray::number(bookmark.size) + 
+		          ", \"type\": " + QByteArray::number(bookmark.data_type) + 
+		          (i + 1 < bookmarks.size() ? "},\n" : "}\n");
+		if(output.size() >= chunk_size){
+			file.write(output);
+			output.resize(0);
+		}
+	}
+	output += "]\n";
+	file.write(output);
+}
+
+void bookmark_library::append_string(QByteArray &output, const QString &text)
+{
+	QByteArray utf8 = text.toUtf8();
+	output += '"';
+	for(char c : utf8){
+		switch(c){
+			case '"': output += "\\\""; break;
+			case '\\': output += "\\\\"; break;
+			case '\n': output += "\\n"; break;
+			case '\r': output += "\\r"; break;
+			case '\t': output += "\\t"; break;
+			default:
+				if((unsigned char)c < 0x20){
+					output += "\\u00" + QByteArray::number((unsigned char)c, 16).rightJustified(2, '0');
+				}else{
+					output += c;
+				}
+		}
+	}
+	output += '"';
+}
+
+void bookmark_library::write_binary(QFile &file, const bookmark_map &bookmarks)
+{
+	QByteArray output;
+	output.reserve(chunk_size * 2);
+	uchar header[header_size];
+	qToLittleEndian<quint32>(magic, header);
+	qToLittleEndian<quint16>(version, header + 4);
+	qToLittleEndian<quint32>(bookmarks.size(), header + 6);
+	output.append((const char *)header, header_size);
+	for(const auto &bookmark : bookmarks){
+		QByteArray description = bookmark.description.toUtf8().left(0xFFFF);
+		uchar record[record_size];
+		qToLittleEndian<qint32>(bookmark.address, record);
+		qToLittleEndian<qint32>(bookmark.size, record + 4);
+		qToLittleEndian<quint32>(bookmark.data_type, record + 8);
+		qToLittleEndian<quint32>(bookmark.color.rgba(), record + 12);
+		record[16] = bookmark.data_is_pointer;
+		qToLittleEndian<quint16>(description.size(), record + 17);
+		output.append((const char *)record, record_size);
+		output.append(description);
+		if(output.size() >= chunk_size){
+			file.write(output);
+			output.resize(0);
+		}
+	}
+	file.write(output);
+}
@@ -0,0 +1,33 @@
+#ifndef BOOKMARK_LIBRARY_H
+#define BOOKMARK_LIBRARY_H
+
+#include <QString>
+#include <QByteArray>
+
+#include "panels/bookmark_panel.h"
+
+class QFile;
+
+//Loads and saves bookmark libraries a record at a time, as JSON or as a compact binary file
+class bookmark_library
+{
+	public:
+		static bool read(const QString &path, bookmark_map &bookmarks, bool &binary);
+		static bool write(const QString &path, const bookmark_map &bookmarks, bool binary);
+		
+	private:
+		static const quint32 magic = 0x314C4253; //SBL1
+		static const quint16 version = 1;
+		static const int header_size = 10;
+		static const int record_size = 19;
+		static const int chunk_size = 1 << 16;
+		
+		static bool read_json(const char *position, const char *end, bookmark_map &bookmarks);
+		static bool read_binary(const char *position, const char *end, bookmark_map &bookmarks);
+		static void write_json(QFile &file, const bookmark_map &bookmarks);
+		static void write_binary(QFile &file, const bookmark_map &bookmarks);
+		static void append_string(QByteArray &output, const QString &text);
+		static void remove_duplicates(bookmark_map &bookmarks);
+};
+
+#endif // BOOKMARK_LIBRARY_H
@@ -0,0 +1,138 @@
+#include <QHash>
+#include <algorithm>
+
+#include "bookmark_model.h"
+#include "utility.h"
+#include "debug.h"
+
+int bookmark_model::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : bookmarks.size();
+}
+
+int bookmark_model::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : COLUMN_COUNT;
+}
+
+QVariant bookmark_model::data(const QModelIndex &index, int role) const
+{
+	if(!index.isValid() || index.row() >= bookmarks.size()){
+		return QVariant();
+	}
+	const bookmark_data &bookmark = bookmarks.at(index.row());
+	switch(index.column()){
+		case ADDRESS:
+			return role == Qt::DisplayRole ? format_address(bookmark.address) : QVariant();
+		case COLOR:
+			if(role == Qt::BackgroundRole || role == Qt::ForegroundRole){
+				return bookmark.color;
+			}
+			return role == Qt::DisplayRole ? bookmark.color.name() : QVariant();
+		case DESCRIPTION:
+			return role == Qt::DisplayRole ? bookmark.description : QVariant();
+		default:
+			return QVariant();
+	}
+}
+
+QVariant bookmark_model::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if(orientation != Qt::Horizontal || role != Qt::DisplayRole){
+		return QVariant();
+	}
+	static const char *names[COLUMN_COUNT] = {"Address", "Color", "Description"};
+	return section < COLUMN_COUNT ? names[section] : QVariant();
+}
+
+void bookmark_model::sort(int column, Qt::SortOrder order)
+{
+	auto less = [column](const bookmark_data &a, const bookmark_data &b){
+		switch(column){
+			case COLOR:
+				return a.color.rgb() < b.color.rgb();
+			case DESCRIPTION:
+				return a.description < b.description;
+			default:
+				return a.address < b.address;
+		}
+	};
+	emit layoutAboutToBeChanged();
+	if(order == Qt::AscendingOrder){
+		std::stable_sort(bookmarks.begin(), bookmarks.end(), less);
+	}else{
+		std::stable_sort(bookmarks.begin(), bookmarks.end(), 
+		                 [&](const bookmark_data &a, const bookmark_data &b){ return less(b, a); });
+	}
+	emit layoutChanged();
+}
+
+void bookmark_model::set_bookmarks(bookmark_map b)
+{
+	beginResetModel();
+	bookmarks = std::move(b);
+	endResetModel();
+}
+
+int bookmark_model::find(int address) const
+{
+	for(int i = 0; i < bookmarks.size(); i++){
+		if(bookmarks.at(i).address == address){
+			return i;
+		}
+	}
+	return -1;
+}
+
+//Replaces the bookmark at the same address if there is one, returns its row
+int bookmark_model::insert(const bookmark_data &bookmark)
+{
+	int row = find(bookmark.address);
+	if(row != -1){
+		bookmarks[row] = bookmark;
+		emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
+		return row;
+	}
+	row = bookmarks.size();
+	beginInsertRows(QModelIndex(), row, row);
+	bookmarks.append(bookmark);
+	endInsertRows();
+	return row;
+}
+
+//Removes from the bottom up in runs of adjacent rows
+void bookmark_model::remove(QVector<int> rows)
+{
+	std::sort(rows.begin(), rows.end(), std::greater<int>());
+	for(int i = 0; i < rows.size();){
+		int last = rows.at(i);
+		int first = last;
+		for(i++; i < rows.size() && rows.at(i) == first - 1; i++){
+			first--;
+		}
+		beginRemoveRows(QModelIndex(), first, last);
+		bookmarks.remove(first, last - first + 1);
+		endRemoveRows();
+	}
+}
+
+//Matched by address rather than row, so undoing still finds bookmarks that were sorted or added since
+void bookmark_model::relocate(const QVector<int> &from, const QVector<int> &to)
+{
+	QHash<int, int> moves;
+	for(int i = 0; i < from.size() && i < to.size(); i++){
+		moves.insert(from.at(i), to.at(i));
+	}
+	for(auto &bookmark : bookmarks){
+		bookmark.address = moves.value(bookmark.address, bookmark.address);
+	}
+	if(bookmarks.isEmpty()){
+		return;
+	}
+	emit dataChanged(index(0, ADDRESS), index(bookmarks.size() - 1, ADDRESS));
+}
+
+QString bookmark_model::format_address(int address)
+{
+	return '$' + to_hex(address >> 16) + ':' + to_hex(address & 0xFFFF, 4);
+}
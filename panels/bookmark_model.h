@@ -0,0 +1,41 @@
+#ifndef BOOKMARK_MODEL_H
+#define BOOKMARK_MODEL_H
+
+#include <QAbstractTableModel>
+
+#include "panels/bookmark_panel.h"
+
+//Serves the bookmark table straight from the vector the rest of the editor reads
+class bookmark_model : public QAbstractTableModel
+{
+		Q_OBJECT
+	public:
+		enum columns{
+			ADDRESS,
+			COLOR,
+			DESCRIPTION,
+			COLUMN_COUNT
+		};
+		
+		using QAbstractTableModel::QAbstractTableModel;
+		int rowCount(const QModelIndex &parent = QModelIndex()) const;
+		int columnCount(const QModelIndex &parent = QModelIndex()) const;
+		QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+		QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+		void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+		
+		const bookmark_map &get_bookmarks() const { return bookmarks; }
+		void set_bookmarks(bookmark_map b);
+		const bookmark_data &at(int row) const { return bookmarks.at(row); }
+		int find(int address) const;
+		int insert(const bookmark_data &bookmark);
+		void remove(QVector<int> rows);
+		void relocate(const QVector<int> &from, const QVector<int> &to);
+		
+		static QString format_address(int address);
+		
+	private:
+		bookmark_map bookmarks;
+};
+
+#endif // BOOKMARK_MODEL_H
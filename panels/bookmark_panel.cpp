@@ -1,13 +1,12 @@
 #include <QHeaderView>
 #include <QColorDialog>
 #include <QMenu>
-#include <QFile>
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QFileDialog>
+#include <QFileInfo>
 
 #include "bookmark_panel.h"
+#include "bookmark_model.h"
+#include "bookmark_library.h"
 #include "hex_editor.h"
 #include "debug.h"
 
@@ -15,9 +14,7 @@ bookmark_panel::bookmark_panel(panel_manager *parent, hex_editor *editor) :
         QTableView(parent), abstract_panel(parent, editor)
 {
 	QFontMetrics metrics(QApplication::font(address_input));
-	QStringList labels;
-	labels << "Address" << "Color" << "Description";
-	model->setHorizontalHeaderLabels(labels);
+	model = new bookmark_model(this);
 	setSortingEnabled(true);
 	
 	setModel(model);
@@ -74,7 +71,7 @@ bookmark_panel::bookmark_panel(panel_manager *parent, hex_editor *editor) :
 	is_pointer->setLayoutDirection(Qt::RightToLeft);
 	
 	init_grid_layout();
-	editor->get_buffer()->set_bookmark_map(&bookmarks);
+	editor->get_buffer()->set_bookmark_map(&model->get_bookmarks());
 	
 	setContextMenuPolicy(Qt::CustomContextMenu);
 	connect(this, &bookmark_panel::customContextMenuRequested, this, &bookmark_panel::context_menu);
@@ -87,7 +84,7 @@ void bookmark_panel::color_clicked()
 
 void bookmark_panel::address_updated(QString address)
 {
-	if(bookmarks.contains(address)){
+	if(model->find(check_address(address)) != -1){
 		add_button->hide();
 		update_button->show();
 	}else{
@@ -125,30 +122,21 @@ void bookmark_panel::add_clicked()
 	bookmark.data_type = (bookmark_data::types)data_type->currentData().toInt();
 	bookmark.data_is_pointer = is_pointer->isChecked();
 	
-	add_bookmark(address_input->text(), bookmark);
-	bookmarks.insert(address_input->text(), bookmark);
+	int row = model->insert(bookmark);
 	
 	add_button->hide();
 	update_button->show();
-	selectRow(row-1);
+	selectRow(row);
 	
+	active_editor->get_buffer()->update_bookmarks();
 	active_editor->update_window();
 }
 
 void bookmark_panel::update_clicked()
 {
-	int clean_address = check_address(address_input->text());
-	if(clean_address == -1){
+	if(check_address(address_input->text()) == -1){
 		return;
 	}
-	for(int i = 0; i < row; i++){
-		QModelIndex address_index = model->index(i, 0);
-		if(address_index.data().toString() == address_input->text()){
-			model->removeRow(i);
-			break;
-		}
-	}
-	row--;
 	add_clicked();
 	model->sort(horizontalHeader()->sortIndicatorSection(), horizontalHeader()->sortIndicatorOrder());
 	scrollTo(currentIndex());
@@ -157,14 +145,12 @@ void bookmark_panel::update_clicked()
 void bookmark_panel::row_clicked(QModelIndex index)
 {	
 	active_row = index.row();
-	QModelIndex address_index = model->index(active_row, 0);
-
-	bookmark_data bookmark = bookmarks[address_index.data().toString()];
+	const bookmark_data &bookmark = model->at(active_row);
 	
 	size_input->setText(QString::number(bookmark.size));
 	description_input->setPlainText(bookmark.description);
 	set_color_button(bookmark.color);
-	address_input->setText(address_index.data().toString());
+	address_input->setText(bookmark_model::format_address(bookmark.address));
 	data_type->setCurrentIndex(data_type->findData(bookmark.data_type));
 	is_pointer->setChecked(bookmark.data_is_pointer);
 }
@@ -172,17 +158,18 @@ void bookmark_panel::row_clicked(QModelIndex index)
 void bookmark_panel::row_double_clicked(QModelIndex index)
 {	
 	active_row = index.row();
-	QModelIndex address_index = model->index(active_row, 0);
-	active_editor->goto_offset(check_address(address_index.data().toString()));
+	active_editor->goto_offset(model->at(active_row).address);
 }
 
 void bookmark_panel::delete_item()
 {
+	QVector<int> rows;
 	for(const auto &i : selectionModel()->selectedRows()){
-		bookmarks.remove(i.data().toString());
-		model->removeRow(i.row());
-		row--;
+		rows.append(i.row());
 	}
+	model->remove(rows);
+	active_editor->get_buffer()->update_bookmarks();
+	active_editor->update_window();
 }
 
 void bookmark_panel::create_bookmark(int start, int end, const ROM_buffer *buffer)
@@ -198,6 +185,13 @@ void bookmark_panel::create_bookmark(int start, int end, const ROM_buffer *buffe
 	}
 }
 
+void bookmark_panel::relocate_bookmarks(QVector<int> from, QVector<int> to)
+{
+	model->relocate(from, to);
+	active_editor->get_buffer()->update_bookmarks();
+	active_editor->update_window();
+}
+
 QLayout *bookmark_panel::get_layout()
 {
 	box->addWidget(this);
@@ -205,18 +199,6 @@ QLayout *bookmark_panel::get_layout()
 	return box;
 }
 
-void bookmark_panel::add_bookmark(QString address, bookmark_data bookmark)
-{
-	model->setItem(row, 0, new QStandardItem(address));
-	QStandardItem *color = new QStandardItem();
-	color->setBackground(bookmark.color);
-	color->setForeground(bookmark.color);
-	color->setText(bookmark.color.name());
-	model->setItem(row, 1, color);
-	model->setItem(row, 2, new QStandardItem(bookmark.description));
-	row++;
-}
-
 void bookmark_panel::init_grid_layout()
 {
 	QGridLayout *grid = new QGridLayout(this);
@@ -264,74 +246,36 @@ int bookmark_panel::check_address(QString address)
 void bookmark_panel::read_json()
 {
 	QString name = QFileDialog::getOpenFileName(this, "Open Bookmark library", QDir::currentPath(), 
-                                            "Shex Bookmark Library (*.sbl);;JSON files (*.json);;All files(*)");
-	QFile file(name);
-	if(name == "" || !file.open(QIODevice::ReadOnly)){
-		return;  //Not a chance recovering from this one
-	}
-	QByteArray file_data = file.readAll();
-	QJsonDocument json = QJsonDocument::fromJson(file_data);
-	if(!json.isArray()){
-		return; //abandon hope
+	                                            "Bookmark libraries (*.json *.sbl);;JSON bookmark library (*.json);;"
+	                                            "Binary bookmark library (*.sbl);;All files(*)");
+	bookmark_map bookmarks;
+	bool binary;
+	if(name == "" || !bookmark_library::read(name, bookmarks, binary)){
+		return;  //abandon hope
 	}
 	file_name = name; //Don't change the name until we are about to actually load data
-	bookmarks.clear();
-	model->setRowCount(0);
-	for(const auto &value : json.array()){
-		if(!value.isObject()){
-			continue; //Ignore this object
-		}
-		QJsonObject bookmark_json = value.toObject();
-		
-		if(!bookmark_json["address"].isDouble() ||
-		   !bookmark_json["size"].isDouble() ||
-		   !bookmark_json["description"].isString() ||
-		   !bookmark_json["type"].isDouble() ||
-		   !bookmark_json["is_pointer"].isBool() ||
-		   !bookmark_json["color"].isDouble()){
-			continue; //Ignore this object
-		}
-		bookmark_data bookmark;
-		bookmark.address = bookmark_json["address"].toInt();
-		bookmark.size = bookmark_json["size"].toInt();
-		bookmark.description = bookmark_json["description"].toString();
-		bookmark.data_type = (bookmark_data::types)bookmark_json["type"].toInt();
-		bookmark.data_is_pointer = bookmark_json["is_pointer"].toInt();
-		bookmark.color = QColor(bookmark_json["color"].toInt());
-		
-		QString address = active_editor->get_buffer()->get_formatted_address(
-		                        active_editor->get_buffer()->snes_to_pc(bookmark.address));
-		bookmarks[address] = bookmark;
-		add_bookmark(address, bookmark);
-	}
+	binary_library = binary;
+	model->set_bookmarks(bookmarks);
+	model->sort(horizontalHeader()->sortIndicatorSection(), horizontalHeader()->sortIndicatorOrder());
+	active_editor->get_buffer()->update_bookmarks();
+	active_editor->update_window();
 }
 
+//Binary for .sbl and JSON for anything else, a name without an extension takes the one of the picked filter.
+//The choice sticks for later saves of the same library.
 void bookmark_panel::write_json(bool save_as)
 {
 	if(save_as || file_name.isEmpty()){
-		QString filter = "Shex Bookmark Library (*.sbl);;JSON files (*.json);;All files(*)";
+		QString filter = "JSON bookmark library (*.json);;Binary bookmark library (*.sbl);;All files(*)";
+		QString selected;
 		file_name = QFileDialog::getSaveFileName(this, "Save Bookmark library", QDir::currentPath(), 
-							filter, &filter, QFileDialog::DontUseNativeDialog);
-	}
-	
-	QFile file(file_name);
-	if (file_name.isEmpty() || !file.open(QIODevice::WriteOnly)){
-		return;  //Not a chance recovering from this one
-	}
-	QJsonArray json_data;
-	for(const auto &bookmark : bookmarks){
-		json_data.append(QJsonObject{
-		                          {"address", bookmark.address},
-		                          {"size", bookmark.size},
-		                          {"description", bookmark.description},
-		                          {"type", bookmark.data_type},
-		                          {"is_pointer", bookmark.data_is_pointer},
-		                          {"color", (int)bookmark.color.rgb()},
-		                  });
+							filter, &selected, QFileDialog::DontUseNativeDialog);
+		if(!file_name.isEmpty() && QFileInfo(file_name).suffix().isEmpty()){
+			file_name += selected.startsWith("Binary") ? ".sbl" : ".json";
+		}
+		binary_library = file_name.endsWith(".sbl", Qt::CaseInsensitive);
 	}
-	QJsonDocument json;
-	json.setArray(json_data);
-	file.write(json.toJson());
+	bookmark_library::write(file_name, model->get_bookmarks(), binary_library);
 }
 
 void bookmark_panel::write_as_json()
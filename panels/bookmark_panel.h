@@ -3,7 +3,6 @@
 
 #include <QTableView>
 #include <QGridLayout>
-#include <QStandardItemModel>
 #include <QPushButton>
 #include <QPlainTextEdit>
 #include <QColormap>
@@ -11,6 +10,7 @@
 #include <QLineEdit>
 #include <QComboBox>
 #include <QCheckBox>
+#include <QVector>
 
 #include "abstract_panel.h"
 #include "panel_manager.h"
@@ -38,7 +38,9 @@ struct bookmark_data{
 	QColor color;
 };
 
-typedef QMap<QString, bookmark_data> bookmark_map;
+typedef QVector<bookmark_data> bookmark_map;
+
+class bookmark_model;
 
 class bookmark_panel : public QTableView, public abstract_panel
 {
@@ -49,8 +51,6 @@ class bookmark_panel : public QTableView, public abstract_panel
 		virtual void toggle_state(){ state = !state; }
 		virtual bool display_state(){ return state; }
 		
-		void add_bookmark(QString address, bookmark_data bookmark);
-		
 	public slots:
 		void color_clicked();
 		void address_updated(QString address);
@@ -65,6 +65,7 @@ class bookmark_panel : public QTableView, public abstract_panel
 		void write_as_json();
 		
 		void create_bookmark(int start, int end, const ROM_buffer *buffer);
+		void relocate_bookmarks(QVector<int> from, QVector<int> to);
 		
 	private:
 		void init_grid_layout();
@@ -74,11 +75,8 @@ class bookmark_panel : public QTableView, public abstract_panel
 		
 		QWidget *input_area = new QWidget(this);
 		
-		bookmark_map bookmarks;
-
-		int row = 0;
 		int active_row = 0;
-		QStandardItemModel *model = new QStandardItemModel(this);
+		bookmark_model *model;
 		
 		QVBoxLayout *box = new QVBoxLayout();
 		
@@ -102,6 +100,7 @@ class bookmark_panel : public QTableView, public abstract_panel
 		
 		bool can_save = false;
 		QString file_name = "";
+		bool binary_library = false;
 		
 		static const int input_padding = 12;
 		static bool state;
@@ -1,4 +1,12 @@
+#include <QApplication>
+#include <QClipboard>
+#include <QFontDatabase>
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <algorithm>
+
 #include "disassembler_panel.h"
+#include "hex_editor.h"
 #include "debug.h"
 #include "disassembly_cores/isa_65c816.h"
 #include "disassembly_cores/isa_spc700.h"
@@ -7,7 +15,7 @@
 #include "utility.h"
 
 disassembler_panel::disassembler_panel(panel_manager *parent, hex_editor *editor) :
-        QPlainTextEdit(parent), abstract_panel(parent, editor)
+        QListView(parent), abstract_panel(parent, editor)
 {
 	cores.insert(isa_65c816::id(), new isa_65c816(this));
 	cores.insert(isa_spc700::id(), new isa_spc700(this));
@@ -16,17 +24,31 @@ disassembler_panel::disassembler_panel(panel_manager *parent, hex_editor *editor
 		disassembler_cores->addItem(i.key());
         }
 	
-	setReadOnly(true);
-	setWordWrapMode(QTextOption::NoWrap);
+	setModel(model);
+	setUniformItemSizes(true);
+	setEditTriggers(QAbstractItemView::NoEditTriggers);
+	setSelectionMode(QAbstractItemView::ExtendedSelection);
 	setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
 	connect(disassembler_cores, resolve<int>::from(&QComboBox::activated), 
 	        this, &disassembler_panel::update_core_layout);
-	//connect(this, &disassembler_panel::textChanged, this, &disassembler_panel::update_width);
+	connect(this, &QListView::clicked, this, &disassembler_panel::select_line);
+	
+	isa_spc700 *spc700 = (isa_spc700 *)cores[isa_spc700::id()];
+	connect(spc700, &isa_spc700::scan_requested, this, [=](){
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+		spc700->set_uploads(spc_upload_scanner::scan(active_editor->get_buffer()), active_editor->get_buffer());
+		QApplication::restoreOverrideCursor();
+	});
+	connect(spc700, &isa_spc700::upload_selected, this, [=](selection area){
+		disassemble(area, active_editor->get_buffer());
+	});
 }
 
 void disassembler_panel::disassemble(selection selection_area, const ROM_buffer *buffer)
 {
-	setPlainText(active_core()->disassemble(selection_area, buffer));
+	active_core()->disassemble(selection_area, buffer);
+	model->set_core(active_core());
+	scrollToTop();
 	if(!state){
 		state = true;
 		toggle_event(DISASSEMBLER);
@@ -57,10 +79,79 @@ QLayout *disassembler_panel::get_layout()
 	return box;
 }
 
-void disassembler_panel::update_width()
+//Keeps the disassembly scrolled to wherever the hex editor is showing
+void disassembler_panel::follow_offset(int offset)
+{
+	if(!model->get_core() || following){
+		return;
+	}
+	int row = model->get_core()->find_line(offset);
+	if(row != -1){
+		scrollTo(model->index(row), QAbstractItemView::PositionAtTop);
+	}
+}
+
+//Highlights the instruction under the hex editor cursor
+void disassembler_panel::follow_cursor(int offset)
 {
-	setMinimumWidth(document()->size().width());
-	propagate_resize(this);
+	cursor_offset = offset;
+	if(!model->get_core()){
+		return;
+	}
+	int row = model->get_core()->find_instruction(offset);
+	if(row == -1){
+		clearSelection();
+		return;
+	}
+	QModelIndex index = model->index(row);
+	if(currentIndex() != index){
+		setCurrentIndex(index);
+	}
+	if(!following){
+		scrollTo(index, QAbstractItemView::EnsureVisible);
+	}
+}
+
+//Picks up edits made in the hex editor, only the instructions around the change are decoded again
+void disassembler_panel::refresh()
+{
+	if(!model->get_core() || !model->get_core()->refresh()){
+		return;
+	}
+	int scroll = verticalScrollBar()->value();
+	model->refresh();
+	verticalScrollBar()->setValue(scroll);
+	if(cursor_offset != -1){
+		following = true;
+		follow_cursor(cursor_offset);
+		following = false;
+	}
+}
+
+void disassembler_panel::select_line(const QModelIndex &index)
+{
+	if(!model->get_core() || !index.isValid()){
+		return;
+	}
+	int offset = model->get_core()->line_offset(index.row());
+	following = true;
+	active_editor->goto_offset(active_editor->get_buffer()->pc_to_snes(offset));
+	following = false;
+}
+
+void disassembler_panel::keyPressEvent(QKeyEvent *event)
+{
+	if(!event->matches(QKeySequence::Copy) || !model->get_core()){
+		QListView::keyPressEvent(event);
+		return;
+	}
+	QModelIndexList rows = selectionModel()->selectedRows();
+	std::sort(rows.begin(), rows.end());
+	QString text;
+	for(const auto &row : rows){
+		text += model->get_core()->format_line(row.row()) + '\n';
+	}
+	QApplication::clipboard()->setText(text);
 }
 
 bool disassembler_panel::state = false;
@@ -1,17 +1,18 @@
 #ifndef DISASSEMBLER_H
 #define DISASSEMBLER_H
 
-#include <QPlainTextEdit>
+#include <QListView>
 #include <QComboBox>
 #include <QVBoxLayout>
 
 #include "disassembly_cores/disassembler_core.h"
+#include "disassembly_model.h"
 #include "debug.h"
 #include "selection.h"
 #include "abstract_panel.h"
 #include "panel_manager.h"
 
-class disassembler_panel : public QPlainTextEdit, public abstract_panel
+class disassembler_panel : public QListView, public abstract_panel
 {
 		Q_OBJECT
 	public:
@@ -24,16 +25,25 @@ class disassembler_panel : public QPlainTextEdit, public abstract_panel
 	public slots:
 		void disassemble(selection selection_area, const ROM_buffer *buffer);
 		void update_core_layout(int a);
+		void follow_offset(int offset);
+		void follow_cursor(int offset);
+		void refresh();
+		void select_line(const QModelIndex &index);
+		
+	protected:
+		virtual void keyPressEvent(QKeyEvent *event);
 		
 	private:
 		void layout_adjust();
 		disassembler_core *active_core(){ return cores[disassembler_cores->currentText()]; }
-		void update_width();
 		
+		disassembly_model *model = new disassembly_model(this);
 		QWidget *core_layout = new QWidget(this);
 		QVBoxLayout *box = new QVBoxLayout();	
 		QComboBox *disassembler_cores = new QComboBox(this);
 		QMap<QString, disassembler_core *> cores;
+		int cursor_offset = -1;
+		bool following = false;
 		static bool state;
 };
 
@@ -0,0 +1,26 @@
+#include "disassembly_model.h"
+#include "debug.h"
+
+void disassembly_model::set_core(disassembler_core *c)
+{
+	beginResetModel();
+	core = c;
+	endResetModel();
+}
+
+int disassembly_model::rowCount(const QModelIndex &parent) const
+{
+	if(parent.isValid() || !core){
+		return 0;
+	}
+	return core->line_count();
+}
+
+//Only the rows the view asks for are ever formatted
+QVariant disassembly_model::data(const QModelIndex &index, int role) const
+{
+	if(role != Qt::DisplayRole || !core || index.row() >= core->line_count()){
+		return QVariant();
+	}
+	return core->format_line(index.row()).replace('\t', "    ");
+}
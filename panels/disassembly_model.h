@@ -0,0 +1,23 @@
+#ifndef DISASSEMBLY_MODEL_H
+#define DISASSEMBLY_MODEL_H
+
+#include <QAbstractListModel>
+
+#include "disassembly_cores/disassembler_core.h"
+
+class disassembly_model : public QAbstractListModel
+{
+		Q_OBJECT
+	public:
+		using QAbstractListModel::QAbstractListModel;
+		void set_core(disassembler_core *c);
+		void refresh(){ set_core(core); }
+		disassembler_core *get_core(){ return core; }
+		int rowCount(const QModelIndex &parent = QModelIndex()) const;
+		QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+		
+	private:
+		disassembler_core *core = nullptr;
+};
+
+#endif // DISASSEMBLY_MODEL_H
@@ -0,0 +1,117 @@
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QColorDialog>
+
+#include "palette_panel.h"
+#include "hex_editor.h"
+#include "graphics/bgr555.h"
+#include "utility.h"
+#include "debug.h"
+
+palette_panel::palette_panel(panel_manager *parent, hex_editor *editor) :
+        QWidget(parent), abstract_panel(parent, editor)
+{
+	counts->addItem("4 colors", 4);
+	counts->addItem("16 colors", 16);
+	counts->addItem("256 colors", 256);
+	counts->setCurrentIndex(1);
+	feed_tiles->setChecked(true);
+	setMinimumSize(columns * swatch_size, swatch_size);
+	
+	connect(counts, resolve<int>::from(&QComboBox::activated), this, &palette_panel::refresh);
+	connect(feed_tiles, &QCheckBox::toggled, this, &palette_panel::feed_toggled);
+}
+
+QLayout *palette_panel::get_layout()
+{
+	box->addWidget(counts);
+	box->addWidget(feed_tiles);
+	box->addWidget(offset_label);
+	box->addWidget(this, 1);
+	return box;
+}
+
+//The tile panel is only colored while this panel is shown
+void palette_panel::toggle_state()
+{
+	state = !state;
+	feed_toggled(feed_tiles->isChecked());
+}
+
+QSize palette_panel::sizeHint() const
+{
+	return QSize(columns * swatch_size, 256 / columns * swatch_size);
+}
+
+//A selection is read as a palette of its own, otherwise the chosen number of colors from the cursor
+void palette_panel::follow_cursor(int offset)
+{
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	selection area = active_editor->get_selection();
+	int count = counts->currentData().toInt();
+	if(area.is_active() && area.byte_range() >= 2){
+		offset = area.get_start_byte();
+		count = qMin(area.byte_range() / 2, 256);
+	}
+	count = qMax(0, qMin(count, (buffer->size() - offset) / 2));
+	
+	QVector<QRgb> decoded = bgr555::to_rgb((const uchar *)buffer->data() + offset, count);
+	offset_label->setText("Colors at " + buffer->get_formatted_address(offset));
+	if(decoded == colors && start == offset){
+		return;
+	}
+	start = offset;
+	colors = decoded;
+	update();
+	if(feed_tiles->isChecked() && state){
+		emit palette_changed(colors);
+	}
+}
+
+void palette_panel::refresh()
+{
+	colors.clear();
+	follow_cursor(active_editor->get_cursor_nibble() / 2);
+}
+
+void palette_panel::feed_toggled(bool checked)
+{
+	emit palette_changed(checked && state ? colors : QVector<QRgb>());
+}
+
+void palette_panel::paintEvent(QPaintEvent *event)
+{
+	QPainter painter(this);
+	painter.fillRect(event->rect(), palette().window());
+	for(int i = 0; i < colors.size(); i++){
+		QRect swatch(i % columns * swatch_size, i / columns * swatch_size, swatch_size, swatch_size);
+		painter.fillRect(swatch, QColor(colors[i]));
+		painter.setPen(palette().color(QPalette::Dark));
+		painter.drawRect(swatch.adjusted(0, 0, -1, -1));
+	}
+}
+
+int palette_panel::swatch_at(QPoint position) const
+{
+	int column = position.x() / swatch_size;
+	int index = position.y() / swatch_size * columns + column;
+	return column < columns && index < colors.size() ? index : -1;
+}
+
+//The picked color is rounded down to five bits a channel and written back as one undo step
+void palette_panel::mousePressEvent(QMouseEvent *event)
+{
+	int index = swatch_at(event->pos());
+	if(index == -1){
+		return;
+	}
+	int position = start + index * 2;
+	QColor color = QColorDialog::getColor(QColor(colors[index]), this, "Edit color " + 
+	                                      active_editor->get_buffer()->get_formatted_address(position));
+	if(color.isValid()){
+		active_editor->update_color(position, bgr555::from_rgb(color.rgb()));
+	}
+}
+
+bool palette_panel::state = false;
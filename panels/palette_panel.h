@@ -0,0 +1,49 @@
+#ifndef PALETTE_PANEL_H
+#define PALETTE_PANEL_H
+
+#include <QComboBox>
+#include <QCheckBox>
+#include <QVBoxLayout>
+#include <QLabel>
+
+#include "abstract_panel.h"
+#include "panel_manager.h"
+
+class palette_panel : public QWidget, public abstract_panel
+{
+		Q_OBJECT
+	public:
+		explicit palette_panel(panel_manager *parent, hex_editor *editor);
+		virtual QLayout *get_layout();
+		virtual void toggle_state();
+		virtual bool display_state(){ return state; }
+		virtual QSize sizeHint() const;
+		
+	signals:
+		void palette_changed(QVector<QRgb> colors);
+		
+	public slots:
+		void follow_cursor(int offset);
+		void refresh();
+		void feed_toggled(bool checked);
+		
+	protected:
+		virtual void paintEvent(QPaintEvent *event);
+		virtual void mousePressEvent(QMouseEvent *event);
+		
+	private:
+		static const int columns = 16;
+		static const int swatch_size = 16;
+		
+		int swatch_at(QPoint position) const;
+		
+		QVBoxLayout *box = new QVBoxLayout();
+		QComboBox *counts = new QComboBox(this);
+		QCheckBox *feed_tiles = new QCheckBox("Color the tile panel", this);
+		QLabel *offset_label = new QLabel(this);
+		QVector<QRgb> colors;
+		int start = 0;
+		static bool state;
+};
+
+#endif // PALETTE_PANEL_H
@@ -0,0 +1,157 @@
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+
+#include "tile_panel.h"
+#include "hex_editor.h"
+#include "utility.h"
+#include "debug.h"
+
+tile_panel::tile_panel(panel_manager *parent, hex_editor *editor) :
+        QWidget(parent), abstract_panel(parent, editor)
+{
+	for(int i = tile_format::BPP2; i <= tile_format::MODE7; i++){
+		formats->addItem(tile_format::name((tile_format::formats)i));
+	}
+	formats->setCurrentIndex(tile_format::BPP4);
+	zooms->addItems({"1x", "2x", "3x", "4x"});
+	zooms->setCurrentIndex(1);
+	atlas.set_format(format());
+	update_palette();
+	setMinimumWidth(columns * tile_pixels());
+	
+	connect(formats, resolve<int>::from(&QComboBox::activated), this, &tile_panel::format_changed);
+	connect(zooms, resolve<int>::from(&QComboBox::activated), this, &tile_panel::zoom_changed);
+}
+
+QLayout *tile_panel::get_layout()
+{
+	controls->addWidget(formats);
+	controls->addWidget(zooms);
+	box->addLayout(controls);
+	box->addWidget(offset_label);
+	box->addWidget(this, 1);
+	return box;
+}
+
+QSize tile_panel::sizeHint() const
+{
+	return QSize(columns * tile_pixels(), columns * tile_pixels());
+}
+
+//The first tile is wherever the hex editor is showing, so tiles can be aligned by scrolling the editor
+void tile_panel::follow_offset(int offset)
+{
+	if(following){
+		return;
+	}
+	view_offset = offset;
+	update_label();
+	update();
+}
+
+//Edited tiles are found by the atlas when it compares their bytes, so only a repaint is needed
+void tile_panel::refresh()
+{
+	view_offset = qMin(view_offset, qMax(active_editor->get_buffer()->size() - 1, 0));
+	update_label();
+	update();
+}
+
+void tile_panel::set_palette(QVector<QRgb> colors)
+{
+	palette_colors = colors;
+	update_palette();
+}
+
+void tile_panel::format_changed(int index)
+{
+	Q_UNUSED(index);
+	atlas.set_format(format());
+	update_palette();
+}
+
+void tile_panel::zoom_changed(int index)
+{
+	Q_UNUSED(index);
+	setMinimumWidth(columns * tile_pixels());
+	updateGeometry();
+	propagate_resize(get_display());
+	update();
+}
+
+//Without colors from the palette panel the format's colors are spread over a gray ramp
+void tile_panel::update_palette()
+{
+	int count = tile_format::color_count(format());
+	QVector<QRgb> colors(256);
+	for(int i = 0; i < colors.size(); i++){
+		int gray = i % count * 255 / (count - 1);
+		colors[i] = i < palette_colors.size() ? palette_colors[i] : qRgb(gray, gray, gray);
+	}
+	atlas.set_palette(colors);
+	update();
+}
+
+void tile_panel::update_label()
+{
+	offset_label->setText("Tiles at " + active_editor->get_buffer()->get_formatted_address(view_offset));
+}
+
+//Every visible tile is looked up before the atlas image is taken, so it is converted at most once per paint
+void tile_panel::paintEvent(QPaintEvent *event)
+{
+	QPainter painter(this);
+	painter.fillRect(event->rect(), Qt::black);
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	int size = tile_format::tile_size(format());
+	int pixels = tile_pixels();
+	int count = (height() / pixels + 1) * columns;
+	atlas.reserve(count * 2);
+	
+	QVector<QRect> sources;
+	sources.reserve(count);
+	for(int i = 0; i < count && view_offset + i * size < buffer->size(); i++){
+		sources.append(atlas.tile(buffer->data(), buffer->size(), view_offset + i * size));
+	}
+	const QImage &image = atlas.image();
+	for(int i = 0; i < sources.size(); i++){
+		painter.drawImage(QRect(i % columns * pixels, i / columns * pixels, pixels, pixels), image, sources[i]);
+	}
+}
+
+//Scrolls by whole rows of tiles, which keeps the alignment picked in the hex editor
+void tile_panel::wheelEvent(QWheelEvent *event)
+{
+	int row_size = tile_format::tile_size(format()) * columns;
+	int steps = event->angleDelta().y() / 120;
+	int offset = view_offset - steps * row_size;
+	if(offset < 0){
+		offset = view_offset % row_size;
+	}
+	if(offset < active_editor->get_buffer()->size()){
+		view_offset = offset;
+	}
+	update_label();
+	update();
+	event->accept();
+}
+
+void tile_panel::mousePressEvent(QMouseEvent *event)
+{
+	int pixels = tile_pixels();
+	int column = event->pos().x() / pixels;
+	if(column >= columns){
+		return;
+	}
+	int offset = view_offset + (event->pos().y() / pixels * columns + column) * tile_format::tile_size(format());
+	if(offset >= active_editor->get_buffer()->size()){
+		return;
+	}
+	following = true;
+	active_editor->goto_offset(active_editor->get_buffer()->pc_to_snes(offset));
+	following = false;
+}
+
+bool tile_panel::state = false;
@@ -0,0 +1,54 @@
+#ifndef TILE_PANEL_H
+#define TILE_PANEL_H
+
+#include <QComboBox>
+#include <QVBoxLayout>
+#include <QLabel>
+
+#include "abstract_panel.h"
+#include "panel_manager.h"
+#include "graphics/tile_atlas.h"
+
+class tile_panel : public QWidget, public abstract_panel
+{
+		Q_OBJECT
+	public:
+		explicit tile_panel(panel_manager *parent, hex_editor *editor);
+		virtual QLayout *get_layout();
+		virtual void toggle_state(){ state = !state; }
+		virtual bool display_state(){ return state; }
+		virtual QSize sizeHint() const;
+		
+	public slots:
+		void follow_offset(int offset);
+		void refresh();
+		void set_palette(QVector<QRgb> colors);
+		void format_changed(int index);
+		void zoom_changed(int index);
+		
+	protected:
+		virtual void paintEvent(QPaintEvent *event);
+		virtual void wheelEvent(QWheelEvent *event);
+		virtual void mousePressEvent(QMouseEvent *event);
+		
+	private:
+		static const int columns = 16;
+		
+		tile_format::formats format() const { return (tile_format::formats)formats->currentIndex(); }
+		int tile_pixels() const { return tile_format::tile_width * (zooms->currentIndex() + 1); }
+		void update_palette();
+		void update_label();
+		
+		QVBoxLayout *box = new QVBoxLayout();
+		QHBoxLayout *controls = new QHBoxLayout();
+		QComboBox *formats = new QComboBox(this);
+		QComboBox *zooms = new QComboBox(this);
+		QLabel *offset_label = new QLabel(this);
+		tile_atlas atlas;
+		QVector<QRgb> palette_colors;
+		int view_offset = 0;
+		bool following = false;
+		static bool state;
+};
+
+#endif // TILE_PANEL_H
@@ -0,0 +1,68 @@
+#include <QHeaderView>
+
+#include "xref_panel.h"
+#include "hex_editor.h"
+#include "debug.h"
+
+xref_panel::xref_panel(panel_manager *parent, hex_editor *editor) :
+        QTableView(parent), abstract_panel(parent, editor)
+{
+	QStringList labels;
+	labels << "Source" << "Type";
+	model->setHorizontalHeaderLabels(labels);
+	
+	setModel(model);
+	verticalHeader()->hide();
+	setSelectionBehavior(QAbstractItemView::SelectRows);
+	setEditTriggers(QAbstractItemView::NoEditTriggers);
+	horizontalHeader()->setStretchLastSection(true);
+	
+	connect(this, &xref_panel::doubleClicked, this, &xref_panel::row_double_clicked);
+}
+
+QLayout *xref_panel::get_layout()
+{
+	box->addWidget(target_label);
+	box->addWidget(this);
+	return box;
+}
+
+//Lists everything that leads to the offset under the cursor
+void xref_panel::show_references(int offset)
+{
+	const ROM_buffer *buffer = active_editor->get_buffer();
+	if(offset == target && buffer->get_xrefs().get_revision() == revision){
+		return;
+	}
+	static const char *kind_names[] = {"Branch", "Jump", "Call", "Pointer"};
+	target = offset;
+	revision = buffer->get_xrefs().get_revision();
+	QVector<xref_index::reference> references = buffer->get_xrefs().references_to(offset);
+	
+	model->removeRows(0, model->rowCount());
+	for(const auto &reference : references){
+		QList<QStandardItem *> items;
+		items << new QStandardItem(buffer->get_formatted_address(reference.source))
+		      << new QStandardItem(kind_names[reference.kind]);
+		items.first()->setData(reference.source, Qt::UserRole);
+		model->appendRow(items);
+	}
+	target_label->setText("References to " + buffer->get_formatted_address(offset) + 
+	                      ": " + QString::number(references.size()));
+}
+
+void xref_panel::refresh()
+{
+	if(!active_editor->get_buffer()->update_xrefs()){
+		return;
+	}
+	show_references(target);
+}
+
+void xref_panel::row_double_clicked(QModelIndex index)
+{
+	int source = model->index(index.row(), 0).data(Qt::UserRole).toInt();
+	active_editor->goto_offset(active_editor->get_buffer()->pc_to_snes(source));
+}
+
+bool xref_panel::state = false;
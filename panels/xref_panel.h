@@ -0,0 +1,36 @@
+#ifndef XREF_PANEL_H
+#define XREF_PANEL_H
+
+#include <QTableView>
+#include <QStandardItemModel>
+#include <QVBoxLayout>
+#include <QLabel>
+
+#include "abstract_panel.h"
+#include "panel_manager.h"
+
+class xref_panel : public QTableView, public abstract_panel
+{
+		Q_OBJECT
+	public:
+		explicit xref_panel(panel_manager *parent, hex_editor *editor);
+		virtual QLayout *get_layout();
+		virtual void toggle_state(){ state = !state; }
+		virtual bool display_state(){ return state; }
+		
+	public slots:
+		void show_references(int offset);
+		void refresh();
+		void row_double_clicked(QModelIndex index);
+		
+	private:
+		QStandardItemModel *model = new QStandardItemModel(this);
+		QVBoxLayout *box = new QVBoxLayout();
+		QLabel *target_label = new QLabel(this);
+		int target = -1;
+		int revision = -1;
+		
+		static bool state;
+};
+
+#endif // XREF_PANEL_H
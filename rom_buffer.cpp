@@ -1,21 +1,38 @@
+#include <QtConcurrent>
+#include <numeric>
+#include <algorithm>
+
 #include "rom_buffer.h"
 #include "undo_commands.h"
 #include "debug.h"
 #include "utility.h"
 #include "character_mapper.h"
+#include "analysis/analysis_cache.h"
 
 ROM_buffer::ROM_buffer(QString file_name, bool new_file)
 {
 	if(!new_file){
 		open(file_name);
-		get_rats_tags();
 	}else{
 		buffer.fill(0x00, 0x8000);
+		set_mapper(LOROM);
 	}
+	rats.build(this);
 	clipboard = QApplication::clipboard(); //shared by all, but work around static initialization order
 	qDebug() << ENUM_STRING(memory_mapper, get_mapper());
 }
 
+//Bytes without a file of their own, such as a decompressed block. There is no header to find a mapper
+//from, so LoROM keeps addresses defined.
+ROM_buffer::ROM_buffer(QString name, const QByteArray &data)
+{
+	ROM.setFileName(name);
+	buffer = data;
+	set_mapper(LOROM);
+	rats.build(this);
+	clipboard = QApplication::clipboard();
+}
+
 void ROM_buffer::remove_copy_header()
 {
 	header_buffer = buffer.mid(0, header_size());
@@ -35,6 +52,13 @@ void ROM_buffer::open(QString path)
 		return;
 	}
 	analyze();
+	
+	//Symbols written next to the ROM by the assembler are picked up automatically
+	QFileInfo info(path);
+	QString symbol_path = info.path() + '/' + info.completeBaseName() + ".sym";
+	if(QFile::exists(symbol_path)){
+		symbols.import_file(symbol_path);
+	}
 }
 
 void ROM_buffer::save(QString path)
@@ -51,12 +75,112 @@ void ROM_buffer::save(QString path)
 	}
 	ROM.seek(header_size());
 	ROM.write(buffer);
+	if(analysis.is_valid()){
+		analysis_cache::save(this, analysis);
+	}
+	undo_stack->setClean(); //Nothing merges into the step that was saved
+}
+
+//Only the overlay under bookmarks that were added, removed or changed is worked out again, unless so
+//many changed that a full build is cheaper, like when a library is loaded
+void ROM_buffer::update_bookmarks()
+{
+	QVector<bookmark_index::interval> previous = bookmark_intervals.get_intervals();
+	bookmark_intervals.build(bookmarks, this);
+	xrefs.update_pointers(this);
+	const QVector<bookmark_index::interval> &current = bookmark_intervals.get_intervals();
+	auto same = [](const bookmark_index::interval &a, const bookmark_index::interval &b){
+		return a.start == b.start && a.end == b.end && 
+		       type_overlay::bookmark_kind(a.bookmark) == type_overlay::bookmark_kind(b.bookmark);
+	};
+	QVector<QPair<int, int>> changed;
+	for(int i = 0, j = 0; i < previous.size() || j < current.size();){
+		if(i < previous.size() && j < current.size() && same(previous.at(i), current.at(j))){
+			i++;
+			j++;
+		}else if(j == current.size() || (i < previous.size() && previous.at(i).start <= current.at(j).start)){
+			changed.append({previous.at(i).start, previous.at(i).end});
+			i++;
+		}else{
+			changed.append({current.at(j).start, current.at(j).end});
+			j++;
+		}
+	}
+	if(overlay.is_empty() || changed.size() > 256){
+		overlay.build(this);
+		return;
+	}
+	std::sort(changed.begin(), changed.end());
+	for(int i = 0; i < changed.size();){
+		int start = changed.at(i).first;
+		int end = changed.at(i).second;
+		for(i++; i < changed.size() && changed.at(i).first <= end; i++){
+			end = qMax(end, changed.at(i).second);
+		}
+		overlay.update(this, start, end);
+	}
 }
 
 void ROM_buffer::initialize_undo(QUndoGroup *undo_group)
 {
 	undo_stack = new QUndoStack(undo_group);
 	undo_stack->setActive();
+	QObject::connect(undo_stack, &QUndoStack::indexChanged, [this](int index){ undo_index_changed(index); });
+}
+
+//Collects the bytes a command wrote in place, nested macros are walked through every child.
+//False when anything in it inserted, removed or moved bytes.
+static bool edited_ranges(const QUndoCommand *command, QVector<QPair<int, int>> &ranges)
+{
+	if(auto typing = dynamic_cast<const undo_byte_command *>(command)){
+		ranges.append({typing->get_location(), typing->get_location() + 1});
+		return true;
+	}
+	if(auto overwrite = dynamic_cast<const undo_overwrite_command *>(command)){
+		ranges.append({overwrite->get_location(), overwrite->get_location() + overwrite->get_length()});
+		return true;
+	}
+	if(!command->childCount()){
+		return false;
+	}
+	for(int i = 0; i < command->childCount(); i++){
+		if(!edited_ranges(command->child(i), ranges)){
+			return false;
+		}
+	}
+	return true;
+}
+
+//Every command stepped over either way is looked at, in place writes only rescan the bytes they touched.
+//Anything that moves or swaps the buffer rescans it in full.
+void ROM_buffer::undo_index_changed(int index)
+{
+	int first = qMin(index, undo_index);
+	int last = qMax(index, undo_index);
+	undo_index = index;
+	if(first == last && index){
+		first = index - 1; //A merged command changes the buffer without moving the index
+	}
+	if(size() != rats.rom_size()){
+		rats.build(this);
+		overlay.update(this, 0, size());
+		free_space.update(this, 0, size());
+		return;
+	}
+	QVector<QPair<int, int>> ranges;
+	for(int i = first; i < last; i++){
+		if(!edited_ranges(undo_stack->command(i), ranges)){
+			rats.build(this);
+			overlay.update(this, 0, size());
+			free_space.update(this, 0, size());
+			return;
+		}
+	}
+	for(const auto &range : ranges){
+		rats.update(this, range.first, range.second);
+		overlay.update(this, range.first, range.second);
+		free_space.update(this, range.first, range.second);
+	}
 }
 
 void ROM_buffer::cut(int start, int end, bool ascii_mode)
@@ -233,6 +357,15 @@ void ROM_buffer::update_byte(char byte, int position, int delete_start, int dele
 	undo_stack->endMacro();
 }
 
+//Both bytes of a color are a single undo step
+void ROM_buffer::update_color(unsigned short color, int position)
+{
+	undo_stack->beginMacro("Color");
+	update_byte(color & 0xFF, position);
+	update_byte(color >> 8, position + 1);
+	undo_stack->endMacro();
+}
+
 QString ROM_buffer::get_formatted_address(int address) const
 {
 	address = pc_to_snes(address);
@@ -315,20 +448,271 @@ int ROM_buffer::replace_all(QString find, QString replace, bool mode)
 	return results;
 }
 
-QVector<int> ROM_buffer::get_rats_tags() const
+//Built on first use, edits keep it current from then on
+const free_space_index &ROM_buffer::get_free_space()
+{
+	if(!free_space.is_built()){
+		free_space.build(this);
+	}
+	return free_space;
+}
+
+//Finds free space in the given banks and keeps it from being handed out again, -1 when nothing fits
+int ROM_buffer::allocate(int length, int first_bank, int last_bank)
 {
-	QVector<int> offsets;
+	int start = get_free_space().find(this, length, first_bank, last_bank);
+	if(start != -1){
+		free_space.claim(start, start + length);
+	}
+	return start;
+}
+
+//Every page is copied on its own, so the banks spread over the thread pool
+static QByteArray relayout(const QByteArray &source, const QVector<int> &layout)
+{
+	QByteArray result(layout.size() << 15, 0);
+	char *output = result.data();
+	QVector<int> pages(layout.size());
+	std::iota(pages.begin(), pages.end(), 0);
+	QtConcurrent::blockingMap(pages, [&](int &page){
+		int from = layout.at(page);
+		if(from >= 0 && from << 15 < source.size()){
+			memcpy(output + (page << 15), source.constData() + (from << 15), qMin(0x8000, source.size() - (from << 15)));
+		}
+	});
+	return result;
+}
+
+//Relays the ROM out for another mapper as a single undo step, the analysis moves along with its bytes.
+//SNES addresses passed in are relocated to wherever their byte ended up, -1 for ones that were not in the ROM.
+bool ROM_buffer::convert_mapper(memory_mapper target, const QVector<int> &addresses, relocation relocated)
+{
+	QVector<int> layout = conversion_layout(target);
+	if(layout.isEmpty()){
+		return false;
+	}
+	QVector<int> old_offsets = addresses;
+	translate_to_pc(old_offsets.data(), old_offsets.size());
+	int old_size = size();
 	
-	int position = 0;
-	do{
-		position = buffer.indexOf("STAR", position);
-		if((read_word(buffer, position+4) ^ read_word(buffer, position+6)) == 0xFFFF){
-			offsets.append(position);
+	QByteArray converted = relayout(buffer, layout);
+	unsigned char id = ROM_mapper::header_id(target) | (get_header_field(MAPPER) & 0x10);
+	ROM_mapper converted_mapper;
+	converted_mapper.set_type(target);
+	for(int header : {0x00FFC0, 0x80FFC0}){
+		int offset = converted_mapper.snes_to_pc(header + MAPPER);
+		if(offset >= 0 && offset < converted.size()){
+			converted[offset] = id;
 		}
-		position++;
-	}while(position > 0);
+	}
+	code_map map = analysis.is_valid() ? code_map(relayout(analysis.get_flags(), layout)) : analysis;
 	
-	return offsets;
+	//Addresses move with the undo step. The converted ones need the new mapper, so they are worked out on the first swap.
+	QVector<int> converted_addresses;
+	bool forward = true;
+	auto moved = [=]() mutable {
+		if(!relocated || addresses.isEmpty()){
+			return;
+		}
+		if(forward && converted_addresses.isEmpty()){
+			converted_addresses = relocate_addresses(addresses, old_offsets, layout, old_size);
+		}
+		forward ? relocated(addresses, converted_addresses) : relocated(converted_addresses, addresses);
+		forward = !forward;
+	};
+	swap_buffer(converted, "Convert mapper", map, moved);
+	return true;
+}
+
+//Addresses whose page was dropped, or that still reach the same byte, stay as they are
+QVector<int> ROM_buffer::relocate_addresses(const QVector<int> &addresses, const QVector<int> &old_offsets, 
+                                            const QVector<int> &layout, int old_size) const
+{
+	QVector<int> moved((old_size + 0x7FFF) >> 15, -1);
+	for(int page = layout.size() - 1; page >= 0; page--){
+		if(layout.at(page) >= 0 && layout.at(page) < moved.size()){
+			moved[layout.at(page)] = page;
+		}
+	}
+	QVector<int> relocated = addresses;
+	for(int i = 0; i < old_offsets.size(); i++){
+		int old_offset = old_offsets.at(i);
+		if(old_offset < 0 || old_offset >= old_size || moved.at(old_offset >> 15) < 0){
+			continue;
+		}
+		int offset = snes_to_pc(addresses.at(i));
+		if(offset < 0 || layout.value(offset >> 15, -1) != old_offset >> 15 || (offset ^ old_offset) & 0x7FFF){
+			relocated[i] = pc_to_snes(moved.at(old_offset >> 15) << 15 | (old_offset & 0x7FFF));
+		}
+	}
+	return relocated;
+}
+
+//Writes over existing bytes as one undo step, the size stays the same.
+//Returns false when the write merged into the previous step instead of adding one.
+bool ROM_buffer::overwrite(int offset, const QByteArray &data, QString action)
+{
+	int count = undo_stack->count();
+	QByteArray old_data = buffer.mid(offset, data.size());
+	buffer.replace(offset, data.size(), data);
+	undo_overwrite_command *command = new undo_overwrite_command(&buffer, offset, old_data, data);
+	command->setText(action);
+	undo_stack->push(command);
+	return undo_stack->count() != count;
+}
+
+//Takes new contents without an undo step, the history is dropped since it no longer applies
+void ROM_buffer::reload(const QByteArray &data)
+{
+	buffer = data;
+	undo_index = 0;
+	undo_stack->clear();
+	rats.build(this);
+	overlay.update(this, 0, size());
+	free_space.update(this, 0, size());
+}
+
+//Grows the ROM in place as one undo step, the header size and checksum follow the new size.
+//Sizes are kept to whole 32KB pages so mirrors line up with the banks.
+bool ROM_buffer::expand(int new_size, const QByteArray &pattern, bool mirror)
+{
+	int old_size = size();
+	if(new_size <= old_size || new_size > max_size() || new_size & 0x7FFF || (!mirror && pattern.isEmpty())){
+		return false;
+	}
+	QVector<int> locations = header_locations();
+	QVector<QPair<int, char>> header;
+	for(int location : locations){
+		for(int field : {(int)ROM_SIZE, (int)COMPLEMENT, COMPLEMENT + 1, (int)CHECKSUM, CHECKSUM + 1}){
+			header.append({location + field, buffer.at(location + field)});
+		}
+	}
+	
+	int size_id = 0;
+	while(0x400 << size_id < new_size){
+		size_id++;
+	}
+	auto grow = [this, old_size, new_size, pattern, mirror, locations, size_id](){
+		buffer.resize(new_size);
+		fill_expansion(old_size, pattern, mirror);
+		for(int location : locations){
+			buffer[location + ROM_SIZE] = size_id;
+		}
+		write_checksum();
+	};
+	auto changed = [this](){
+		analyze();
+		update_bookmarks();
+	};
+	grow();
+	changed();
+	undo_stack->beginMacro("Expand ROM");
+	undo_stack->push(new undo_expand_command(&buffer, old_size, header, grow, changed));
+	undo_stack->endMacro();
+	return true;
+}
+
+//Mirroring repeats the old image the way the cartridge bus does when the ROM is smaller than its mapping,
+//so a non power of two image mirrors its last part instead of starting over from the first bank.
+void ROM_buffer::fill_expansion(int old_size, const QByteArray &pattern, bool mirror)
+{
+	char *output = buffer.data();
+	int new_size = buffer.size();
+	if(!mirror){
+		int filled = qMin(pattern.size(), new_size - old_size);
+		memcpy(output + old_size, pattern.constData(), filled);
+		while(old_size + filled < new_size){
+			int length = qMin(filled - filled % pattern.size(), new_size - old_size - filled);
+			memcpy(output + old_size + filled, output + old_size, length);
+			filled += length;
+		}
+		return;
+	}
+	for(int offset = old_size; offset < new_size; offset += 0x8000){
+		int source = offset;
+		int base = 0;
+		int remaining = old_size;
+		for(int mask = 0x800000; source >= remaining; mask >>= 1){
+			if(source & mask){
+				source -= mask;
+				if(remaining > mask){
+					remaining -= mask;
+					base += mask;
+				}
+			}
+		}
+		memcpy(output + offset, output + base + source, qMin(0x8000, new_size - offset));
+	}
+}
+
+//Any checksum and its complement add up to the same bytes, so summing with a blank pair gives the final sum
+void ROM_buffer::write_checksum()
+{
+	QVector<int> locations = header_locations();
+	for(int location : locations){
+		buffer[location + COMPLEMENT] = 0xFF;
+		buffer[location + COMPLEMENT + 1] = 0xFF;
+		buffer[location + CHECKSUM] = 0x00;
+		buffer[location + CHECKSUM + 1] = 0x00;
+	}
+	unsigned short checksum = calculate_checksum();
+	for(int location : locations){
+		buffer[location + COMPLEMENT] = ~checksum & 0xFF;
+		buffer[location + COMPLEMENT + 1] = ~checksum >> 8;
+		buffer[location + CHECKSUM] = checksum & 0xFF;
+		buffer[location + CHECKSUM + 1] = checksum >> 8;
+	}
+}
+
+//Sums length bytes as if mirrored up to target, a power of two. Anything that isn't a power of two is its
+//largest power of two followed by the rest mirrored up to that size, the same split fill_expansion uses.
+static unsigned int mirrored_sum(const unsigned char *bytes, int length, int target)
+{
+	if(length <= 0){
+		return 0;
+	}
+	int base = 1;
+	while(base << 1 <= length){
+		base <<= 1;
+	}
+	unsigned int total = 0;
+	for(int i = 0; i < base; i++){
+		total += bytes[i];
+	}
+	if(base < length){
+		total += mirrored_sum(bytes + base, length - base, base);
+		base <<= 1;
+	}
+	return total * (target / base);
+}
+
+unsigned short ROM_buffer::calculate_checksum() const
+{
+	int target = 1;
+	while(target < size()){
+		target <<= 1;
+	}
+	return mirrored_sum((const unsigned char *)buffer.constData(), size(), target);
+}
+
+//Replaces the whole buffer as one undo step, the header is read again each way
+void ROM_buffer::swap_buffer(QByteArray &replacement, QString action, code_map map, std::function<void()> moved)
+{
+	buffer.swap(replacement);
+	auto swapped = [this, map, moved]() mutable {
+		analyze();
+		code_map current = analysis;
+		set_code_map(map);
+		update_bookmarks();
+		map = current;
+		if(moved){
+			moved();
+		}
+	};
+	swapped();
+	undo_stack->beginMacro(action);
+	undo_stack->push(new undo_swap_command(&buffer, replacement, swapped));
+	undo_stack->endMacro();
 }
 
 QByteArray ROM_buffer::input_to_byte_array(QString input, int mode)
@@ -7,9 +7,17 @@
 #include <QMimeData>
 #include <QUndoGroup>
 #include <QUndoStack>
+#include <functional>
 
 #include "rom_metadata.h"
 #include "panels/bookmark_panel.h"
+#include "analysis/code_map.h"
+#include "analysis/xref_index.h"
+#include "analysis/type_overlay.h"
+#include "analysis/free_space_index.h"
+#include "analysis/rats_index.h"
+#include "symbol_table.h"
+#include "bookmark_index.h"
 
 class ROM_buffer : public ROM_metadata
 {
@@ -32,6 +40,7 @@ class ROM_buffer : public ROM_metadata
 		
 		ROM_buffer(){}
 		ROM_buffer(QString file_name, bool new_file = false);
+		ROM_buffer(QString name, const QByteArray &data);
 		virtual ~ROM_buffer(){}
 		virtual void remove_copy_header();
 		void open(QString path);
@@ -44,12 +53,20 @@ class ROM_buffer : public ROM_metadata
 		void delete_text(int start, int end = 0);
 		void update_nibble(char byte, int position, int delete_start = 0, int delete_end = 0);
 		virtual void update_byte(char byte, int position, int delete_start = 0, int delete_end = 0);
+		void update_color(unsigned short color, int position);
 		QString get_formatted_address(int address) const;
 		int count(QString find, bool mode);
 		int search(QString find, int position, bool direction, bool mode);
 		int replace(QString find, QString replace, int position, bool direction, bool mode);
 		int replace_all(QString find, QString replace, bool mode);
-		QVector<int> get_rats_tags() const;
+		QVector<int> get_rats_tags() const { return rats.get_tags(); }
+		bool is_rats_tag(int offset) const { return rats.contains(offset); }
+		typedef std::function<void(const QVector<int> &from, const QVector<int> &to)> relocation;
+		bool convert_mapper(memory_mapper target, const QVector<int> &addresses = QVector<int>(), relocation relocated = nullptr);
+		bool expand(int new_size, const QByteArray &pattern, bool mirror);
+		bool overwrite(int offset, const QByteArray &data, QString action);
+		void reload(const QByteArray &data);
+		unsigned short calculate_checksum() const;
 		
 		virtual int size() const { return buffer.size(); }
 		virtual char at(int index) const { return index == size() ? 0 : buffer.at(index); }
@@ -60,10 +77,30 @@ class ROM_buffer : public ROM_metadata
 		QString get_hex(QString input) { return input.remove(QRegExp("[^0-9A-Fa-f]")); }
 		QString load_error() { return ROM_error; }
 		QString get_file_name(){ QFileInfo info(ROM); return info.fileName();  }
+		QString get_file_path() const { QFileInfo info(ROM); return info.absoluteFilePath(); }
+		const char *data() const { return buffer.constData(); }
+		//Shares the storage until the next edit, so other threads can read it while editing goes on
+		QByteArray snapshot() const { return buffer; }
 		QByteArray range(int start, int end) const { return buffer.mid(start/2, (end-start)/2); }
 		
 		const bookmark_map *get_bookmark_map() const { return bookmarks; }
-		void set_bookmark_map(const bookmark_map *b){ bookmarks = b; }
+		void set_bookmark_map(const bookmark_map *b){ bookmarks = b; update_bookmarks(); }
+		const bookmark_index &get_bookmarks() const { return bookmark_intervals; }
+		void update_bookmarks();
+		
+		const code_map &get_code_map() const { return analysis; }
+		void set_code_map(const code_map &map){ analysis = map; xrefs.build(this); overlay.build(this); }
+		const code_map &get_gsu_map() const { return gsu_analysis; }
+		void set_gsu_map(const code_map &map){ gsu_analysis = map; }
+		const xref_index &get_xrefs() const { return xrefs; }
+		bool update_xrefs(){ return xrefs.update(this); }
+		const type_overlay &get_overlay() const { return overlay; }
+		void update_overlay(){ overlay.build(this); }
+		const free_space_index &get_free_space();
+		int allocate(int length, int first_bank = 0x00, int last_bank = 0xFF);
+		
+		const symbol_table &get_symbols() const { return symbols; }
+		symbol_table &get_symbols(){ return symbols; }
 		
 		static void set_copy_style(copy_style style){ copy_type = style; }
 		
@@ -76,11 +113,26 @@ class ROM_buffer : public ROM_metadata
 		QUndoStack *undo_stack;
 		QString ROM_error = "";
 		const bookmark_map *bookmarks = nullptr;
+		bookmark_index bookmark_intervals;
+		code_map analysis;
+		code_map gsu_analysis;
+		xref_index xrefs;
+		type_overlay overlay;
+		free_space_index free_space;
+		rats_index rats;
+		int undo_index = 0;
+		symbol_table symbols;
 		
 		static copy_style copy_type;
 		static QClipboard *clipboard;
 		
 		QByteArray input_to_byte_array(QString input, int mode);
+		void swap_buffer(QByteArray &replacement, QString action, code_map map, std::function<void()> moved = nullptr);
+		QVector<int> relocate_addresses(const QVector<int> &addresses, const QVector<int> &old_offsets, 
+		                                const QVector<int> &layout, int old_size) const;
+		void fill_expansion(int old_size, const QByteArray &pattern, bool mirror);
+		void write_checksum();
+		void undo_index_changed(int index);
 };
 
 #endif // ROM_BUFFER_H
@@ -6,39 +6,201 @@ void ROM_mapper::set_type(memory_mapper mapper)
 {
 	type = mapper;
 	dispatcher = mappers[mapper];
+	table.build(dispatcher);
 }
 
-memory_mapper ROM_mapper::get_type()
+memory_mapper ROM_mapper::get_type() const
 {
 	return type;
 }
 
-int ROM_mapper::snes_to_pc(int address) const
+void ROM_mapper::translate_to_pc(int *addresses, int count) const
 {
-	return dispatcher.snes_to_pc(address);
+	for(int i = 0; i < count; i++){
+		addresses[i] = table.to_pc(addresses[i]);
+	}
 }
 
-int ROM_mapper::pc_to_snes(int address) const
+void ROM_mapper::translate_to_snes(int *addresses, int count) const
 {
-	return dispatcher.pc_to_snes(address);
+	for(int i = 0; i < count; i++){
+		addresses[i] = table.to_snes(addresses[i]);
+	}
 }
 
-bool ROM_mapper::can_convert(memory_mapper mapper)
+bool ROM_mapper::can_convert(memory_mapper mapper) const
 {
 	return dispatcher.can_convert(mapper);
 }
 
-void ROM_mapper::convert_to(memory_mapper mapper)
+//Returns the old page every page of the converted ROM comes from, -1 for empty pages.
+//SNES addresses both mappers map keep their contents, so code runs where it always did. Every old page
+//is placed once with the boot banks going first, anything no shared address reaches goes in the first
+//free page and only then are mirrors the new mapper keeps apart filled in.
+QVector<int> ROM_mapper::conversion_layout(memory_mapper mapper, int size) const
 {
-	dispatcher.convert_to(mapper); 
-	type = mapper; 
-	dispatcher = mappers[mapper];
+	if(!can_convert(mapper)){
+		return {};
+	}
+	bank_table converted;
+	converted.build(mappers[mapper]);
+	int source_pages = (size + 0x7FFF) >> 15;
+	int target_pages = qMin(mappers[mapper].max_size >> 15, (int)bank_table::page_count);
+	QVector<int> layout(target_pages, -1);
+	QVector<bool> placed(source_pages, false);
+	
+	auto place_shared = [&](bool mirrors){
+		static const int regions[] = {0x00, 0x80, 0x40, 0xC0};
+		for(int region : regions){
+			for(int address = region << 16; address < (region + 0x40) << 16; address += 0x8000){
+				int half = address ^ 0x8000; //upper halves first
+				int from = table.to_pc(half) >> 15;
+				int to = converted.to_pc(half) >> 15;
+				if(from < 0 || to < 0 || from >= source_pages || to >= target_pages || 
+				   layout.at(to) != -1 || (placed.at(from) && !mirrors)){
+					continue;
+				}
+				layout[to] = from;
+				placed[from] = true;
+			}
+		}
+	};
+	
+	place_shared(false);
+	int free = 0;
+	for(int page = 0; page < source_pages; page++){
+		if(placed.at(page)){
+			continue;
+		}
+		while(free < target_pages && (layout.at(free) != -1 || converted.to_snes(free << 15) < 0)){
+			free++;
+		}
+		if(free == target_pages){
+			return {};
+		}
+		layout[free] = page;
+	}
+	place_shared(true);
+	
+	while(layout.last() == -1){
+		layout.removeLast();
+	}
+	return layout;
+}
+
+//The mapper byte of the header, FastROM sets 0x10 on top of it
+unsigned char ROM_mapper::header_id(memory_mapper mapper)
+{
+	static const unsigned char ids[] = {0x20, 0x21, 0x22, 0x25, 0x20, 0x23, 0x3A, 0x32};
+	return ids[mapper];
+}
+
+bank_table::bank_table()
+{
+	for(auto &entry : banks){
+		entry = {-1, 0, 0};
+	}
+	for(auto &page : pages){
+		page = -1;
+	}
+}
+
+//Every mapper translates linearly within each half of a bank and each 32KB page of ROM,
+//so probing the mapper once per half bank and once per page captures it whole
+void bank_table::build(const mapper_dispatch &dispatch)
+{
+	for(int bank = 0; bank < 0x100; bank++){
+		int low = dispatch.snes_to_pc(bank << 16);
+		int high = dispatch.snes_to_pc(bank << 16 | 0x8000);
+		if(high < 0){
+			banks[bank] = {-1, 0, 0};
+		}else if(low == high){
+			banks[bank] = {high, 0x0000, 0x7FFF};
+		}else if(low >= 0 && low + 0x8000 == high){
+			banks[bank] = {low, 0x0000, 0xFFFF};
+		}else{
+			banks[bank] = {high, 0x8000, 0x7FFF};
+		}
+	}
+	for(int page = 0; page < page_count; page++){
+		pages[page] = dispatch.pc_to_snes(page << 15);
+	}
+}
+
+//Pages keep the first bank mapped to them, so mirrors should be mapped after the banks pc_to_snes prefers
+void bank_table::map_lorom(int first, int last, int pc)
+{
+	for(int bank = first; bank <= last; bank++, pc += 0x8000){
+		banks[bank] = {pc, 0x8000, 0x7FFF};
+		if(pc >> 15 < page_count && pages[pc >> 15] < 0){
+			pages[pc >> 15] = bank << 16 | 0x8000;
+		}
+	}
+}
+
+void bank_table::map_hirom(int first, int last, int pc, bool upper_half)
+{
+	for(int bank = first; bank <= last; bank++, pc += 0x10000){
+		int start = upper_half ? 0x8000 : 0x0000;
+		banks[bank] = {pc + start, (unsigned short)start, (unsigned short)(upper_half ? 0x7FFF : 0xFFFF)};
+		for(int offset = start; offset < 0x10000; offset += 0x8000){
+			int page = (pc + offset) >> 15;
+			if(page < page_count && pages[page] < 0){
+				pages[page] = bank << 16 | offset;
+			}
+		}
+	}
+}
+
+//$80-$FF hold the first 4MB, $00-$7D the rest
+static bank_table exlorom_banks()
+{
+	bank_table table;
+	table.map_lorom(0x80, 0xFF, 0x000000);
+	table.map_lorom(0x00, 0x7D, 0x400000);
+	return table;
+}
+
+//$C0-$FF hold the first 4MB, $40-$7D the rest and $00-$3F,$80-$BF mirror their upper halves
+static bank_table exhirom_banks()
+{
+	bank_table table;
+	table.map_hirom(0xC0, 0xFF, 0x000000);
+	table.map_hirom(0x40, 0x7D, 0x400000);
+	table.map_hirom(0x00, 0x3F, 0x400000, true);
+	table.map_hirom(0x80, 0xBF, 0x000000, true);
+	return table;
+}
+
+//1MB of program ROM at $C0-$CF, data ROM through $D0-$FF with $4831-$4833 at their 0, 1, 2 defaults
+static bank_table spc7110_banks()
+{
+	bank_table table;
+	table.map_hirom(0xC0, 0xCF, 0x000000);
+	table.map_hirom(0xD0, 0xFF, 0x100000);
+	table.map_hirom(0x00, 0x0F, 0x000000, true);
+	table.map_hirom(0x80, 0x8F, 0x000000, true);
+	return table;
+}
+
+//LoROM over the first 2MB, $C0-$FF through $4804-$4807 at their 0, 1, 2, 3 defaults
+static bank_table sdd1_banks()
+{
+	bank_table table;
+	table.map_lorom(0x00, 0x3F, 0x000000);
+	table.map_lorom(0x80, 0xBF, 0x000000);
+	table.map_hirom(0xC0, 0xFF, 0x000000);
+	return table;
 }
 
+static const bank_table exlorom_table = exlorom_banks();
+static const bank_table exhirom_table = exhirom_banks();
+static const bank_table spc7110_table = spc7110_banks();
+static const bank_table sdd1_table = sdd1_banks();
+
 #define snes_to_pc []
 #define pc_to_snes []
 #define can_convert []
-#define convert_to []
 #define max_size(MB) MB * 1024 * 1024
 
 const mapper_dispatch lorom_dispatch {
@@ -58,12 +220,7 @@ const mapper_dispatch lorom_dispatch {
 		},
 	
 		can_convert(memory_mapper mapper){
-			Q_UNUSED(mapper);
-			return false;
-		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
+			return mapper == HIROM || mapper == EXLOROM;
 		},
 		
 		max_size(4)
@@ -85,12 +242,7 @@ const mapper_dispatch hirom_dispatch {
 		},
 	
 		can_convert(memory_mapper mapper){
-			Q_UNUSED(mapper);
-			return false;
-		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
+			return mapper == LOROM || mapper == EXLOROM;
 		},
 		
 		max_size(4)
@@ -98,22 +250,15 @@ const mapper_dispatch hirom_dispatch {
 
 const mapper_dispatch exlorom_dispatch {
 		snes_to_pc(int address){
-			Q_UNUSED(address);
-			return -1;
+			return exlorom_table.to_pc(address);
 		},
 	
 		pc_to_snes(int address){
-			Q_UNUSED(address);
-			return -1;
+			return exlorom_table.to_snes(address);
 		},
 	
 		can_convert(memory_mapper mapper){
-			Q_UNUSED(mapper);
-			return false;
-		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
+			return mapper == LOROM || mapper == HIROM;
 		},
 		
 		max_size(8)
@@ -121,23 +266,17 @@ const mapper_dispatch exlorom_dispatch {
 	
 const mapper_dispatch exhirom_dispatch {
 		snes_to_pc(int address){
-			Q_UNUSED(address);
-			return -1;
+			return exhirom_table.to_pc(address);
 		},
 	
 		pc_to_snes(int address){
-			Q_UNUSED(address);
-			return -1;
+			return exhirom_table.to_snes(address);
 		},
 	
 		can_convert(memory_mapper mapper){
 			Q_UNUSED(mapper);
 			return false;
 		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
-		},
 		
 		max_size(8)
 	};
@@ -165,10 +304,6 @@ const mapper_dispatch superfxrom_dispatch {
 			Q_UNUSED(mapper);
 			return false;
 		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
-		},
 		
 		max_size(2)
 	};
@@ -208,56 +343,40 @@ const mapper_dispatch sa1rom_dispatch {
 			Q_UNUSED(mapper);
 			return false;
 		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
-		},
 		
 		max_size(8)
 	};
 
 const mapper_dispatch spc7110rom_dispatch {
 		snes_to_pc(int address){
-			Q_UNUSED(address);
-			return -1;
+			return spc7110_table.to_pc(address);
 		},
 	
 		pc_to_snes(int address){
-			Q_UNUSED(address);
-			return -1;
+			return spc7110_table.to_snes(address);
 		},
 	
 		can_convert(memory_mapper mapper){
 			Q_UNUSED(mapper);
 			return false;
 		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
-		},
 		
 		max_size(8)
 	};
 
 const mapper_dispatch sdd1rom_dispatch {
 		snes_to_pc(int address){
-			Q_UNUSED(address);
-			return -1;
+			return sdd1_table.to_pc(address);
 		},
 	
 		pc_to_snes(int address){
-			Q_UNUSED(address);
-			return -1;
+			return sdd1_table.to_snes(address);
 		},
 	
 		can_convert(memory_mapper mapper){
 			Q_UNUSED(mapper);
 			return false;
 		},
-	
-		convert_to(memory_mapper mapper){
-			Q_UNUSED(mapper);
-		},
 		
 		max_size(8)
 	};
@@ -265,7 +384,6 @@ const mapper_dispatch sdd1rom_dispatch {
 #undef snes_to_pc
 #undef pc_to_snes
 #undef can_convert
-#undef convert_to
 
 const mapper_dispatch mappers[] = {
         lorom_dispatch,
@@ -1,6 +1,7 @@
 #ifndef MAPPER_H
 #define MAPPER_H
 
+#include <QVector>
 
 enum memory_mapper{
 	LOROM,
@@ -17,26 +18,66 @@ struct mapper_dispatch{
 	int (*snes_to_pc)(int);
 	int (*pc_to_snes)(int);
 	bool (*can_convert)(memory_mapper mapper);
-	void (*convert_to)(memory_mapper mapper);
 	int max_size;
 };
 
 extern const mapper_dispatch mappers[];
 
+//A bank either holds ROM in full or only in its upper half, offsets inside a bank are never remapped
+struct bank_table{
+	struct bank{
+		int pc_base;
+		unsigned short low;
+		unsigned short mask;
+	};
+	
+	static const int page_count = 0x100; //32KB pages, enough for 8MB
+	
+	bank banks[0x100];
+	int pages[page_count];
+	
+	bank_table();
+	void build(const mapper_dispatch &dispatch);
+	void map_lorom(int first, int last, int pc);
+	void map_hirom(int first, int last, int pc, bool upper_half = false);
+	
+	int to_pc(int address) const
+	{
+		const bank &entry = banks[(address >> 16) & 0xFF];
+		int offset = address & 0xFFFF;
+		if((unsigned int)address > 0xFFFFFF || entry.pc_base < 0 || offset < entry.low){
+			return -1;
+		}
+		return entry.pc_base + (offset & entry.mask);
+	}
+	
+	int to_snes(int address) const
+	{
+		if((unsigned int)address >= page_count << 15 || pages[address >> 15] < 0){
+			return -1;
+		}
+		return pages[address >> 15] | (address & 0x7FFF);
+	}
+};
+
 class ROM_mapper{
 	public:
 		void set_type(memory_mapper mapper);
-		memory_mapper get_type();
+		memory_mapper get_type() const;
 		
-		int snes_to_pc(int address) const;
-		int pc_to_snes(int address) const;
+		int snes_to_pc(int address) const { return table.to_pc(address); }
+		int pc_to_snes(int address) const { return table.to_snes(address); }
+		void translate_to_pc(int *addresses, int count) const;
+		void translate_to_snes(int *addresses, int count) const;
 		
-		bool can_convert(memory_mapper mapper);
-		void convert_to(memory_mapper mapper);
+		bool can_convert(memory_mapper mapper) const;
+		QVector<int> conversion_layout(memory_mapper mapper, int size) const;
+		static unsigned char header_id(memory_mapper mapper);
 		
 	private:
 		memory_mapper type;
 		mapper_dispatch dispatcher;
+		bank_table table;
 };
 
 
@@ -40,7 +40,7 @@ ROM_metadata::region ROM_metadata::get_cart_region()
 	return (get_header_field(CART_REGION) < 2 || get_header_field(CART_REGION) >= 13) ? NTSC : PAL;
 }
 
-memory_mapper ROM_metadata::get_mapper()
+memory_mapper ROM_metadata::get_mapper() const
 {
 	return mapper.get_type();
 }
@@ -59,7 +59,7 @@ ROM_metadata::DSP1_memory_mapper ROM_metadata::get_dsp1_mapper()
 	return DSP1UNMAPPED;
 }
 
-unsigned short ROM_metadata::get_header_field(header_field field, bool word)
+unsigned short ROM_metadata::get_header_field(header_field field, bool word) const
 {
 	unsigned short entry = at(header_index + field) & 0x00FF;
 	if(word){
@@ -68,16 +68,27 @@ unsigned short ROM_metadata::get_header_field(header_field field, bool word)
 	return entry;
 }
 
-unsigned short ROM_metadata::get_header_field(checksums field)
+unsigned short ROM_metadata::get_header_field(checksums field) const
 {
 	return get_header_field((header_field)field, true);
 }
 
-unsigned short ROM_metadata::get_vector(vectors vector)
+unsigned short ROM_metadata::get_vector(vectors vector) const
 {
 	return get_header_field((header_field)(0x20 + vector), true);
 }
 
+//Ex mappers may repeat the header in the other half, that copy only counts if it names the same mapper
+QVector<int> ROM_metadata::header_locations() const
+{
+	QVector<int> locations = {(int)header_index};
+	int copy = get_mapper() == EXLOROM ? 0x407FC0 : get_mapper() == EXHIROM ? 0x00FFC0 : -1;
+	if(copy >= 0 && copy != (int)header_index && copy + 0x40 <= size() && at(copy + MAPPER) == at(header_index + MAPPER)){
+		locations.append(copy);
+	}
+	return locations;
+}
+
 QString ROM_metadata::get_cart_name()
 {
 	QString name;
@@ -121,16 +132,6 @@ QByteArray ROM_metadata::to_little_endian(QByteArray bytes) const
 	return bytes;
 }
 
-int ROM_metadata::snes_to_pc(int address) const
-{
-	return mapper.snes_to_pc(address);
-}
-
-int ROM_metadata::pc_to_snes(int address) const
-{
-	return mapper.pc_to_snes(address);
-}
-
 bool ROM_metadata::validate_address(int address, bool error_method)
 {
 	address_error = "";
@@ -88,19 +88,25 @@ class ROM_metadata {
 		int header_size();
 		bool has_chip(cart_chips chip);
 		region get_cart_region();
-		memory_mapper get_mapper();
+		memory_mapper get_mapper() const;
+		int max_size() const { return mappers[get_mapper()].max_size; }
+		bool can_convert(memory_mapper target) const { return mapper.can_convert(target); }
+		QVector<int> conversion_layout(memory_mapper target) const { return mapper.conversion_layout(target, size()); }
 		DSP1_memory_mapper get_dsp1_mapper();
-		unsigned short get_header_field(header_field field, bool word = false);
-		unsigned short get_header_field(checksums field);
-		unsigned short get_vector(vectors vector);
+		unsigned short get_header_field(header_field field, bool word = false) const;
+		unsigned short get_header_field(checksums field) const;
+		unsigned short get_vector(vectors vector) const;
+		QVector<int> header_locations() const;
 		QString get_cart_name();
 		void update_header_field(header_field field, unsigned short data, bool word = false);
 		void update_header_field(checksums field, unsigned short data);
 		void update_vector(vectors vector, unsigned short data);
 		void update_cart_name(QString name);
 		QByteArray to_little_endian(QByteArray bytes) const;
-		int snes_to_pc(int address) const;
-		int pc_to_snes(int address) const;
+		int snes_to_pc(int address) const { return mapper.snes_to_pc(address); }
+		int pc_to_snes(int address) const { return mapper.pc_to_snes(address); }
+		void translate_to_pc(int *addresses, int count) const { mapper.translate_to_pc(addresses, count); }
+		void translate_to_snes(int *addresses, int count) const { mapper.translate_to_snes(addresses, count); }
 		bool validate_address(int address, bool error_method = true);
 		int branch_address(int address, QByteArray branch) const;
 		int jump_address(int address, QByteArray jump) const;
@@ -111,6 +117,9 @@ class ROM_metadata {
 		virtual void update_byte(char byte, int position, int delete_start = 0, int delete_end = 0) = 0;
 		
 		QString get_address_error(){ return address_error; }
+	protected:
+		void set_mapper(memory_mapper type){ mapper.set_type(type); }
+		
 	private:
 		void read_header();
 		unsigned int find_header();
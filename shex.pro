@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets
+QT       += core gui widgets concurrent
 
 TARGET = shex
 TEMPLATE = app
@@ -25,6 +25,9 @@ SOURCES += main.cpp\
     dialogs/metadata_editor_dialog.cpp \
     dialog_manager.cpp \
     dialogs/expand_rom_dialog.cpp \
+    dialogs/convert_mapper_dialog.cpp \
+    dialogs/decompress_dialog.cpp \
+    dialogs/free_space_dialog.cpp \
     dialogs/abstract_dialog.cpp \
     menu_manager.cpp \
     menus/abstract_menu_item.cpp \
@@ -43,14 +46,40 @@ SOURCES += main.cpp\
     panels/abstract_panel.cpp \
     panel_manager.cpp \
     panels/bookmark_panel.cpp \
+    panels/bookmark_model.cpp \
+    panels/bookmark_library.cpp \
     panels/disassembler_panel.cpp \
+    panels/disassembly_model.cpp \
+    panels/xref_panel.cpp \
     object_group.cpp \
     settings_manager.cpp \
     dialogs/settings_dialog.cpp \
     editor_font.cpp \
     disassembly_cores/isa_gsu.cpp \
     dialogs/how_to_use_dialog.cpp \
-    rom_mapper.cpp
+    rom_mapper.cpp \
+    analysis/code_analyzer.cpp \
+    analysis/analysis_cache.cpp \
+    analysis/xref_index.cpp \
+    analysis/source_exporter.cpp \
+    analysis/spc_upload_scanner.cpp \
+    analysis/gsu_analyzer.cpp \
+    analysis/cpu_tracer.cpp \
+    analysis/trace_importer.cpp \
+    analysis/type_overlay.cpp \
+    analysis/free_space_index.cpp \
+    analysis/rats_index.cpp \
+    compression/codec.cpp \
+    compression/lz_codec.cpp \
+    compression/rle_codec.cpp \
+    compression/block_scanner.cpp \
+    graphics/tile_format.cpp \
+    graphics/tile_atlas.cpp \
+    graphics/bgr555.cpp \
+    panels/tile_panel.cpp \
+    panels/palette_panel.cpp \
+    symbol_table.cpp \
+    bookmark_index.cpp
 
 HEADERS  += main_window.h \
     hex_editor.h \
@@ -65,6 +94,9 @@ HEADERS  += main_window.h \
     dialogs/metadata_editor_dialog.h \
     dialog_manager.h \
     dialogs/expand_rom_dialog.h \
+    dialogs/convert_mapper_dialog.h \
+    dialogs/decompress_dialog.h \
+    dialogs/free_space_dialog.h \
     dialogs/abstract_dialog.h \
     menu_manager.h \
     menus/abstract_menu_item.h \
@@ -86,7 +118,11 @@ HEADERS  += main_window.h \
     panels/abstract_panel.h \
     panel_manager.h \
     panels/disassembler_panel.h \
+    panels/disassembly_model.h \
+    panels/xref_panel.h \
     panels/bookmark_panel.h \
+    panels/bookmark_model.h \
+    panels/bookmark_library.h \
     object_group.h \
     settings_manager.h \
     events/settings_event.h \
@@ -94,7 +130,31 @@ HEADERS  += main_window.h \
     editor_font.h \
     disassembly_cores/isa_gsu.h \
     dialogs/how_to_use_dialog.h \
-    rom_mapper.h
+    rom_mapper.h \
+    analysis/code_map.h \
+    analysis/work_queue.h \
+    analysis/code_analyzer.h \
+    analysis/analysis_cache.h \
+    analysis/xref_index.h \
+    analysis/source_exporter.h \
+    analysis/spc_upload_scanner.h \
+    analysis/gsu_analyzer.h \
+    analysis/cpu_tracer.h \
+    analysis/trace_importer.h \
+    analysis/type_overlay.h \
+    analysis/free_space_index.h \
+    analysis/rats_index.h \
+    compression/codec.h \
+    compression/lz_codec.h \
+    compression/rle_codec.h \
+    compression/block_scanner.h \
+    graphics/tile_format.h \
+    graphics/tile_atlas.h \
+    graphics/bgr555.h \
+    panels/tile_panel.h \
+    panels/palette_panel.h \
+    symbol_table.h \
+    bookmark_index.h
 
 OTHER_FILES += \
     version.sh
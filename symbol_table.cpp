@@ -0,0 +1,229 @@
+#include <QFile>
+#include <algorithm>
+
+#include "symbol_table.h"
+#include "debug.h"
+
+const char *symbol_table::find(int address) const
+{
+	int index = find_slot(address);
+	return index == -1 ? nullptr : names.constData() + table[index].name;
+}
+
+void symbol_table::insert(int address, const char *name, int length)
+{
+	reserve(count + 1);
+	int offset = names.size();
+	names.append(name, length);
+	names.append('\0');
+	if(insert_slot(address, offset)){
+		sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), address) - sorted.begin(), address);
+	}
+}
+
+void symbol_table::insert(int address, const QString &name)
+{
+	QByteArray text = name.toLatin1();
+	insert(address, text.constData(), text.size());
+}
+
+//Entries after the removed one are shifted back so probing never needs tombstones
+bool symbol_table::remove(int address)
+{
+	int index = find_slot(address);
+	if(index == -1){
+		return false;
+	}
+	table[index].address = empty;
+	for(int next = (index + 1) & mask; table[next].address != empty; next = (next + 1) & mask){
+		int home = probe(table[next].address);
+		bool in_place = index <= next ? index < home && home <= next : index < home || home <= next;
+		if(!in_place){
+			table[index] = table[next];
+			table[next].address = empty;
+			index = next;
+		}
+	}
+	sorted.remove(std::lower_bound(sorted.begin(), sorted.end(), address) - sorted.begin());
+	count--;
+	return true;
+}
+
+void symbol_table::clear()
+{
+	table.clear();
+	sorted.clear();
+	names.clear();
+	count = 0;
+	mask = 0;
+	shift = 32;
+}
+
+//Returns the addresses with a symbol from start up to, but not including, end
+QVector<int> symbol_table::range(int start, int end) const
+{
+	auto first = std::lower_bound(sorted.begin(), sorted.end(), start);
+	auto last = std::lower_bound(first, sorted.end(), end);
+	return sorted.mid(first - sorted.begin(), last - first);
+}
+
+//Reads asar/WLA-DX style "bb:aaaa name" lines and bsnes/no$sns style "bbaaaa name" lines
+int symbol_table::import_file(const QString &path)
+{
+	QFile file(path);
+	if(!file.open(QIODevice::ReadOnly)){
+		return -1;
+	}
+	QByteArray contents;
+	qint64 size = file.size();
+	const char *position = (const char *)file.map(0, size);
+	if(!position){
+		contents = file.readAll();
+		position = contents.constData();
+		size = contents.size(); //readAll stops short on files too big for a QByteArray
+	}
+	const char *end = position + size;
+	
+	//A guess of one symbol every 16 bytes keeps rehashing out of the way
+	reserve(count + size / 16);
+	names.reserve(names.size() + size / 2);
+	int imported = 0;
+	int previous = sorted.size();
+	bool in_labels = true;
+	
+	auto hex_digit = [](char c) -> int {
+		return c >= '0' && c <= '9' ? c - '0' :
+		       c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+		       c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+	};
+	
+	while(position < end){
+		while(position < end && (*position == ' ' || *position == '\t')){
+			position++;
+		}
+		const char *line_end = (const char *)memchr(position, '\n', end - position);
+		line_end = line_end ? line_end : end;
+		
+		if(position < line_end && *position == '['){
+			in_labels = QByteArray(position, line_end - position).trimmed() == "[labels]";
+			position = line_end + 1;
+			continue;
+		}
+		
+		int address = 0;
+		int digits = 0;
+		for(int value; position < line_end && (value = hex_digit(*position)) != -1; position++, digits++){
+			address = address << 4 | value;
+		}
+		if(digits && position < line_end && *position == ':'){
+			position++;
+			for(int value; position < line_end && (value = hex_digit(*position)) != -1; position++){
+				address = address << 4 | value;
+			}
+		}
+		if(!in_labels || !digits || position == line_end || (*position != ' ' && *position != '\t')){
+			position = line_end + 1;
+			continue;
+		}
+		
+		while(position < line_end && (*position == ' ' || *position == '\t')){
+			position++;
+		}
+		const char *name = position;
+		while(position < line_end && *position != ' ' && *position != '\t' && 
+		      *position != '\r' && *position != ';'){
+			position++;
+		}
+		if(position != name){
+			reserve(count + 1);
+			int offset = names.size();
+			names.append(name, position - name);
+			names.append('\0');
+			if(insert_slot(address & 0xFFFFFF, offset)){
+				sorted.append(address & 0xFFFFFF);
+			}
+			imported++;
+		}
+		position = line_end + 1;
+	}
+	
+	//New addresses were appended as they came, sort them once and merge with what was there
+	std::sort(sorted.begin() + previous, sorted.end());
+	std::inplace_merge(sorted.begin(), sorted.begin() + previous, sorted.end());
+	return imported;
+}
+
+bool symbol_table::export_file(const QString &path) const
+{
+	static const char hex_digits[] = "0123456789abcdef";
+	QFile file(path);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+		return false;
+	}
+	QByteArray output("[labels]\n");
+	output.reserve(sorted.size() * 24);
+	for(int address : sorted){
+		if(address & SPC700){
+			continue;
+		}
+		char text[8] = {hex_digits[address >> 20 & 0xF], hex_digits[address >> 16 & 0xF], ':',
+		                hex_digits[address >> 12 & 0xF], hex_digits[address >> 8 & 0xF],
+		                hex_digits[address >> 4 & 0xF], hex_digits[address & 0xF], ' '};
+		output.append(text, sizeof(text));
+		output.append(find(address));
+		output.append('\n');
+	}
+	return file.write(output) == output.size();
+}
+
+int symbol_table::find_slot(int address) const
+{
+	if(!count){
+		return -1;
+	}
+	for(int index = probe(address); table[index].address != empty; index = (index + 1) & mask){
+		if(table[index].address == address){
+			return index;
+		}
+	}
+	return -1;
+}
+
+//Keeps the table at most half full
+void symbol_table::reserve(int total)
+{
+	if(total * 2 <= table.size()){
+		return;
+	}
+	int capacity = 64;
+	int bits = 6;
+	while(capacity < total * 2){
+		capacity <<= 1;
+		bits++;
+	}
+	QVector<slot> previous = table;
+	table.fill({empty, 0}, capacity);
+	mask = capacity - 1;
+	shift = 32 - bits;
+	count = 0;
+	for(const auto &entry : previous){
+		if(entry.address != empty){
+			insert_slot(entry.address, entry.name);
+		}
+	}
+}
+
+//Returns false if the address already had a name, which is replaced
+bool symbol_table::insert_slot(int address, int name)
+{
+	int index = probe(address);
+	for(; table[index].address != empty; index = (index + 1) & mask){
+		if(table[index].address == address){
+			table[index].name = name;
+			return false;
+		}
+	}
+	table[index] = {address, name};
+	count++;
+	return true;
+}
@@ -0,0 +1,51 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+//Names for SNES addresses, hashed for lookups and kept sorted for walking a range
+class symbol_table
+{
+	public:
+		//SPC700 addresses live in their own space above the 24 bit SNES addresses
+		static const int SPC700 = 0x1000000;
+		
+		const char *find(int address) const;
+		QString name(int address) const { return QString::fromLatin1(find(address)); }
+		void insert(int address, const char *name, int length);
+		void insert(int address, const QString &name);
+		bool remove(int address);
+		void clear();
+		
+		QVector<int> range(int start, int end) const;
+		int size() const { return count; }
+		bool is_empty() const { return !count; }
+		
+		int import_file(const QString &path);
+		bool export_file(const QString &path) const;
+		
+	private:
+		struct slot{
+			int address;
+			int name;
+		};
+		
+		static const int empty = -1;
+		
+		//Open addressing with linear probing, the capacity is always a power of two
+		QVector<slot> table;
+		QVector<int> sorted;
+		QByteArray names;
+		int count = 0;
+		int mask = 0;
+		int shift = 32;
+		
+		int probe(int address) const { return (unsigned int)address * 0x9E3779B1u >> shift & mask; }
+		int find_slot(int address) const;
+		void reserve(int total);
+		bool insert_slot(int address, int name);
+};
+
+#endif // SYMBOL_TABLE_H
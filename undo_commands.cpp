@@ -73,3 +73,89 @@ void undo_delete_command::redo()
 	}
 	buffer->remove(location, data->length());
 }
+
+undo_swap_command::undo_swap_command(QByteArray *b, const QByteArray &d, std::function<void()> s)
+{
+	buffer = b;
+	data = d;
+	swapped = s;
+}
+
+void undo_swap_command::undo()
+{
+	buffer->swap(data);
+	swapped();
+}
+
+void undo_swap_command::redo()
+{
+	if(!run_redo){
+		run_redo = true;
+		return;
+	}
+	buffer->swap(data);
+	swapped();
+}
+
+undo_expand_command::undo_expand_command(QByteArray *b, int s, const QVector<QPair<int, char>> &h, std::function<void()> g, std::function<void()> c)
+{
+	buffer = b;
+	old_size = s;
+	header = h;
+	grow = g;
+	changed = c;
+}
+
+//Shrinking keeps the allocation, so growing again on redo does not move the image
+void undo_expand_command::undo()
+{
+	buffer->resize(old_size);
+	for(const auto &byte : header){
+		(*buffer)[byte.first] = byte.second;
+	}
+	changed();
+}
+
+void undo_expand_command::redo()
+{
+	if(!run_redo){
+		run_redo = true;
+		return;
+	}
+	grow();
+	changed();
+}
+
+undo_overwrite_command::undo_overwrite_command(QByteArray *b, int l, const QByteArray &o, const QByteArray &n)
+{
+	buffer = b;
+	location = l;
+	old_data = o;
+	new_data = n;
+}
+
+void undo_overwrite_command::undo()
+{
+	buffer->replace(location, old_data.size(), old_data);
+}
+
+void undo_overwrite_command::redo()
+{
+	if(!run_redo){
+		run_redo = true;
+		return;
+	}
+	buffer->replace(location, new_data.size(), new_data);
+}
+
+//Writes can differ in length, so both sides grow to cover whatever either of them touched
+bool undo_overwrite_command::mergeWith(const QUndoCommand *other)
+{
+	const undo_overwrite_command *next = static_cast<const undo_overwrite_command *>(other);
+	if(next->location != location || next->text() != text()){
+		return false;
+	}
+	old_data += next->old_data.mid(old_data.size());
+	new_data = next->new_data + new_data.mid(next->new_data.size());
+	return true;
+}
@@ -2,6 +2,9 @@
 #define UNDO_COMMANDS_H
 
 #include <QUndoCommand>
+#include <QVector>
+#include <QPair>
+#include <functional>
 
 class undo_nibble_command : public QUndoCommand
 {
@@ -9,6 +12,7 @@ class undo_nibble_command : public QUndoCommand
 		undo_nibble_command(QByteArray *b, int l, unsigned char d[2], bool r);
 		void undo();
 		void redo();
+		int get_location() const { return location; }
 		
 	private:
 		QByteArray *buffer;
@@ -54,4 +58,57 @@ class undo_delete_command : public undo_action_command
 		int end;
 };
 
+//Holds the whole other buffer, implicit sharing makes swapping them back and forth free
+class undo_swap_command : public QUndoCommand
+{
+	public:
+		undo_swap_command(QByteArray *b, const QByteArray &d, std::function<void()> s);
+		void undo();
+		void redo();
+		
+	private:
+		QByteArray *buffer;
+		QByteArray data;
+		std::function<void()> swapped;
+		bool run_redo = false;
+};
+
+//Only remembers how the new space was filled, undo truncates the buffer and puts the old header bytes back
+class undo_expand_command : public QUndoCommand
+{
+	public:
+		undo_expand_command(QByteArray *b, int s, const QVector<QPair<int, char>> &h, std::function<void()> g, std::function<void()> c);
+		void undo();
+		void redo();
+		
+	private:
+		QByteArray *buffer;
+		int old_size;
+		QVector<QPair<int, char>> header;
+		std::function<void()> grow;
+		std::function<void()> changed;
+		bool run_redo = false;
+};
+
+//Writes over bytes in place. Repeated writes at the same offset merge, so a block recompressed on every
+//keystroke stays a single step in the ROM it came from.
+class undo_overwrite_command : public QUndoCommand
+{
+	public:
+		undo_overwrite_command(QByteArray *b, int l, const QByteArray &o, const QByteArray &n);
+		void undo();
+		void redo();
+		int id() const { return 1; }
+		bool mergeWith(const QUndoCommand *other);
+		int get_location() const { return location; }
+		int get_length() const { return new_data.size(); }
+		
+	private:
+		QByteArray *buffer;
+		int location;
+		QByteArray old_data;
+		QByteArray new_data;
+		bool run_redo = false;
+};
+
 #endif // UNDO_COMMANDS_H